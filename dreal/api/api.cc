@@ -35,6 +35,17 @@ bool CheckSatisfiability(const Formula& f, const double delta, Box* const box) {
   }
 }
 
+SatCheckResult CheckSatisfiability(const Formula& f, const Config& config,
+                                   Box* const box) {
+  DREAL_ASSERT(box);
+  Context context{config};
+  for (const Variable& v : f.GetFreeVariables()) {
+    context.DeclareVariable(v);
+  }
+  context.Assert(f);
+  return context.CheckSat(box);
+}
+
 optional<Box> Minimize(const Expression& objective, const Formula& constraint,
                        double delta) {
   // We encode the following optimization problem:
@@ -2,6 +2,8 @@
 
 #include <experimental/optional>
 
+#include "dreal/solver/config.h"
+#include "dreal/solver/context.h"
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
 
@@ -26,6 +28,18 @@ std::experimental::optional<Box> CheckSatisfiability(const Formula& f,
 /// std::experimental::optional.
 bool CheckSatisfiability(const Formula& f, double delta, Box* box);
 
+/// Checks the satisfiability of a given formula @p f with a given
+/// configuration @p config.
+///
+/// @returns SatCheckResult::DELTA_SAT if it finds a model which will be saved
+/// in @p box.
+/// @returns SatCheckResult::UNSAT if it concludes unsat.
+/// @returns SatCheckResult::UNKNOWN if it is cancelled or exceeds one of the
+/// resource limits (timeout, max_branchings, max_prunings, and max_sat_calls)
+/// in @p config.
+SatCheckResult CheckSatisfiability(const Formula& f, const Config& config,
+                                   Box* box);
+
 /// Finds a solution to minimize @p objective function while satisfying a
 /// given @p constraint using @p delta.
 ///
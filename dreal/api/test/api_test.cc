@@ -113,6 +113,55 @@ TEST_F(ApiTest, CheckSatisfiabilityUnsat) {
   }
 }
 
+// Tests CheckSatisfiability with a config.
+TEST_F(ApiTest, CheckSatisfiabilityWithConfig) {
+  const Formula f{x_ * x_ + y_ * y_ == 1.0 && x_ == 2 * y_};
+  Config config;
+  config.mutable_precision() = 0.001;
+  Box b;
+  EXPECT_EQ(CheckSatisfiability(f, config, &b), SatCheckResult::DELTA_SAT);
+  EXPECT_NEAR(b[x_].mid(), 2 * b[y_].mid(), 0.01);
+  EXPECT_EQ(CheckSatisfiability(f && x_ > 2, config, &b),
+            SatCheckResult::UNSAT);
+}
+
+TEST_F(ApiTest, CheckSatisfiabilityCancelled) {
+  const Formula f{x_ * x_ + y_ * y_ == 1.0 && x_ == 2 * y_};
+  Config config;
+  config.mutable_cancellation_token().Cancel();
+  Box b;
+  EXPECT_EQ(CheckSatisfiability(f, config, &b), SatCheckResult::UNKNOWN);
+}
+
+TEST_F(ApiTest, CheckSatisfiabilityTimeout) {
+  const Formula f{x_ * x_ + y_ * y_ == 1.0 && x_ == 2 * y_};
+  Config config;
+  config.mutable_timeout() = 1e-9;
+  Box b;
+  EXPECT_EQ(CheckSatisfiability(f, config, &b), SatCheckResult::UNKNOWN);
+}
+
+TEST_F(ApiTest, CheckSatisfiabilityMaxPrunings) {
+  // There are two solutions. It cannot find a delta-solution without
+  // branching, which requires more than one pruning operation.
+  const Formula f{x_ * x_ + y_ * y_ == 1.0 && x_ == 2 * y_};
+  Config config;
+  config.mutable_max_prunings() = 1;
+  Box b;
+  EXPECT_EQ(CheckSatisfiability(f, config, &b), SatCheckResult::UNKNOWN);
+}
+
+TEST_F(ApiTest, CheckSatisfiabilityMaxSatCalls) {
+  // The first theory check is UNSAT. It needs another SAT call.
+  const Formula f{(x_ > 5 || x_ < -5) && x_ * x_ < 1};
+  Config config;
+  config.mutable_max_sat_calls() = 1;
+  Box b;
+  EXPECT_EQ(CheckSatisfiability(f, config, &b), SatCheckResult::UNKNOWN);
+  config.mutable_max_sat_calls() = 0;  // No limit.
+  EXPECT_EQ(CheckSatisfiability(f, config, &b), SatCheckResult::UNSAT);
+}
+
 TEST_F(ApiTest, Minimize1) {
   // minimize 2x² + 6x + 5 s.t. -4 ≤ x ≤ 0
   const Expression objective{2 * x_ * x_ + 6 * x_ + 5};
@@ -1,6 +1,8 @@
 #include "dreal/contractor/contractor.h"
 
 #include <algorithm>
+#include <atomic>
+#include <set>
 #include <utility>
 
 #include "dreal/contractor/contractor_cell.h"
@@ -8,6 +10,7 @@
 #include "dreal/contractor/contractor_forall.h"
 #include "dreal/contractor/contractor_ibex_fwdbwd.h"
 #include "dreal/contractor/contractor_ibex_polytope.h"
+#include "dreal/contractor/contractor_ibex_shared_fwdbwd.h"
 #include "dreal/contractor/contractor_id.h"
 #include "dreal/contractor/contractor_integer.h"
 #include "dreal/contractor/contractor_join.h"
@@ -19,6 +22,7 @@ using std::cout;
 using std::make_shared;
 using std::move;
 using std::ostream;
+using std::set;
 using std::shared_ptr;
 using std::vector;
 
@@ -58,10 +62,14 @@ class ContractorStat {
     if (DREAL_LOG_INFO_ENABLED) {
       using fmt::print;
       print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Pruning",
-            "Contractor level", num_prune_);
+            "Contractor level", num_prune_.load());
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of Pruning (skipped, entailed)", "Contractor level",
+            num_skipped_.load());
     }
   }
-  int num_prune_{0};
+  std::atomic<int> num_prune_{0};
+  std::atomic<int> num_skipped_{0};
 };
 
 }  // namespace
@@ -74,12 +82,28 @@ const ibex::BitSet& Contractor::input() const { return ptr_->input(); }
 
 void Contractor::Prune(ContractorStatus* cs) const {
   static ContractorStat stat;
+  if (constraint_id_ >= 0 && cs->is_entailed(constraint_id_)) {
+    // All points in the box satisfy the constraint. There is nothing to
+    // prune.
+    stat.num_skipped_++;
+    return;
+  }
   stat.num_prune_++;
   ptr_->Prune(cs);
 }
 
+int Contractor::constraint_id() const { return constraint_id_; }
+
+void Contractor::set_constraint_id(const int id) { constraint_id_ = id; }
+
 Contractor::Kind Contractor::kind() const { return ptr_->kind(); }
 
+Contractor Contractor::Clone() const {
+  Contractor clone{ptr_->Clone()};
+  clone.constraint_id_ = constraint_id_;
+  return clone;
+}
+
 Contractor make_contractor_id() { return Contractor{}; }
 
 Contractor make_contractor_integer(const Box& box) {
@@ -108,25 +132,58 @@ Contractor make_contractor_ibex_polytope(vector<Formula> formulas,
   return Contractor{make_shared<ContractorIbexPolytope>(move(formulas), box)};
 }
 
+Contractor make_contractor_ibex_shared_fwdbwd(vector<Formula> formulas,
+                                              const Box& box) {
+  return Contractor{
+      make_shared<ContractorIbexSharedFwdbwd>(move(formulas), box)};
+}
+
+Contractor make_contractor_ibex_shared_fwdbwd(vector<Formula> formulas,
+                                              const set<Formula>& atoms,
+                                              const Box& box) {
+  return Contractor{
+      make_shared<ContractorIbexSharedFwdbwd>(move(formulas), atoms, box)};
+}
+
 Contractor make_contractor_fixpoint(TerminationCondition term_cond,
                                     const vector<Contractor>& contractors) {
+  return make_contractor_fixpoint(move(term_cond), contractors, false);
+}
+
+Contractor make_contractor_fixpoint(TerminationCondition term_cond,
+                                    const vector<Contractor>& contractors,
+                                    const bool use_scheduler) {
   vector<Contractor> ctcs{Flatten(contractors)};
   if (ctcs.empty()) {
     return make_contractor_id();
   } else {
-    return Contractor{
-        make_shared<ContractorFixpoint>(move(term_cond), move(ctcs))};
+    return Contractor{make_shared<ContractorFixpoint>(
+        move(term_cond), move(ctcs), use_scheduler)};
   }
 }
 
 Contractor make_contractor_worklist_fixpoint(
     TerminationCondition term_cond, const vector<Contractor>& contractors) {
+  return make_contractor_worklist_fixpoint(move(term_cond), contractors,
+                                           false);
+}
+
+Contractor make_contractor_worklist_fixpoint(
+    TerminationCondition term_cond, const vector<Contractor>& contractors,
+    const bool use_scheduler) {
+  return make_contractor_worklist_fixpoint(move(term_cond), contractors,
+                                           use_scheduler, 0.0);
+}
+
+Contractor make_contractor_worklist_fixpoint(
+    TerminationCondition term_cond, const vector<Contractor>& contractors,
+    const bool use_scheduler, const double propagation_threshold) {
   vector<Contractor> ctcs{Flatten(contractors)};
   if (ctcs.empty()) {
     return make_contractor_id();
   } else {
-    return Contractor{
-        make_shared<ContractorWorklistFixpoint>(move(term_cond), move(ctcs))};
+    return Contractor{make_shared<ContractorWorklistFixpoint>(
+        move(term_cond), move(ctcs), use_scheduler, propagation_threshold)};
   }
 }
 
@@ -156,6 +213,9 @@ bool is_ibex_fwdbwd(const Contractor& contractor) {
 bool is_ibex_polytope(const Contractor& contractor) {
   return contractor.kind() == Contractor::Kind::IBEX_POLYTOPE;
 }
+bool is_ibex_shared_fwdbwd(const Contractor& contractor) {
+  return contractor.kind() == Contractor::Kind::IBEX_SHARED_FWDBWD;
+}
 bool is_fixpoint(const Contractor& contractor) {
   return contractor.kind() == Contractor::Kind::FIXPOINT;
 }
@@ -1,12 +1,14 @@
 #pragma once
 #include <iostream>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "./ibex.h"
 
 #include "dreal/contractor/contractor_status.h"
 #include "dreal/util/box.h"
+#include "dreal/util/cancellation_token.h"
 #include "dreal/util/ibex_converter.h"
 
 namespace dreal {
@@ -18,6 +20,7 @@ class ContractorInteger;
 class ContractorSeq;
 class ContractorIbexFwdbwd;
 class ContractorIbexPolytope;
+class ContractorIbexSharedFwdbwd;
 class ContractorFixpoint;
 class ContractorWorklistFixpoint;
 class ContractorJoin;
@@ -36,6 +39,7 @@ class Contractor {
     SEQ,
     IBEX_FWDBWD,
     IBEX_POLYTOPE,
+    IBEX_SHARED_FWDBWD,
     FIXPOINT,
     WORKLIST_FIXPOINT,
     FORALL,
@@ -64,18 +68,39 @@ class Contractor {
   /// means that this contractor depends on the value of `box[i]`.
   const ibex::BitSet& input() const;
 
-  /// Prunes @p cs.
+  /// Prunes @p cs. It does nothing if @p cs entails the constraint of this
+  /// contractor. See constraint_id().
   void Prune(ContractorStatus* cs) const;
 
+  /// Returns the index of the constraint enforced by this contractor. It is
+  /// -1 if the contractor is not associated with a single constraint.
+  ///
+  /// @note The index is a property of this handle, not of the shared
+  /// contractor cell. The same cell can have different indices in
+  /// different contractor trees.
+  int constraint_id() const;
+
+  /// Sets the index of the constraint enforced by this contractor.
+  void set_constraint_id(int id);
+
   /// Returns kind.
   Kind kind() const;
 
+  /// Returns a contractor which behaves the same as this one but does not
+  /// share any mutable state with it. It allows us to prune boxes in
+  /// multiple threads, one clone per thread.
+  ///
+  /// @note It is not safe to call this method while another thread is
+  /// using this contractor.
+  Contractor Clone() const;
+
   friend std::ostream& operator<<(std::ostream& os, Contractor const& c);
 
  private:
   explicit Contractor(const std::shared_ptr<ContractorCell>& ptr);
 
   std::shared_ptr<ContractorCell> ptr_{};
+  int constraint_id_{-1};
 
   friend Contractor make_contractor_id();
   friend Contractor make_contractor_integer(const Box& box);
@@ -84,16 +109,19 @@ class Contractor {
   friend Contractor make_contractor_ibex_fwdbwd(Formula f, const Box& box);
   friend Contractor make_contractor_ibex_polytope(std::vector<Formula> formulas,
                                                   const Box& box);
+  friend Contractor make_contractor_ibex_shared_fwdbwd(
+      std::vector<Formula> formulas, const Box& box);
   friend Contractor make_contractor_fixpoint(
       TerminationCondition term_cond,
-      const std::vector<Contractor>& contractors);
+      const std::vector<Contractor>& contractors, bool use_scheduler);
   friend Contractor make_contractor_worklist_fixpoint(
       TerminationCondition term_cond,
-      const std::vector<Contractor>& contractors);
+      const std::vector<Contractor>& contractors, bool use_scheduler,
+      double propagation_threshold);
   template <typename ContextType>
-  friend Contractor make_contractor_forall(Formula f, const Box& box,
-                                           double delta1, double delta2,
-                                           bool use_polytope);
+  friend Contractor make_contractor_forall(
+      Formula f, const Box& box, double delta1, double delta2,
+      bool use_polytope, const CancellationToken& cancellation_token);
   friend Contractor make_contractor_join(std::vector<Contractor> vec);
 
   // Note that the following converter functions are only for
@@ -107,6 +135,8 @@ class Contractor {
       const Contractor& contractor);
   friend std::shared_ptr<ContractorIbexPolytope> to_ibex_polytope(
       const Contractor& contractor);
+  friend std::shared_ptr<ContractorIbexSharedFwdbwd> to_ibex_shared_fwdbwd(
+      const Contractor& contractor);
   friend std::shared_ptr<ContractorFixpoint> to_fixpoint(
       const Contractor& contractor);
   friend std::shared_ptr<ContractorWorklistFixpoint> to_worklist_fixpoint(
@@ -148,6 +178,22 @@ Contractor make_contractor_ibex_fwdbwd(Formula f, const Box& box);
 Contractor make_contractor_ibex_polytope(std::vector<Formula> formulas,
                                          const Box& box);
 
+/// Returns a contractor running IBEX's forward/backward contractor over
+/// @p formulas at once, with their common subexpressions shared.
+///
+/// @see ContractorIbexSharedFwdbwd.
+Contractor make_contractor_ibex_shared_fwdbwd(std::vector<Formula> formulas,
+                                              const Box& box);
+
+/// Returns a contractor running IBEX's forward/backward contractor over
+/// @p formulas at once, using the function compiled from @p atoms. The
+/// atoms which are not in @p formulas do not prune a box.
+///
+/// @see ContractorIbexSharedFwdbwd.
+Contractor make_contractor_ibex_shared_fwdbwd(std::vector<Formula> formulas,
+                                              const std::set<Formula>& atoms,
+                                              const Box& box);
+
 /// Returns a fixed-point contractor. The returned contractor applies
 /// the contractors in @p vec sequentially until @p term_cond is met.
 ///
@@ -155,6 +201,15 @@ Contractor make_contractor_ibex_polytope(std::vector<Formula> formulas,
 Contractor make_contractor_fixpoint(TerminationCondition term_cond,
                                     const std::vector<Contractor>& contractors);
 
+/// Returns a fixed-point contractor. If @p use_scheduler is true, the
+/// returned contractor orders the contractors in @p vec by their measured
+/// effectiveness and skips the ineffective ones.
+///
+/// @see ContractorFixpoint.
+Contractor make_contractor_fixpoint(TerminationCondition term_cond,
+                                    const std::vector<Contractor>& contractors,
+                                    bool use_scheduler);
+
 /// Returns a worklist fixed-point contractor. The returned contractor
 /// applies the contractors in @p vec sequentially until @p term_cond
 /// is met.
@@ -163,6 +218,25 @@ Contractor make_contractor_fixpoint(TerminationCondition term_cond,
 Contractor make_contractor_worklist_fixpoint(
     TerminationCondition term_cond, const std::vector<Contractor>& contractors);
 
+/// Returns a worklist fixed-point contractor. If @p use_scheduler is true,
+/// the returned contractor picks the contractor with the highest priority
+/// from the worklist and skips the ineffective ones.
+///
+/// @see ContractorWorklistFixpoint.
+Contractor make_contractor_worklist_fixpoint(
+    TerminationCondition term_cond, const std::vector<Contractor>& contractors,
+    bool use_scheduler);
+
+/// Returns a worklist fixed-point contractor. A change of a dimension
+/// wakes up the contractors depending on it only if a bound moves by more
+/// than @p propagation_threshold, relative to the width of the old
+/// interval. See ContractorStatus::output_change().
+///
+/// @see ContractorWorklistFixpoint.
+Contractor make_contractor_worklist_fixpoint(
+    TerminationCondition term_cond, const std::vector<Contractor>& contractors,
+    bool use_scheduler, double propagation_threshold);
+
 /// Returns a join contractor. The returned contractor does the following
 /// operation:
 /// <pre>
@@ -178,7 +252,8 @@ Contractor make_contractor_join(std::vector<Contractor> vec);
 /// @see ContractorForall.
 template <typename ContextType>
 Contractor make_contractor_forall(Formula f, const Box& box, double delta1,
-                                  double delta2, bool use_polytope);
+                                  double delta2, bool use_polytope,
+                                  const CancellationToken& cancellation_token);
 
 std::ostream& operator<<(std::ostream& os, const Contractor& ctc);
 
@@ -197,6 +272,9 @@ bool is_ibex_fwdbwd(const Contractor& contractor);
 /// Returns true if @p contractor is IBEX polytope contractor.
 bool is_ibex_polytope(const Contractor& contractor);
 
+/// Returns true if @p contractor is IBEX shared fwdbwd contractor.
+bool is_ibex_shared_fwdbwd(const Contractor& contractor);
+
 /// Returns true if @p contractor is fixpoint contractor.
 bool is_fixpoint(const Contractor& contractor);
 
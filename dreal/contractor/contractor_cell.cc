@@ -6,6 +6,7 @@
 #include "dreal/contractor/contractor_forall.h"
 #include "dreal/contractor/contractor_ibex_fwdbwd.h"
 #include "dreal/contractor/contractor_ibex_polytope.h"
+#include "dreal/contractor/contractor_ibex_shared_fwdbwd.h"
 #include "dreal/contractor/contractor_id.h"
 #include "dreal/contractor/contractor_integer.h"
 #include "dreal/contractor/contractor_join.h"
@@ -48,6 +49,15 @@ int ComputeInputSize(const vector<Contractor>& contractors) {
   return ret + 1;
 }
 
+vector<Contractor> CloneContractors(const vector<Contractor>& contractors) {
+  vector<Contractor> clones;
+  clones.reserve(contractors.size());
+  for (const Contractor& c : contractors) {
+    clones.push_back(c.Clone());
+  }
+  return clones;
+}
+
 ostream& operator<<(ostream& os, const ContractorCell& c) {
   return c.display(os);
 }
@@ -73,13 +83,18 @@ shared_ptr<ContractorIbexPolytope> to_ibex_polytope(
   DREAL_ASSERT(is_ibex_polytope(contractor));
   return static_pointer_cast<ContractorIbexPolytope>(contractor.ptr_);
 }
+shared_ptr<ContractorIbexSharedFwdbwd> to_ibex_shared_fwdbwd(
+    const Contractor& contractor) {
+  DREAL_ASSERT(is_ibex_shared_fwdbwd(contractor));
+  return static_pointer_cast<ContractorIbexSharedFwdbwd>(contractor.ptr_);
+}
 shared_ptr<ContractorFixpoint> to_fixpoint(const Contractor& contractor) {
   DREAL_ASSERT(is_fixpoint(contractor));
   return static_pointer_cast<ContractorFixpoint>(contractor.ptr_);
 }
 shared_ptr<ContractorWorklistFixpoint> to_worklist_fixpoint(
     const Contractor& contractor) {
-  DREAL_ASSERT(is_fixpoint(contractor));
+  DREAL_ASSERT(is_worklist_fixpoint(contractor));
   return static_pointer_cast<ContractorWorklistFixpoint>(contractor.ptr_);
 }
 shared_ptr<ContractorJoin> to_join(const Contractor& contractor) {
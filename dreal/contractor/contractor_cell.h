@@ -18,6 +18,7 @@ class ContractorInteger;
 class ContractorSeq;
 class ContractorIbexFwdbwd;
 class ContractorIbexPolytope;
+class ContractorIbexSharedFwdbwd;
 class ContractorFixpoint;
 class ContractorWorklistFixpoint;
 class ContractorJoin;
@@ -60,6 +61,12 @@ class ContractorCell {
   /// Performs pruning on @p cs.
   virtual void Prune(ContractorStatus* cs) const = 0;
 
+  /// Returns a new cell which behaves the same as this one but does not
+  /// share any mutable state with it.
+  ///
+  /// @see Contractor::Clone().
+  virtual std::shared_ptr<ContractorCell> Clone() const = 0;
+
   /// Outputs this contractor to @p os.
   virtual std::ostream& display(std::ostream& os) const = 0;
 
@@ -74,6 +81,12 @@ class ContractorCell {
 /// ContractorWorklistFixpoint to find the size of its input BitSet.
 int ComputeInputSize(const std::vector<Contractor>& contractors);
 
+/// Returns the clones of @p contractors.
+///
+/// @see Contractor::Clone().
+std::vector<Contractor> CloneContractors(
+    const std::vector<Contractor>& contractors);
+
 std::ostream& operator<<(std::ostream& os, const ContractorCell& c);
 
 /// Converts @p contractor to ContractorId.
@@ -93,6 +106,10 @@ std::shared_ptr<ContractorIbexFwdbwd> to_ibex_fwdbwd(
 std::shared_ptr<ContractorIbexPolytope> to_ibex_polytope(
     const Contractor& contractor);
 
+/// Converts @p contractor to ContractorIbexSharedFwdbwd.
+std::shared_ptr<ContractorIbexSharedFwdbwd> to_ibex_shared_fwdbwd(
+    const Contractor& contractor);
+
 /// Converts @p contractor to ContractorFixpoint.
 std::shared_ptr<ContractorFixpoint> to_fixpoint(const Contractor& contractor);
 
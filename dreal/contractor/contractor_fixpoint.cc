@@ -5,18 +5,23 @@
 #include "dreal/util/assert.h"
 #include "dreal/util/logging.h"
 
+using std::make_shared;
 using std::move;
 using std::ostream;
+using std::shared_ptr;
 using std::vector;
 
 namespace dreal {
 
 ContractorFixpoint::ContractorFixpoint(TerminationCondition term_cond,
-                                       vector<Contractor> contractors)
+                                       vector<Contractor> contractors,
+                                       const bool use_scheduler)
     : ContractorCell{Contractor::Kind::FIXPOINT,
                      ibex::BitSet::empty(ComputeInputSize(contractors))},
       term_cond_{move(term_cond)},
       contractors_{move(contractors)},
+      scheduler_{use_scheduler ? new ContractorScheduler{contractors_}
+                               : nullptr},
       old_iv_{1 /* will be updated anyway */} {
   DREAL_ASSERT(contractors_.size() > 0);
   ibex::BitSet& input{mutable_input()};
@@ -26,6 +31,10 @@ ContractorFixpoint::ContractorFixpoint(TerminationCondition term_cond,
 }
 
 void ContractorFixpoint::Prune(ContractorStatus* cs) const {
+  if (scheduler_) {
+    PruneWithScheduler(cs);
+    return;
+  }
   do {
     old_iv_ = cs->box().interval_vector();
     for (const Contractor& ctc : contractors_) {
@@ -37,6 +46,38 @@ void ContractorFixpoint::Prune(ContractorStatus* cs) const {
   } while (!term_cond_(old_iv_, cs->box().interval_vector()));
 }
 
+void ContractorFixpoint::PruneWithScheduler(ContractorStatus* cs) const {
+  scheduler_->StartPruning();
+  while (true) {
+    old_iv_ = cs->box().interval_vector();
+    scheduler_->Schedule(&cheap_contractors_, &expensive_contractors_);
+    for (const int i : cheap_contractors_) {
+      scheduler_->Prune(i, contractors_[i], cs);
+      if (cs->box().empty()) {
+        return;
+      }
+    }
+    if (!term_cond_(old_iv_, cs->box().interval_vector())) {
+      continue;
+    }
+    // The cheap contractors have stalled.
+    for (const int i : expensive_contractors_) {
+      scheduler_->Prune(i, contractors_[i], cs);
+      if (cs->box().empty()) {
+        return;
+      }
+    }
+    if (term_cond_(old_iv_, cs->box().interval_vector())) {
+      return;
+    }
+  }
+}
+
+shared_ptr<ContractorCell> ContractorFixpoint::Clone() const {
+  return make_shared<ContractorFixpoint>(
+      term_cond_, CloneContractors(contractors_), scheduler_ != nullptr);
+}
+
 ostream& ContractorFixpoint::display(ostream& os) const {
   os << "Fixpoint(";
   for (const Contractor& c : contractors_) {
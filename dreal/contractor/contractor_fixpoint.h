@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <ostream>
 #include <unordered_map>
 #include <unordered_set>
@@ -8,6 +9,7 @@
 
 #include "dreal/contractor/contractor.h"
 #include "dreal/contractor/contractor_cell.h"
+#include "dreal/contractor/contractor_scheduler.h"
 #include "dreal/util/box.h"
 
 namespace dreal {
@@ -24,17 +26,34 @@ class ContractorFixpoint : public ContractorCell {
 
   /// Constructs a fixpoint contractor with a termination condition
   /// (Box × Box → Bool) and a sequence of Contractors {C₁, ..., Cₙ}.
+  ///
+  /// If @p use_scheduler is true, it orders the contractors by their
+  /// measured effectiveness and skips the ineffective ones. See
+  /// ContractorScheduler.
   ContractorFixpoint(TerminationCondition term_cond,
-                     std::vector<Contractor> contractors);
+                     std::vector<Contractor> contractors,
+                     bool use_scheduler = false);
 
   void Prune(ContractorStatus* cs) const override;
+  std::shared_ptr<ContractorCell> Clone() const override;
   std::ostream& display(std::ostream& os) const override;
 
  private:
+  // Prune() with the scheduler. In each round, it runs the cheap
+  // contractors in the order of their priorities. It runs the expensive
+  // ones only if the cheap ones have stalled.
+  void PruneWithScheduler(ContractorStatus* cs) const;
+
   // Stop the fixed-point iteration if term_cond(old_box, new_box) is true.
   const TerminationCondition term_cond_;
   std::vector<Contractor> contractors_;
 
+  // It is nullptr if the scheduler is not used.
+  const std::unique_ptr<ContractorScheduler> scheduler_;
+  // The contractors to run in a round. See PruneWithScheduler().
+  mutable std::vector<int> cheap_contractors_;
+  mutable std::vector<int> expensive_contractors_;
+
   // Temporary storage for old interval vector.
   mutable Box::IntervalVector old_iv_;
 };
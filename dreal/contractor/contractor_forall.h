@@ -12,6 +12,7 @@
 #include "dreal/contractor/generic_contractor_generator.h"
 #include "dreal/util/assert.h"
 #include "dreal/util/box.h"
+#include "dreal/util/cancellation_token.h"
 #include "dreal/util/logging.h"
 #include "dreal/util/nnfizer.h"
 
@@ -41,14 +42,21 @@ template <typename ContextType>
 class ContractorForall : public ContractorCell {
  public:
   /// Constructs Forall contractor using @p f and @p box. @p epsilon is
-  /// used to strengthen ¬φ and @p delta is used to solve (¬φ)⁻ᵟ¹.
+  /// used to strengthen ¬φ and @p delta is used to solve (¬φ)⁻ᵟ¹. The
+  /// nested context to find counterexamples stops when @p
+  /// cancellation_token is cancelled.
   ///
   /// @pre epsilon > delta > 0.0
   ContractorForall(Formula f, const Box& box, double epsilon, double delta,
-                   bool use_polytope)
+                   bool use_polytope, CancellationToken cancellation_token)
       : ContractorCell{Contractor::Kind::FORALL,
                        ibex::BitSet::empty(box.size())},
         f_{std::move(f)},
+        box_{box},
+        epsilon_{epsilon},
+        delta_{delta},
+        use_polytope_{use_polytope},
+        cancellation_token_{std::move(cancellation_token)},
         strengthend_negated_nested_f_{Nnfizer{}.Convert(
             DeltaStrengthen(!get_quantified_formula(f_), epsilon),
             use_polytope)},
@@ -62,6 +70,8 @@ class ContractorForall : public ContractorCell {
     // Setup context:
     // 1. Add exist/forall variables.
     context_for_counterexample_.mutable_config().mutable_precision() = delta;
+    context_for_counterexample_.mutable_config().mutable_cancellation_token() =
+        cancellation_token_;
     for (const Variable& exist_var : box.variables()) {
       context_for_counterexample_.DeclareVariable(exist_var);
     }
@@ -98,14 +108,21 @@ class ContractorForall : public ContractorCell {
                                                 current_box[exist_var].lb(),
                                                 current_box[exist_var].ub());
       }
-      const std::experimental::optional<Box> counterexample =
-          context_for_counterexample_.CheckSat();
-      if (counterexample) {
+      Box counterexample;
+      const CheckSatResult result{
+          context_for_counterexample_.CheckSat(&counterexample)};
+      if (result == CheckSatResult::UNKNOWN) {
+        // The nested context is cancelled. We stop here without pruning the
+        // box further, which is still sound.
+        DREAL_LOG_DEBUG("ContractorForall::Prune: Cancelled.");
+        break;
+      }
+      if (result == CheckSatResult::DELTA_SAT) {
         // 1.1. Counterexample found.
         DREAL_LOG_DEBUG("ContractorForall::Prune: Counterexample found:\n{}",
-                        *counterexample);
+                        counterexample);
         // Need to prune the current_box using counterexample.
-        ContractorStatus contractor_status(*counterexample);
+        ContractorStatus contractor_status(counterexample);
         // 1.1.1. Set up exist_var parts for pruning
         for (const Variable& exist_var : current_box.variables()) {
           contractor_status.mutable_box()[exist_var] = current_box[exist_var];
@@ -115,7 +132,7 @@ class ContractorForall : public ContractorCell {
         // taking the mid-points of counterexample.
         for (const Variable& forall_var : get_quantified_variables(f_)) {
           contractor_status.mutable_box()[forall_var] =
-              (*counterexample)[forall_var].mid();
+              counterexample[forall_var].mid();
         }
         contractor_.Prune(&contractor_status);
         if (contractor_status.box().empty()) {
@@ -129,7 +146,7 @@ class ContractorForall : public ContractorCell {
           bool changed = false;
           for (int i = 0; i < cs->box().size(); ++i) {
             if (cs->box()[i] != contractor_status.box()[i]) {
-              cs->mutable_output().add(i);
+              cs->AddOutput(i, current_box[i]);
               current_box[i] = contractor_status.box()[i];
               changed = true;
             }
@@ -148,9 +165,20 @@ class ContractorForall : public ContractorCell {
     cs->AddUsedConstraint(f_);
   }
 
+  /// Returns a clone of this contractor. The clone has its own context to
+  /// find counterexamples.
+  std::shared_ptr<ContractorCell> Clone() const override {
+    return std::make_shared<ContractorForall<ContextType>>(
+        f_, box_, epsilon_, delta_, use_polytope_, cancellation_token_);
+  }
+
   std::ostream& display(std::ostream& os) const override { return os << f_; }
 
  private:
+  // Result type of ContextType::CheckSat(Box*).
+  using CheckSatResult = decltype(
+      std::declval<ContextType&>().CheckSat(std::declval<Box*>()));
+
   static Box ExtendBox(Box box, const Variables& vars) {
     for (const Variable& v : vars) {
       box.Add(v);
@@ -158,7 +186,14 @@ class ContractorForall : public ContractorCell {
     return box;
   }
 
-  const Formula f_;                             // ∀X.φ
+  const Formula f_;  // ∀X.φ
+  // The parameters used to construct this contractor. They are used in
+  // Clone().
+  const Box box_;
+  const double epsilon_{};
+  const double delta_{};
+  const bool use_polytope_{};
+  const CancellationToken cancellation_token_;
   const Formula strengthend_negated_nested_f_;  // (¬φ)⁻ᵟ¹
   // To compute `B' = Contract(φ(x₁, ..., xₙ, b₁, ..., bₘ), B)`.
   Contractor contractor_;
@@ -168,9 +203,10 @@ class ContractorForall : public ContractorCell {
 
 template <typename ContextType>
 Contractor make_contractor_forall(Formula f, const Box& box, double epsilon,
-                                  double delta, bool use_polytope) {
+                                  double delta, bool use_polytope,
+                                  const CancellationToken& cancellation_token) {
   return Contractor{std::make_shared<ContractorForall<ContextType>>(
-      std::move(f), box, epsilon, delta, use_polytope)};
+      std::move(f), box, epsilon, delta, use_polytope, cancellation_token)};
 }
 
 /// Converts @p contractor to ContractorForall.
@@ -1,10 +1,13 @@
 #include "dreal/contractor/contractor_ibex_fwdbwd.h"
 
+#include <algorithm>
+#include <atomic>
 #include <sstream>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "dreal/util/ibex_constraint_cache.h"
 #include "dreal/util/logging.h"
 #include "dreal/util/math.h"
 
@@ -12,6 +15,7 @@ using std::cout;
 using std::move;
 using std::ostream;
 using std::ostringstream;
+using std::shared_ptr;
 using std::unordered_map;
 using std::vector;
 
@@ -25,15 +29,16 @@ class ContractorIbexFwdbwdStat {
     if (DREAL_LOG_INFO_ENABLED) {
       using fmt::print;
       print(cout, "{:<45} @ {:<20} = {:>15}\n",
-            "Total # of ibex-fwdbwd Pruning", "Pruning level", num_pruning_);
+            "Total # of ibex-fwdbwd Pruning", "Pruning level",
+            num_pruning_.load());
       print(cout, "{:<45} @ {:<20} = {:>15}\n",
             "Total # of ibex-fwdbwd Pruning (zero-effect)", "Pruning level",
-            num_zero_effect_pruning_);
+            num_zero_effect_pruning_.load());
     }
   }
 
-  int num_zero_effect_pruning_{0};
-  int num_pruning_{0};
+  std::atomic<int> num_zero_effect_pruning_{0};
+  std::atomic<int> num_pruning_{0};
 };
 }  // namespace
 
@@ -44,21 +49,41 @@ ContractorIbexFwdbwd::ContractorIbexFwdbwd(Formula f, const Box& box)
     : ContractorCell{Contractor::Kind::IBEX_FWDBWD,
                      ibex::BitSet::empty(box.size())},
       f_{move(f)},
-      ibex_converter_{box},
+      iv_{1 /* Will be overwritten anyway */},
       old_iv_{1 /* Will be overwritten anyway */} {
-  // Build num_ctr and ctc_.
-  expr_ctr_.reset(ibex_converter_.Convert(f_));
-  if (expr_ctr_) {
-    num_ctr_.reset(
-        new ibex::NumConstraint(ibex_converter_.variables(), *expr_ctr_));
-  }
-  if (num_ctr_) {
-    ctc_.reset(new ibex::CtcFwdBwd{*num_ctr_});
-  }
   // Build input.
   ibex::BitSet& input{mutable_input()};
   for (const Variable& var : f_.GetFreeVariables()) {
-    input.add(box.index(var));
+    const int idx{box.index(var)};
+    input.add(idx);
+    indices_.push_back(idx);
+  }
+  std::sort(indices_.begin(), indices_.end());
+  for (const int idx : indices_) {
+    variables_.push_back(box.variable(idx));
+  }
+  // Build num_ctr and ctc_.
+  const shared_ptr<const CompiledIbexConstraint> compiled{
+      IbexConstraintCache::Global().Get(f_, variables_, box)};
+  if (compiled->num_ctr) {
+    function_.reset(new ibex::Function{compiled->num_ctr->f});
+    num_ctr_.reset(new ibex::NumConstraint{*function_, compiled->num_ctr->op});
+    ctc_.reset(new ibex::CtcFwdBwd{*num_ctr_});
+    iv_.resize(indices_.size());
+  }
+}
+
+ContractorIbexFwdbwd::ContractorIbexFwdbwd(const ContractorIbexFwdbwd& other)
+    : ContractorCell{Contractor::Kind::IBEX_FWDBWD, other.input()},
+      f_{other.f_},
+      variables_{other.variables_},
+      indices_{other.indices_},
+      iv_{other.iv_},
+      old_iv_{1 /* Will be overwritten anyway */} {
+  if (other.num_ctr_) {
+    function_.reset(new ibex::Function{other.num_ctr_->f});
+    num_ctr_.reset(new ibex::NumConstraint{*function_, other.num_ctr_->op});
+    ctc_.reset(new ibex::CtcFwdBwd{*num_ctr_});
   }
 }
 
@@ -66,22 +91,29 @@ void ContractorIbexFwdbwd::Prune(ContractorStatus* cs) const {
   static ContractorIbexFwdbwdStat stat;
   if (ctc_) {
     Box::IntervalVector& iv{cs->mutable_box().mutable_interval_vector()};
-    old_iv_ = iv;
+    // Gather the sub-vector over variables_.
+    for (size_t i = 0; i < indices_.size(); ++i) {
+      iv_[i] = iv[indices_[i]];
+    }
+    old_iv_ = iv_;
     DREAL_LOG_TRACE("ContractorIbexFwdbwd::Prune");
     DREAL_LOG_TRACE("CTC = {}", *num_ctr_);
     DREAL_LOG_TRACE("F = {}", f_);
-    ctc_->contract(iv);
+    ctc_->contract(iv_);
     stat.num_pruning_++;
     bool changed{false};
-    // Update output.
-    if (iv.is_empty()) {
+    // Scatter the changed dimensions back and update output. The output
+    // of ctc_ is indexed by the position in variables_.
+    if (iv_.is_empty()) {
       changed = true;
+      cs->mutable_box().set_empty();
       cs->mutable_output().fill(0, cs->box().size() - 1);
     } else {
       for (int i = 0, idx = ctc_->output->min(); i < ctc_->output->size();
            ++i, idx = ctc_->output->next(idx)) {
-        if (old_iv_[idx] != iv[idx]) {
-          cs->mutable_output().add(idx);
+        if (old_iv_[idx] != iv_[idx]) {
+          iv[indices_[idx]] = iv_[idx];
+          cs->AddOutput(indices_[idx], old_iv_[idx]);
           changed = true;
         }
       }
@@ -91,8 +123,7 @@ void ContractorIbexFwdbwd::Prune(ContractorStatus* cs) const {
       cs->AddUsedConstraint(f_);
       if (DREAL_LOG_TRACE_ENABLED) {
         ostringstream oss;
-        DisplayDiff(oss, cs->box().variables(), old_iv_,
-                    cs->box().interval_vector());
+        DisplayDiff(oss, variables_, old_iv_, iv_);
         DREAL_LOG_TRACE("Changed\n{}", oss.str());
       }
     } else {
@@ -102,8 +133,16 @@ void ContractorIbexFwdbwd::Prune(ContractorStatus* cs) const {
   }
 }
 
+shared_ptr<ContractorCell> ContractorIbexFwdbwd::Clone() const {
+  return shared_ptr<ContractorCell>{new ContractorIbexFwdbwd{*this}};
+}
+
 Box::Interval ContractorIbexFwdbwd::Evaluate(const Box& box) const {
-  return num_ctr_->f.eval(box.interval_vector());
+  Box::IntervalVector iv(indices_.size());
+  for (size_t i = 0; i < indices_.size(); ++i) {
+    iv[i] = box[indices_[i]];
+  }
+  return num_ctr_->f.eval(iv);
 }
 
 ostream& ContractorIbexFwdbwd::display(ostream& os) const {
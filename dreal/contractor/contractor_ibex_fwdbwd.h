@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <ostream>
+#include <vector>
 
 #include "./ibex.h"
 
@@ -18,13 +19,26 @@ class ContractorIbexFwdbwd : public ContractorCell {
   /// Deleted default constructor.
   ContractorIbexFwdbwd() = delete;
 
-  /// Constructs IbexFwdbwd contractor using @p f and @p box.
+  /// Constructs IbexFwdbwd contractor using @p f and @p box. The IBEX
+  /// constraint of @p f is taken from IbexConstraintCache::Global(), so
+  /// that the contractors of the same formula in different contexts do
+  /// not convert it again.
+  ///
+  /// The constraint is compiled over the free variables of @p f only. A
+  /// pruning gathers their intervals from a box, contracts them, and
+  /// scatters back the changed ones. So its cost does not depend on the
+  /// size of the box.
   ContractorIbexFwdbwd(Formula f, const Box& box);
 
   ~ContractorIbexFwdbwd() override = default;
 
   void Prune(ContractorStatus* cs) const override;
 
+  /// Returns a clone of this contractor. IBEX keeps the scratch space for
+  /// evaluation inside of an `ibex::Function`. So the clone owns a copy of
+  /// the compiled function instead of converting the formula again.
+  std::shared_ptr<ContractorCell> Clone() const override;
+
   /// Evaluates the constraint using the input @box and returns the
   /// result.
   Box::Interval Evaluate(const Box& box) const;
@@ -32,13 +46,25 @@ class ContractorIbexFwdbwd : public ContractorCell {
   std::ostream& display(std::ostream& os) const override;
 
  private:
+  // Constructs a clone of @p other. See Clone().
+  ContractorIbexFwdbwd(const ContractorIbexFwdbwd& other);
+
   const Formula f_;
-  IbexConverter ibex_converter_;
-  std::unique_ptr<const ibex::ExprCtr> expr_ctr_;
+  // A copy of the function in the compiled constraint. The compiled
+  // constraint is shared by other contractors and should not be used for
+  // evaluation.
+  std::unique_ptr<ibex::Function> function_;
   std::unique_ptr<const ibex::NumConstraint> num_ctr_;
   std::unique_ptr<ibex::CtcFwdBwd> ctc_;
 
-  // Temporary storage to store an old interval vector.
+  // The free variables of f_ ordered by their indices in the box, and the
+  // indices. The constraint is compiled over these variables.
+  std::vector<Variable> variables_;
+  std::vector<int> indices_;
+
+  // Temporary storage to store the sub-vector of a box over variables_,
+  // before and after pruning.
+  mutable Box::IntervalVector iv_;
   mutable Box::IntervalVector old_iv_;
 };
 
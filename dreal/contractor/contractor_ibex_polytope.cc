@@ -8,10 +8,12 @@
 #include "dreal/util/logging.h"
 #include "dreal/util/math.h"
 
+using std::make_shared;
 using std::make_unique;
 using std::move;
 using std::ostream;
 using std::ostringstream;
+using std::shared_ptr;
 using std::unique_ptr;
 using std::vector;
 
@@ -41,7 +43,8 @@ ContractorIbexPolytope::ContractorIbexPolytope(vector<Formula> formulas,
     : ContractorCell{Contractor::Kind::IBEX_POLYTOPE,
                      ibex::BitSet::empty(box.size())},
       formulas_{move(formulas)},
-      ibex_converter_{box},
+      box_{box},
+      ibex_converter_{box_},
       old_iv_{1 /* Will be overwritten anyway */} {
   DREAL_LOG_DEBUG("ContractorIbexPolytope::ContractorIbexPolytope");
 
@@ -93,7 +96,7 @@ void ContractorIbexPolytope::Prune(ContractorStatus* cs) const {
     } else {
       for (int i = 0; i < old_iv_.size(); ++i) {
         if (old_iv_[i] != iv[i]) {
-          cs->mutable_output().add(i);
+          cs->AddOutput(i, old_iv_[i]);
           changed = true;
         }
       }
@@ -113,6 +116,10 @@ void ContractorIbexPolytope::Prune(ContractorStatus* cs) const {
   }
 }
 
+shared_ptr<ContractorCell> ContractorIbexPolytope::Clone() const {
+  return make_shared<ContractorIbexPolytope>(formulas_, box_);
+}
+
 ostream& ContractorIbexPolytope::display(ostream& os) const {
   os << "IbexPolytope(";
   for (const Formula& f : formulas_) {
@@ -22,10 +22,17 @@ class ContractorIbexPolytope : public ContractorCell {
   ~ContractorIbexPolytope() override = default;
 
   void Prune(ContractorStatus* cs) const override;
+
+  /// Returns a clone of this contractor. The clone rebuilds the IBEX
+  /// objects because IBEX's linear relaxation keeps its own mutable state.
+  std::shared_ptr<ContractorCell> Clone() const override;
+
   std::ostream& display(std::ostream& os) const override;
 
  private:
   const std::vector<Formula> formulas_;
+  // The box used to construct this contractor. It is used in Clone().
+  const Box box_;
 
   IbexConverter ibex_converter_;
   std::unique_ptr<ibex::SystemFactory> system_factory_;
@@ -0,0 +1,232 @@
+#include "dreal/contractor/contractor_ibex_shared_fwdbwd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <set>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "dreal/util/exception.h"
+#include "dreal/util/ibex_constraint_cache.h"
+#include "dreal/util/logging.h"
+
+using std::cout;
+using std::map;
+using std::move;
+using std::numeric_limits;
+using std::ostream;
+using std::ostringstream;
+using std::set;
+using std::shared_ptr;
+using std::vector;
+
+namespace dreal {
+
+namespace {
+class ContractorIbexSharedFwdbwdStat {
+ public:
+  ContractorIbexSharedFwdbwdStat() = default;
+  ~ContractorIbexSharedFwdbwdStat() {
+    if (DREAL_LOG_INFO_ENABLED && num_pruning_ > 0) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of ibex-shared-fwdbwd Pruning", "Pruning level",
+            num_pruning_.load());
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of ibex-shared-fwdbwd Pruning (zero-effect)",
+            "Pruning level", num_zero_effect_pruning_.load());
+    }
+  }
+
+  std::atomic<int> num_zero_effect_pruning_{0};
+  std::atomic<int> num_pruning_{0};
+};
+
+// Decomposes @p f into `lhs - rhs ∈ target` where `lhs` and `rhs` are the
+// sides of @p atom. Returns false if @p f does not prune a box, that is,
+// if it is `e₁ ≠ e₂` or `¬(e₁ = e₂)`.
+//
+// @throw std::runtime_error if @p f is not a relational formula or its
+// negation.
+bool Decompose(const Formula& f, Formula* const atom,
+               Box::Interval* const target) {
+  bool polarity{true};
+  const Formula* g{&f};
+  while (is_negation(*g)) {
+    polarity = !polarity;
+    g = &get_operand(*g);
+  }
+  if (!is_relational(*g)) {
+    ostringstream oss;
+    oss << "ContractorIbexSharedFwdbwd: Unsupported formula " << f << ".";
+    throw DREAL_RUNTIME_ERROR(oss.str());
+  }
+  constexpr double inf{numeric_limits<double>::infinity()};
+  if (is_equal_to(*g) || is_not_equal_to(*g)) {
+    if (polarity != is_equal_to(*g)) {
+      return false;
+    }
+    *target = Box::Interval{0.0};
+  } else if (is_greater_than(*g) || is_greater_than_or_equal_to(*g)) {
+    *target = polarity ? Box::Interval(0.0, inf) : Box::Interval(-inf, 0.0);
+  } else {
+    // e₁ < e₂ or e₁ ≤ e₂.
+    *target = polarity ? Box::Interval(-inf, 0.0) : Box::Interval(0.0, inf);
+  }
+  *atom = *g;
+  return true;
+}
+}  // namespace
+
+//---------------------------------------------
+// Implementation of ContractorIbexSharedFwdbwd
+//---------------------------------------------
+ContractorIbexSharedFwdbwd::ContractorIbexSharedFwdbwd(vector<Formula> formulas,
+                                                       const Box& box)
+    : ContractorIbexSharedFwdbwd{move(formulas), set<Formula>{}, box} {}
+
+ContractorIbexSharedFwdbwd::ContractorIbexSharedFwdbwd(
+    vector<Formula> formulas, const set<Formula>& atoms, const Box& box)
+    : ContractorCell{Contractor::Kind::IBEX_SHARED_FWDBWD,
+                     ibex::BitSet::empty(box.size())},
+      formulas_{move(formulas)},
+      target_{1 /* Will be overwritten anyway */},
+      iv_{1 /* Will be overwritten anyway */},
+      old_iv_{1 /* Will be overwritten anyway */} {
+  // Atom → the interval which its `lhs - rhs` should be in. The function
+  // has an output for each atom, in the order of the atoms.
+  constexpr double inf{numeric_limits<double>::infinity()};
+  map<Formula, Box::Interval> targets;
+  for (const Formula& atom : atoms) {
+    targets.emplace(atom, Box::Interval(-inf, inf));
+  }
+  bool prunes{false};
+  Formula atom;
+  Box::Interval target;
+  for (const Formula& f : formulas_) {
+    if (!Decompose(f, &atom, &target)) {
+      continue;
+    }
+    prunes = true;
+    const auto it = targets.find(atom);
+    if (it == targets.end()) {
+      targets.emplace(atom, target);
+    } else {
+      // Both of `p` and `¬p` may be given.
+      it->second &= target;
+    }
+  }
+  // Build input.
+  ibex::BitSet& input{mutable_input()};
+  for (const auto& p : targets) {
+    for (const Variable& var : p.first.GetFreeVariables()) {
+      const int idx{box.index(var)};
+      if (!input[idx]) {
+        input.add(idx);
+        indices_.push_back(idx);
+      }
+    }
+  }
+  std::sort(indices_.begin(), indices_.end());
+  for (const int idx : indices_) {
+    variables_.push_back(box.variable(idx));
+  }
+  if (!prunes) {
+    return;
+  }
+  set<Formula> all_atoms;
+  target_.resize(static_cast<int>(targets.size()));
+  int i{0};
+  for (const auto& p : targets) {
+    all_atoms.insert(all_atoms.end(), p.first);
+    target_[i++] = p.second;
+  }
+  // Build function_ and ctc_.
+  const shared_ptr<const CompiledIbexConstraint> compiled{
+      IbexConstraintCache::Global().GetShared(all_atoms, variables_)};
+  function_.reset(new ibex::Function{*compiled->function});
+  BuildCtc();
+  iv_.resize(indices_.size());
+}
+
+ContractorIbexSharedFwdbwd::ContractorIbexSharedFwdbwd(
+    const ContractorIbexSharedFwdbwd& other)
+    : ContractorCell{Contractor::Kind::IBEX_SHARED_FWDBWD, other.input()},
+      formulas_{other.formulas_},
+      target_{other.target_},
+      variables_{other.variables_},
+      indices_{other.indices_},
+      iv_{other.iv_},
+      old_iv_{1 /* Will be overwritten anyway */} {
+  if (other.function_) {
+    function_.reset(new ibex::Function{*other.function_});
+    BuildCtc();
+  }
+}
+
+void ContractorIbexSharedFwdbwd::BuildCtc() {
+  if (target_.size() == 1) {
+    // A function with a single output is scalar-valued.
+    ctc_.reset(new ibex::CtcFwdBwd{*function_, target_[0]});
+  } else {
+    ctc_.reset(new ibex::CtcFwdBwd{*function_, target_});
+  }
+}
+
+void ContractorIbexSharedFwdbwd::Prune(ContractorStatus* cs) const {
+  static ContractorIbexSharedFwdbwdStat stat;
+  if (ctc_) {
+    Box::IntervalVector& iv{cs->mutable_box().mutable_interval_vector()};
+    // Gather the sub-vector over variables_.
+    for (size_t i = 0; i < indices_.size(); ++i) {
+      iv_[i] = iv[indices_[i]];
+    }
+    old_iv_ = iv_;
+    DREAL_LOG_TRACE("ContractorIbexSharedFwdbwd::Prune");
+    ctc_->contract(iv_);
+    stat.num_pruning_++;
+    bool changed{false};
+    // Scatter the changed dimensions back and update output. The output
+    // of ctc_ is indexed by the position in variables_.
+    if (iv_.is_empty()) {
+      changed = true;
+      cs->mutable_box().set_empty();
+      cs->mutable_output().fill(0, cs->box().size() - 1);
+    } else {
+      for (int i = 0, idx = ctc_->output->min(); i < ctc_->output->size();
+           ++i, idx = ctc_->output->next(idx)) {
+        if (old_iv_[idx] != iv_[idx]) {
+          iv[indices_[idx]] = iv_[idx];
+          cs->AddOutput(indices_[idx], old_iv_[idx]);
+          changed = true;
+        }
+      }
+    }
+    // Update used constraints. We do not know which of the constraints
+    // contributed to the pruning, so we add all of them.
+    if (changed) {
+      cs->AddUsedConstraint(formulas_);
+    } else {
+      stat.num_zero_effect_pruning_++;
+      DREAL_LOG_TRACE("NO CHANGE");
+    }
+  }
+}
+
+shared_ptr<ContractorCell> ContractorIbexSharedFwdbwd::Clone() const {
+  return shared_ptr<ContractorCell>{new ContractorIbexSharedFwdbwd{*this}};
+}
+
+ostream& ContractorIbexSharedFwdbwd::display(ostream& os) const {
+  os << "IbexSharedFwdbwd(";
+  for (const Formula& f : formulas_) {
+    os << f << ";";
+  }
+  return os << ")";
+}
+
+}  // namespace dreal
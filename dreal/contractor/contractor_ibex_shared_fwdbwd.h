@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>
+#include <ostream>
+#include <set>
+#include <vector>
+
+#include "./ibex.h"
+
+#include "dreal/contractor/contractor.h"
+#include "dreal/contractor/contractor_cell.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+
+/// Contractor class running IBEX's forward/backward contractor over
+/// multiple constraints at once.
+///
+/// It converts the constraints into a single IBEX function whose i-th
+/// output is `lhs - rhs` of the i-th constraint. The equal subexpressions
+/// of the constraints are converted into the same node. So a pruning
+/// evaluates a shared subexpression once in the forward sweep, and the
+/// backward sweep narrows it by all the constraints using it before
+/// projecting it onto the variables.
+///
+/// As ContractorIbexFwdbwd, the function is compiled over the free
+/// variables of the constraints only and taken from
+/// IbexConstraintCache::Global(). A pruning gathers their intervals from
+/// a box, contracts them, and scatters back the changed ones.
+class ContractorIbexSharedFwdbwd : public ContractorCell {
+ public:
+  /// Deleted default constructor.
+  ContractorIbexSharedFwdbwd() = delete;
+
+  /// Constructs IbexSharedFwdbwd contractor using @p formulas and @p box.
+  /// A formula in @p formulas should be a relational formula or its
+  /// negation. It ignores the formulas which do not prune a box, such as
+  /// `e₁ ≠ e₂`.
+  ContractorIbexSharedFwdbwd(std::vector<Formula> formulas, const Box& box);
+
+  /// Constructs IbexSharedFwdbwd contractor using @p formulas and @p box,
+  /// whose function has an output for each relational formula in
+  /// @p atoms, which should include the atoms of @p formulas. The target
+  /// of an output is (-∞, ∞) unless its atom is in @p formulas. So the
+  /// contractors of the different subsets of the formulas over @p atoms
+  /// share the compiled function.
+  ///
+  /// @note An output of an atom which is not in @p formulas can still
+  /// prune a box if its expression is not defined everywhere, e.g.
+  /// `log(x)`. The caller should not include such an atom.
+  ContractorIbexSharedFwdbwd(std::vector<Formula> formulas,
+                             const std::set<Formula>& atoms, const Box& box);
+
+  ~ContractorIbexSharedFwdbwd() override = default;
+
+  void Prune(ContractorStatus* cs) const override;
+
+  /// Returns a clone of this contractor. The clone owns a copy of the
+  /// function instead of converting the formulas again.
+  std::shared_ptr<ContractorCell> Clone() const override;
+
+  std::ostream& display(std::ostream& os) const override;
+
+ private:
+  // Constructs a clone of @p other. See Clone().
+  ContractorIbexSharedFwdbwd(const ContractorIbexSharedFwdbwd& other);
+
+  // Builds ctc_ from function_ and target_.
+  void BuildCtc();
+
+  const std::vector<Formula> formulas_;
+  // target_[i] is the interval which the i-th output of function_ should
+  // be in.
+  Box::IntervalVector target_;
+  // A copy of the function in the compiled constraint. See
+  // ContractorIbexFwdbwd.
+  std::unique_ptr<ibex::Function> function_;
+  std::unique_ptr<ibex::CtcFwdBwd> ctc_;
+
+  // The free variables of formulas_ ordered by their indices in the box,
+  // and the indices. The function is compiled over these variables.
+  std::vector<Variable> variables_;
+  std::vector<int> indices_;
+
+  // Temporary storage to store the sub-vector of a box over variables_,
+  // before and after pruning.
+  mutable Box::IntervalVector iv_;
+  mutable Box::IntervalVector old_iv_;
+};
+
+}  // namespace dreal
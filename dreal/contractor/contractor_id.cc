@@ -1,6 +1,8 @@
 #include "dreal/contractor/contractor_id.h"
 
+using std::make_shared;
 using std::ostream;
+using std::shared_ptr;
 
 namespace dreal {
 ContractorId::ContractorId()
@@ -10,6 +12,10 @@ ContractorId::ContractorId()
 void ContractorId::Prune(ContractorStatus*) const {
   // No op.
 }
+shared_ptr<ContractorCell> ContractorId::Clone() const {
+  return make_shared<ContractorId>();
+}
+
 ostream& ContractorId::display(ostream& os) const { return os << "ID()"; }
 
 }  // namespace dreal
@@ -13,6 +13,7 @@ class ContractorId : public ContractorCell {
   ~ContractorId() override = default;
 
   void Prune(ContractorStatus* cs) const override;
+  std::shared_ptr<ContractorCell> Clone() const override;
   std::ostream& display(std::ostream& os) const override;
 };
 }  // namespace dreal
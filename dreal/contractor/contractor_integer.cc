@@ -6,6 +6,7 @@
 #include "dreal/util/math.h"
 
 using std::ostream;
+using std::shared_ptr;
 
 namespace dreal {
 
@@ -23,6 +24,10 @@ ContractorInteger::ContractorInteger(const Box& box)
   DREAL_ASSERT(!int_indexes_.empty());
 }
 
+ContractorInteger::ContractorInteger(const ContractorInteger& other)
+    : ContractorCell{Contractor::Kind::INTEGER, other.input()},
+      int_indexes_{other.int_indexes_} {}
+
 void ContractorInteger::Prune(ContractorStatus* contractor_status) const {
   Box& box{contractor_status->mutable_box()};
   for (const int idx : int_indexes_) {
@@ -34,8 +39,8 @@ void ContractorInteger::Prune(ContractorStatus* contractor_status) const {
       const double new_lb{std::ceil(iv.lb())};
       const double new_ub{std::floor(iv.ub())};
       if (new_lb <= new_ub) {
+        contractor_status->AddOutput(idx, iv);
         iv = Box::Interval{new_lb, new_ub};
-        contractor_status->mutable_output().add(idx);
       } else {
         // [new_lb, new_ub] = empty
         box.set_empty();
@@ -47,6 +52,10 @@ void ContractorInteger::Prune(ContractorStatus* contractor_status) const {
   }
 }
 
+shared_ptr<ContractorCell> ContractorInteger::Clone() const {
+  return shared_ptr<ContractorCell>{new ContractorInteger{*this}};
+}
+
 ostream& ContractorInteger::display(ostream& os) const {
   return os << "Integer()";
 }
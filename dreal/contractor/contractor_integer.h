@@ -21,9 +21,13 @@ class ContractorInteger : public ContractorCell {
   ~ContractorInteger() override = default;
 
   void Prune(ContractorStatus* cs) const override;
+  std::shared_ptr<ContractorCell> Clone() const override;
   std::ostream& display(std::ostream& os) const override;
 
  private:
+  // Constructs a clone of @p other. See Clone().
+  ContractorInteger(const ContractorInteger& other);
+
   std::vector<int> int_indexes_;
 };
 }  // namespace dreal
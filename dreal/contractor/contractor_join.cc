@@ -3,8 +3,10 @@
 #include <utility>
 #include "dreal/util/assert.h"
 
+using std::make_shared;
 using std::move;
 using std::ostream;
+using std::shared_ptr;
 using std::vector;
 
 namespace dreal {
@@ -30,6 +32,10 @@ void ContractorJoin::Prune(ContractorStatus* cs) const {
   }
 }
 
+shared_ptr<ContractorCell> ContractorJoin::Clone() const {
+  return make_shared<ContractorJoin>(CloneContractors(contractors_));
+}
+
 ostream& ContractorJoin::display(ostream& os) const {
   os << "Join(";
   for (const Contractor& c : contractors_) {
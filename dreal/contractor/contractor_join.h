@@ -22,6 +22,7 @@ class ContractorJoin : public ContractorCell {
   ~ContractorJoin() override = default;
 
   void Prune(ContractorStatus* cs) const override;
+  std::shared_ptr<ContractorCell> Clone() const override;
   std::ostream& display(std::ostream& os) const override;
 
  private:
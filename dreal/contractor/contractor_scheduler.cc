@@ -0,0 +1,242 @@
+#include "dreal/contractor/contractor_scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "dreal/util/assert.h"
+#include "dreal/util/logging.h"
+
+namespace dreal {
+
+using std::atomic;
+using std::cout;
+using std::min;
+using std::numeric_limits;
+using std::vector;
+
+namespace {
+// Weight of a new sample in the running averages.
+constexpr double kAlpha{0.125};
+// A contractor is suspended after this number of prunings with no effect
+// in a row.
+constexpr int kMaxNoEffectsInRow{3};
+// Maximum number of calls of a fixpoint contractor for which a contractor
+// is suspended.
+constexpr int kMaxSuspensionLength{64};
+
+// A class to show statistics information at destruction.
+class ContractorSchedulerStat {
+ public:
+  ContractorSchedulerStat() = default;
+  ~ContractorSchedulerStat() {
+    if (DREAL_LOG_INFO_ENABLED && num_suspension_ > 0) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Suspension",
+            "Scheduler level", num_suspension_.load());
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Skipped pruning",
+            "Scheduler level", num_skipped_pruning_.load());
+    }
+  }
+  atomic<int> num_suspension_{0};
+  atomic<int> num_skipped_pruning_{0};
+};
+
+ContractorSchedulerStat& GetStat() {
+  static ContractorSchedulerStat stat;
+  return stat;
+}
+
+void UpdateAverage(const double sample, double* const average) {
+  *average += kAlpha * (sample - *average);
+}
+
+// Returns the relative width reduction from @p old_width to @p new_width.
+double RelativeReduction(const double old_width, const double new_width) {
+  if (old_width == new_width || old_width <= 0.0) {
+    return 0.0;
+  }
+  if (std::isinf(old_width)) {
+    return std::isinf(new_width) ? 0.0 : 1.0;
+  }
+  return (old_width - new_width) / old_width;
+}
+}  // namespace
+
+ContractorScheduler::ContractorScheduler(const vector<Contractor>& contractors)
+    : stats_(contractors.size()), queued_(contractors.size(), false) {
+  for (size_t i = 0; i < contractors.size(); ++i) {
+    switch (contractors[i].kind()) {
+      case Contractor::Kind::ID:
+      case Contractor::Kind::IBEX_FWDBWD:
+      case Contractor::Kind::IBEX_SHARED_FWDBWD:
+        break;
+      case Contractor::Kind::INTEGER:
+        stats_[i].suspendable = false;
+        break;
+      default:
+        stats_[i].expensive = true;
+    }
+  }
+}
+
+void ContractorScheduler::StartPruning() { ++calls_; }
+
+void ContractorScheduler::Schedule(vector<int>* const cheap,
+                                   vector<int>* const expensive) const {
+  cheap->clear();
+  expensive->clear();
+  for (int i = 0; i < static_cast<int>(stats_.size()); ++i) {
+    if (is_suspended(i)) {
+      GetStat().num_skipped_pruning_++;
+      continue;
+    }
+    (stats_[i].expensive ? expensive : cheap)->push_back(i);
+  }
+  const auto higher_priority = [this](const int i, const int j) {
+    return priority(i) > priority(j);
+  };
+  std::stable_sort(cheap->begin(), cheap->end(), higher_priority);
+  std::stable_sort(expensive->begin(), expensive->end(), higher_priority);
+}
+
+void ContractorScheduler::Enqueue(const int i) {
+  if (queued_[i]) {
+    return;
+  }
+  queued_[i] = true;
+  ++queue_size_;
+  vector<QueueEntry>& heap{stats_[i].expensive ? expensive_queue_
+                                                : cheap_queue_};
+  heap.push_back(QueueEntry{priority(i), i});
+  std::push_heap(heap.begin(), heap.end(), LowerPriority);
+}
+
+int ContractorScheduler::Dequeue() {
+  while (queue_size_ > 0) {
+    const int i{PopHeap(cheap_queue_.empty() ? &expensive_queue_
+                                             : &cheap_queue_)};
+    if (is_suspended(i)) {
+      GetStat().num_skipped_pruning_++;
+      continue;
+    }
+    return i;
+  }
+  return -1;
+}
+
+bool ContractorScheduler::LowerPriority(const QueueEntry& e1,
+                                        const QueueEntry& e2) {
+  return e1.priority < e2.priority ||
+         (e1.priority == e2.priority && e1.index > e2.index);
+}
+
+int ContractorScheduler::PopHeap(vector<QueueEntry>* const heap) {
+  std::pop_heap(heap->begin(), heap->end(), LowerPriority);
+  const int i{heap->back().index};
+  heap->pop_back();
+  queued_[i] = false;
+  --queue_size_;
+  return i;
+}
+
+void ContractorScheduler::ClearQueue() {
+  for (const QueueEntry& entry : cheap_queue_) {
+    queued_[entry.index] = false;
+  }
+  for (const QueueEntry& entry : expensive_queue_) {
+    queued_[entry.index] = false;
+  }
+  cheap_queue_.clear();
+  expensive_queue_.clear();
+  queue_size_ = 0;
+}
+
+bool ContractorScheduler::Prune(const int i, const Contractor& contractor,
+                                ContractorStatus* const cs) {
+  Statistics& stat{stats_[i]};
+  const ibex::BitSet& input{contractor.input()};
+  Box& box{cs->mutable_box()};
+  old_widths_.clear();
+  if (!input.empty()) {
+    for (int j = 0, dim = input.min(); j < input.size();
+         ++j, dim = input.next(dim)) {
+      old_widths_.push_back(box[dim].diam());
+    }
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  contractor.Prune(cs);
+  const auto end = std::chrono::steady_clock::now();
+
+  bool changed{false};
+  double reduction{0.0};
+  if (box.empty()) {
+    changed = true;
+    reduction = 1.0;
+  } else if (!input.empty()) {
+    for (int j = 0, dim = input.min(); j < input.size();
+         ++j, dim = input.next(dim)) {
+      const double r{RelativeReduction(old_widths_[j], box[dim].diam())};
+      if (r > 0.0) {
+        changed = true;
+        reduction += r;
+      }
+    }
+    reduction /= input.size();
+  }
+
+  const double cost{static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+          .count())};
+  if (stat.num_calls == 0) {
+    stat.cost = cost;
+    stat.success_rate = changed ? 1.0 : 0.0;
+    stat.width_reduction = reduction;
+  } else {
+    UpdateAverage(cost, &stat.cost);
+    UpdateAverage(changed ? 1.0 : 0.0, &stat.success_rate);
+    UpdateAverage(reduction, &stat.width_reduction);
+  }
+  ++stat.num_calls;
+
+  if (changed) {
+    stat.num_no_effects_in_row = 0;
+    stat.suspension_length = 1;
+  } else if (stat.suspendable &&
+             ++stat.num_no_effects_in_row >= kMaxNoEffectsInRow) {
+    DREAL_LOG_TRACE("ContractorScheduler::Prune: Suspend {} for {} calls",
+                    contractor, stat.suspension_length);
+    stat.suspended_until = calls_ + stat.suspension_length;
+    stat.suspension_length =
+        min(2 * stat.suspension_length, kMaxSuspensionLength);
+    stat.num_no_effects_in_row = 0;
+    GetStat().num_suspension_++;
+  }
+  return changed;
+}
+
+double ContractorScheduler::priority(const int i) const {
+  const Statistics& stat{stats_[i]};
+  if (stat.num_calls == 0) {
+    return numeric_limits<double>::infinity();
+  }
+  // A small constant keeps the contractors which have not been effective
+  // recently ordered by their costs.
+  const double expected_gain{stat.success_rate * stat.width_reduction +
+                             1e-6};
+  return expected_gain / std::max(stat.cost, 1.0);
+}
+
+bool ContractorScheduler::is_expensive(const int i) const {
+  return stats_[i].expensive;
+}
+
+bool ContractorScheduler::is_suspended(const int i) const {
+  return calls_ < stats_[i].suspended_until;
+}
+
+}  // namespace dreal
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "dreal/contractor/contractor.h"
+#include "dreal/contractor/contractor_status.h"
+
+namespace dreal {
+
+/// Schedules the contractors of a fixpoint contractor by their measured
+/// effectiveness.
+///
+/// For each contractor, it keeps running averages of the cost of a pruning
+/// in nanoseconds, of how often a pruning shrinks the box, and of the
+/// relative width reduction of the input dimensions. The priority of a
+/// contractor is its expected reduction per nanosecond.
+///
+/// A contractor which has had no effect several times in a row is
+/// suspended for the next few calls of the fixpoint contractor. The
+/// suspension doubles each time it happens again. The integer contractor
+/// is never suspended since the ICP relies on it to keep the integer
+/// variables integral.
+///
+/// The contractors other than the (shared) forward/backward, the integer,
+/// and the identity contractors (e.g. polytope, forall) are considered
+/// expensive.
+/// The fixpoint contractors only run them when the cheap ones have
+/// stalled.
+class ContractorScheduler {
+ public:
+  /// Constructs a scheduler for @p contractors.
+  explicit ContractorScheduler(const std::vector<Contractor>& contractors);
+
+  /// Starts a call of the fixpoint contractor. It resumes the contractors
+  /// whose suspensions are over.
+  void StartPruning();
+
+  /// Returns the cheap and expensive contractors which are not suspended,
+  /// in descending order of their priorities.
+  void Schedule(std::vector<int>* cheap, std::vector<int>* expensive) const;
+
+  /// Adds the @p i -th contractor to the queue of the contractors to run,
+  /// unless it is already in the queue. It takes O(log m) time where m is
+  /// the number of contractors.
+  ///
+  /// The priority of a contractor only changes when it runs, that is after
+  /// it leaves the queue. So the queue orders the contractors by their
+  /// priorities at the time they are added.
+  void Enqueue(int i);
+
+  /// Removes the contractor with the highest priority from the queue and
+  /// returns it. It prefers a cheap contractor to an expensive one. It
+  /// drops the suspended contractors from the queue. Returns -1 if there is
+  /// no contractor to run.
+  int Dequeue();
+
+  /// Removes all the contractors from the queue.
+  void ClearQueue();
+
+  /// Returns the number of contractors in the queue.
+  int queue_size() const { return queue_size_; }
+
+  /// Prunes @p cs with @p contractor, which is the @p i -th contractor,
+  /// and updates its statistics. Returns true if it changes the box.
+  bool Prune(int i, const Contractor& contractor, ContractorStatus* cs);
+
+  /// Returns the priority of the @p i -th contractor. A contractor which
+  /// has not run yet has the highest priority.
+  double priority(int i) const;
+
+  /// Returns true if the @p i -th contractor is expensive.
+  bool is_expensive(int i) const;
+
+  /// Returns true if the @p i -th contractor is suspended.
+  bool is_suspended(int i) const;
+
+ private:
+  struct Statistics {
+    bool expensive{false};
+    bool suspendable{true};
+    int64_t num_calls{0};
+    double cost{0.0};            // Average cost in nanoseconds.
+    double success_rate{0.0};    // Average of 1 (shrink) and 0 (no effect).
+    double width_reduction{0.0};  // Average relative width reduction.
+    int num_no_effects_in_row{0};
+    int suspension_length{1};
+    int64_t suspended_until{0};  // Suspended while `calls_ < suspended_until`.
+  };
+
+  // An entry of the queue. The priority is the one at the time it is
+  // added.
+  struct QueueEntry {
+    double priority;
+    int index;
+  };
+
+  // Orders the queue entries by their priorities. Among the entries of the
+  // same priority, the one with the smallest index comes first.
+  static bool LowerPriority(const QueueEntry& e1, const QueueEntry& e2);
+
+  // Pops the entry with the highest priority from @p heap, a max-heap of
+  // the queue entries.
+  int PopHeap(std::vector<QueueEntry>* heap);
+
+  std::vector<Statistics> stats_;
+  // Max-heaps of the cheap and the expensive contractors in the queue.
+  std::vector<QueueEntry> cheap_queue_;
+  std::vector<QueueEntry> expensive_queue_;
+  // `queued_[i]` is true if the i-th contractor is in the queue.
+  std::vector<bool> queued_;
+  int queue_size_{0};
+  // The number of calls of StartPruning().
+  int64_t calls_{0};
+  // Widths of the input dimensions of a contractor before a pruning. It is
+  // reused to avoid allocations.
+  std::vector<double> old_widths_;
+};
+
+}  // namespace dreal
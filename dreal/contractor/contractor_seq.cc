@@ -4,8 +4,10 @@
 
 #include "dreal/util/assert.h"
 
+using std::make_shared;
 using std::move;
 using std::ostream;
+using std::shared_ptr;
 using std::vector;
 
 namespace dreal {
@@ -31,6 +33,10 @@ void ContractorSeq::Prune(ContractorStatus* cs) const {
   return;
 }
 
+shared_ptr<ContractorCell> ContractorSeq::Clone() const {
+  return make_shared<ContractorSeq>(CloneContractors(contractors_));
+}
+
 ostream& ContractorSeq::display(ostream& os) const {
   os << "Seq(";
   for (const Contractor& c : contractors_) {
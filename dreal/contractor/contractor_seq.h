@@ -21,6 +21,7 @@ class ContractorSeq : public ContractorCell {
   ~ContractorSeq() override = default;
 
   void Prune(ContractorStatus* cs) const override;
+  std::shared_ptr<ContractorCell> Clone() const override;
   std::ostream& display(std::ostream& os) const override;
 
   const std::vector<Contractor>& contractors() const;
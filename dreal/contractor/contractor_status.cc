@@ -1,10 +1,18 @@
 #include "dreal/contractor/contractor_status.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <utility>
 
 #include "dreal/util/assert.h"
 
+using std::abs;
+using std::experimental::nullopt;
+using std::experimental::optional;
+using std::max;
 using std::move;
+using std::numeric_limits;
 using std::unordered_set;
 using std::vector;
 
@@ -13,7 +21,8 @@ namespace dreal {
 ContractorStatus::ContractorStatus(Box box, const int branching_point)
     : box_{move(box)},
       branching_point_{branching_point},
-      output_{ibex::BitSet::empty(box_.size())} {
+      output_{ibex::BitSet::empty(box_.size())},
+      output_recorded_{ibex::BitSet::empty(box_.size())} {
   DREAL_ASSERT(box_.size() > 0);
   DREAL_ASSERT(branching_point_ >= -1 && branching_point_ < box_.size());
 }
@@ -30,6 +39,58 @@ const ibex::BitSet& ContractorStatus::output() const { return output_; }
 
 ibex::BitSet& ContractorStatus::mutable_output() { return output_; }
 
+void ContractorStatus::AddOutput(const int i,
+                                 const Box::Interval& old_interval) {
+  if (output_.contain(i)) {
+    // Keep the first old interval, if any.
+    return;
+  }
+  output_.add(i);
+  if (output_old_intervals_.empty()) {
+    output_old_intervals_.resize(box_.size());
+  }
+  output_old_intervals_[i] = old_interval;
+  output_recorded_.add(i);
+}
+
+double ContractorStatus::output_change(const int i) const {
+  if (!output_.contain(i) || !output_recorded_.contain(i)) {
+    return numeric_limits<double>::infinity();
+  }
+  return RelativeChange(output_old_intervals_[i], box_[i]);
+}
+
+optional<Box::Interval> ContractorStatus::output_old_interval(
+    const int i) const {
+  if (!output_.contain(i) || !output_recorded_.contain(i)) {
+    return nullopt;
+  }
+  return output_old_intervals_[i];
+}
+
+void ContractorStatus::ClearOutput() {
+  output_.clear();
+  output_recorded_.clear();
+}
+
+bool ContractorStatus::is_entailed(const int i) const {
+  return i < static_cast<int>(entailed_.size()) && entailed_[i];
+}
+
+const vector<bool>& ContractorStatus::entailed() const { return entailed_; }
+
+vector<bool>& ContractorStatus::mutable_entailed() { return entailed_; }
+
+const unordered_set<Formula, hash_value<Formula>>&
+ContractorStatus::used_constraints() const {
+  return used_constraints_;
+}
+
+const unordered_set<Formula, hash_value<Formula>>&
+ContractorStatus::unsat_witness() const {
+  return unsat_witness_;
+}
+
 void ContractorStatus::AddUsedConstraint(const Formula& f) {
   if (box_.empty()) {
     unsat_witness_.insert(f);
@@ -74,15 +135,45 @@ unordered_set<Formula, hash_value<Formula>> ContractorStatus::Explanation()
   return GenerateExplanation(unsat_witness_, used_constraints_);
 }
 
+void ContractorStatus::ClearExplanation() {
+  used_constraints_.clear();
+  unsat_witness_.clear();
+}
+
 ContractorStatus& ContractorStatus::InplaceJoin(
     const ContractorStatus& contractor_status) {
   box_.InplaceUnion(contractor_status.box());
+  // The sizes of the changes do not survive a join.
+  output_recorded_.clear();
   output_ |= contractor_status.output();
   used_constraints_.insert(contractor_status.used_constraints_.begin(),
                            contractor_status.used_constraints_.end());
   return *this;
 }
 
+ContractorStatus& ContractorStatus::InplaceMergeExplanation(
+    const ContractorStatus& contractor_status) {
+  used_constraints_.insert(contractor_status.used_constraints_.begin(),
+                           contractor_status.used_constraints_.end());
+  unsat_witness_.insert(contractor_status.unsat_witness_.begin(),
+                        contractor_status.unsat_witness_.end());
+  return *this;
+}
+
+double RelativeChange(const Box::Interval& old_interval,
+                      const Box::Interval& new_interval) {
+  if (old_interval == new_interval) {
+    return 0.0;
+  }
+  const double width{old_interval.diam()};
+  if (new_interval.is_empty() || width == 0.0 || std::isinf(width)) {
+    return numeric_limits<double>::infinity();
+  }
+  return max(abs(new_interval.lb() - old_interval.lb()),
+             abs(old_interval.ub() - new_interval.ub())) /
+         width;
+}
+
 ContractorStatus Join(ContractorStatus contractor_status1,
                       const ContractorStatus& contractor_status2) {
   // This function updates `contractor_status1`, which is passed by value, and
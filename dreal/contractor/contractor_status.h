@@ -1,5 +1,6 @@
 #pragma once
 
+#include <experimental/optional>
 #include <unordered_set>
 #include <vector>
 
@@ -36,6 +37,47 @@ class ContractorStatus {
   /// Returns a mutable reference of the output field.
   ibex::BitSet& mutable_output();
 
+  /// Adds the @p i -th dimension into the output and records the size of
+  /// the change. @p old_interval is the @p i -th interval of the box
+  /// before the change. When the dimension is changed several times, the
+  /// first old interval since the last ClearOutput() is kept.
+  void AddOutput(int i, const Box::Interval& old_interval);
+
+  /// Returns the largest move of a bound of the @p i -th interval, relative
+  /// to the width of its old interval. See AddOutput(). It returns +∞ if
+  /// the size of the change is unknown, for example, when the dimension is
+  /// added via mutable_output() or the old interval is unbounded.
+  double output_change(int i) const;
+
+  /// Returns the @p i -th interval before the change if it is recorded by
+  /// AddOutput().
+  std::experimental::optional<Box::Interval> output_old_interval(int i) const;
+
+  /// Clears the output and the recorded changes.
+  void ClearOutput();
+
+  /// Returns true if the box entails the @p i -th constraint, that is, all
+  /// the points in the box satisfy it. The constraints are numbered by the
+  /// ICP which owns this contractor status. See Contractor::constraint_id().
+  bool is_entailed(int i) const;
+
+  /// Returns a const reference of the entailment flags.
+  const std::vector<bool>& entailed() const;
+
+  /// Returns a mutable reference of the entailment flags. It is empty
+  /// unless the owner of this contractor status tracks the entailment.
+  std::vector<bool>& mutable_entailed();
+
+  /// Returns the constraints used during pruning processes. The box is
+  /// pruned by these constraints (and the initial box).
+  const std::unordered_set<Formula, hash_value<Formula>>& used_constraints()
+      const;
+
+  /// Returns the constraints directly responsible for the emptiness of
+  /// the box.
+  const std::unordered_set<Formula, hash_value<Formula>>& unsat_witness()
+      const;
+
   /// Returns explanation, a list of formula responsible for the unsat.
   std::unordered_set<Formula, hash_value<Formula>> Explanation() const;
 
@@ -45,12 +87,23 @@ class ContractorStatus {
   /// Add a formula @p formulas into the used constraints.
   void AddUsedConstraint(const std::vector<Formula>& formulas);
 
+  /// Removes the used constraints and the unsat witnesses. It is used to
+  /// collect the constraints used by a single pruning step.
+  void ClearExplanation();
+
   /// Updates the contractor status by taking join with @p contractor_status.
   ///
   /// @pre The boxes of this and @p contractor_status have the same variables
   /// vector.
   ContractorStatus& InplaceJoin(const ContractorStatus& contractor_status);
 
+  /// Adds the used constraints and the unsat witnesses of @p
+  /// contractor_status into this. It is used to combine the explanations
+  /// from contractor statuses which explored disjoint parts of a
+  /// search space.
+  ContractorStatus& InplaceMergeExplanation(
+      const ContractorStatus& contractor_status);
+
  private:
   // The current box to prune. Most of contractors are updating
   // this member.
@@ -67,6 +120,17 @@ class ContractorStatus {
   // changed after running the contractor.
   ibex::BitSet output_;
 
+  // "output_recorded_[i] == 1" means that output_old_intervals_[i] holds
+  // the i-th interval before it is changed. See AddOutput().
+  ibex::BitSet output_recorded_;
+
+  // It is allocated by the first call of AddOutput().
+  std::vector<Box::Interval> output_old_intervals_;
+
+  // "entailed_[i] == true" means that the box entails the i-th
+  // constraint. Sub-boxes inherit it.
+  std::vector<bool> entailed_;
+
   // A set of constraints used during pruning processes. This is an
   // over-approximation of an explanation.
   std::unordered_set<Formula, hash_value<Formula>> used_constraints_;
@@ -76,6 +140,13 @@ class ContractorStatus {
   std::unordered_set<Formula, hash_value<Formula>> unsat_witness_;
 };
 
+/// Returns the largest move of a bound from @p old_interval to @p
+/// new_interval, relative to the width of @p old_interval. Unless the two
+/// intervals are the same, it returns +∞ if @p old_interval is unbounded
+/// or a point, or if @p new_interval is empty.
+double RelativeChange(const Box::Interval& old_interval,
+                      const Box::Interval& new_interval);
+
 /// Returns a join of @p contractor_status1 and @p contractor_status2.
 ///
 /// @pre The boxes of the two ContractorStatus should have the same variables
@@ -1,16 +1,23 @@
 #include "dreal/contractor/contractor_worklist_fixpoint.h"
 
 #include <algorithm>  // To suppress cpplint
+#include <atomic>
 #include <cmath>
+#include <iostream>
 #include <queue>
 #include <utility>
 
 #include "dreal/util/assert.h"
 #include "dreal/util/logging.h"
 
+using std::atomic;
+using std::cout;
+using std::experimental::optional;
+using std::make_shared;
 using std::move;
 using std::ostream;
 using std::queue;
+using std::shared_ptr;
 using std::unordered_set;
 using std::vector;
 
@@ -18,45 +25,79 @@ namespace dreal {
 
 namespace {
 
-void UpdateWorklist(const ibex::BitSet& output,
-                    const vector<ibex::BitSet>& input_to_contractors,
-                    ibex::BitSet* const worklist) {
-  for (int j = 0, changed_dim = output.min(); j < output.size();
-       ++j, changed_dim = output.next(changed_dim)) {
-    *worklist |= input_to_contractors[changed_dim];
+// A class to show statistics information at destruction.
+class ContractorWorklistFixpointStat {
+ public:
+  ContractorWorklistFixpointStat() = default;
+  ~ContractorWorklistFixpointStat() {
+    if (DREAL_LOG_INFO_ENABLED && num_suppressed_propagation_ > 0) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of Suppressed propagation", "Worklist level",
+            num_suppressed_propagation_.load());
+    }
   }
+  atomic<int> num_suppressed_propagation_{0};
+};
+
+ContractorWorklistFixpointStat& GetStat() {
+  static ContractorWorklistFixpointStat stat;
+  return stat;
 }
 }  // namespace
 
 ContractorWorklistFixpoint::ContractorWorklistFixpoint(
-    TerminationCondition term_cond, vector<Contractor> contractors)
+    TerminationCondition term_cond, vector<Contractor> contractors,
+    const bool use_scheduler, const double propagation_threshold)
     : ContractorCell{Contractor::Kind::WORKLIST_FIXPOINT,
                      ibex::BitSet::empty(ComputeInputSize(contractors))},
       term_cond_{move(term_cond)},
       contractors_{move(contractors)},
-      input_to_contractors_{static_cast<size_t>(ComputeInputSize(contractors_)),
-                            ibex::BitSet::empty(contractors_.size())},
+      propagation_threshold_{propagation_threshold},
+      scheduler_{use_scheduler ? new ContractorScheduler{contractors_}
+                               : nullptr},
       worklist_{ibex::BitSet::empty(contractors_.size())},
-      old_iv_{1 /* It will be updated anyway. */} {
+      round_old_iv_{1 /* It will be updated anyway. */},
+      round_new_iv_{1 /* It will be updated anyway. */} {
   DREAL_ASSERT(contractors_.size() > 0);
+  DREAL_ASSERT(propagation_threshold_ >= 0.0);
   // Setup the input member.
   ibex::BitSet& input{mutable_input()};
   for (const Contractor& ctc : contractors_) {
     input |= ctc.input();
   }
 
-  // Setup input_to_contractors_.
-  if (!input.empty()) {
-    for (int i = 0; i <= input.max(); ++i) {
-      for (size_t j = 0; j < contractors_.size(); ++j) {
-        if (contractors_[j].input()[i]) {
-          input_to_contractors_[i].add(j);
-        }
-      }
+  // Setup input_to_contractors_. It visits the input dimensions of each
+  // contractor, so it takes time proportional to the total size of the
+  // inputs rather than to (# of dimensions) × (# of contractors).
+  auto input_to_contractors = make_shared<vector<vector<int>>>(
+      static_cast<size_t>(ComputeInputSize(contractors_)));
+  for (size_t j = 0; j < contractors_.size(); ++j) {
+    const ibex::BitSet& ctc_input{contractors_[j].input()};
+    if (ctc_input.empty()) {
+      continue;
+    }
+    for (int k = 0, i = ctc_input.min(); k < ctc_input.size();
+         ++k, i = ctc_input.next(i)) {
+      (*input_to_contractors)[i].push_back(j);
     }
   }
+  input_to_contractors_ = move(input_to_contractors);
 }
 
+ContractorWorklistFixpoint::ContractorWorklistFixpoint(
+    const ContractorWorklistFixpoint& other)
+    : ContractorCell{Contractor::Kind::WORKLIST_FIXPOINT, other.input()},
+      term_cond_{other.term_cond_},
+      contractors_{CloneContractors(other.contractors_)},
+      propagation_threshold_{other.propagation_threshold_},
+      input_to_contractors_{other.input_to_contractors_},
+      scheduler_{other.scheduler_ ? new ContractorScheduler{contractors_}
+                                  : nullptr},
+      worklist_{ibex::BitSet::empty(contractors_.size())},
+      round_old_iv_{1 /* It will be updated anyway. */},
+      round_new_iv_{1 /* It will be updated anyway. */} {}
+
 /**
 Q : list of contractors
 Ctc : list of all contractors
@@ -73,15 +114,20 @@ while ¬Q.empty() ∧ ¬TermCond(b, b'):
     b' : box ← ctc.prune(b)
     output : set of integers ← ctc.output()
     for i in output:
-        Q.push({ctc ∣ ctc ∈ Ctc ∧ i ∈ ctc.input()})
+        if i changed significantly:
+            Q.push({ctc ∣ ctc ∈ Ctc ∧ i ∈ ctc.input()})
 */
 void ContractorWorklistFixpoint::Prune(ContractorStatus* cs) const {
+  if (scheduler_) {
+    PruneWithScheduler(cs);
+    return;
+  }
   worklist_.clear();
+  StartPruning(cs->box().size());
   const int branching_point = cs->branching_point();
 
   // DREAL_LOG_ERROR("ContractorWorklistFixpoint::Prune -- Fill the Queue");
   // 1. Fill the queue.
-  old_iv_ = cs->box().interval_vector();
   if (branching_point < 0) {
     // No branching_point information specified, add all contractors.
     for (size_t ctc_idx = 0; ctc_idx < contractors_.size(); ++ctc_idx) {
@@ -89,43 +135,39 @@ void ContractorWorklistFixpoint::Prune(ContractorStatus* cs) const {
       // running UpdateWorklist() below. For now, it should be OK
       // since we do not call ContractorWorklistFixpoint::Prune()
       // recursively.
-      cs->mutable_output().clear();
+      cs->ClearOutput();
       contractors_[ctc_idx].Prune(cs);
       if (cs->box().empty()) {
         return;
       }
-      UpdateWorklist(cs->output(), input_to_contractors_, &worklist_);
+      UpdateWorklist(*cs);
     }
   } else {
-    const ibex::BitSet& contractors_to_check{
-        input_to_contractors_[branching_point]};
-    for (int i = 0, ctc_idx = contractors_to_check.min();
-         i < contractors_to_check.size();
-         ++i, ctc_idx = contractors_to_check.next(ctc_idx)) {
-      cs->mutable_output().clear();
+    for (const int ctc_idx : (*input_to_contractors_)[branching_point]) {
+      cs->ClearOutput();
       contractors_[ctc_idx].Prune(cs);
       if (cs->box().empty()) {
         return;
       }
-      UpdateWorklist(cs->output(), input_to_contractors_, &worklist_);
+      UpdateWorklist(*cs);
     }
   }
-  if (worklist_.empty() || term_cond_(old_iv_, cs->box().interval_vector())) {
+  if (worklist_.empty() || RoundTerminated(*cs)) {
     return;
   }
 
   // 2. Run worklist algorithm
   do {
     int ctc_idx = worklist_.min();
-    old_iv_ = cs->box().interval_vector();
+    StartRound();
     while (true) {
       worklist_.remove(ctc_idx);
-      cs->mutable_output().clear();
+      cs->ClearOutput();
       contractors_[ctc_idx].Prune(cs);
       if (cs->box().empty()) {
         return;
       }
-      UpdateWorklist(cs->output(), input_to_contractors_, &worklist_);
+      UpdateWorklist(*cs);
       if (worklist_.empty()) {
         return;
       }
@@ -134,7 +176,155 @@ void ContractorWorklistFixpoint::Prune(ContractorStatus* cs) const {
       }
       ctc_idx = worklist_.next(ctc_idx);
     }
-  } while (!term_cond_(old_iv_, cs->box().interval_vector()));
+  } while (!RoundTerminated(*cs));
+}
+
+void ContractorWorklistFixpoint::PruneWithScheduler(
+    ContractorStatus* cs) const {
+  scheduler_->StartPruning();
+  scheduler_->ClearQueue();
+  StartPruning(cs->box().size());
+  // 1. Fill the worklist, the queue of the scheduler. See Prune().
+  const int branching_point = cs->branching_point();
+  if (branching_point < 0) {
+    for (size_t ctc_idx = 0; ctc_idx < contractors_.size(); ++ctc_idx) {
+      scheduler_->Enqueue(ctc_idx);
+    }
+  } else {
+    AddToWorklist(branching_point);
+  }
+
+  // 2. Run the contractors in the worklist, the one with the highest
+  // priority first. A round runs as many contractors as the worklist had
+  // at its start. The termination condition is checked after each round.
+  while (scheduler_->queue_size() > 0) {
+    StartRound();
+    for (int n = scheduler_->queue_size(); n > 0; --n) {
+      const int ctc_idx{scheduler_->Dequeue()};
+      if (ctc_idx < 0) {
+        // All the contractors in the worklist are suspended.
+        return;
+      }
+      cs->ClearOutput();
+      scheduler_->Prune(ctc_idx, contractors_[ctc_idx], cs);
+      if (cs->box().empty()) {
+        return;
+      }
+      UpdateWorklist(*cs);
+    }
+    if (RoundTerminated(*cs)) {
+      return;
+    }
+  }
+}
+
+void ContractorWorklistFixpoint::StartPruning(const int size) const {
+  StartRound();
+  round_changed_.resize(size, false);
+  for (const int dim : watched_dims_) {
+    watched_[dim] = false;
+  }
+  watched_dims_.clear();
+  if (propagation_threshold_ > 0.0) {
+    watched_.resize(size, false);
+    watched_intervals_.resize(size);
+  }
+}
+
+void ContractorWorklistFixpoint::StartRound() const {
+  for (const int dim : round_dims_) {
+    round_changed_[dim] = false;
+  }
+  round_dims_.clear();
+  round_old_intervals_.clear();
+  round_has_unknown_change_ = false;
+}
+
+void ContractorWorklistFixpoint::UpdateWorklist(
+    const ContractorStatus& cs) const {
+  const ibex::BitSet& output{cs.output()};
+  if (output.empty()) {
+    return;
+  }
+  for (int j = 0, changed_dim = output.min(); j < output.size();
+       ++j, changed_dim = output.next(changed_dim)) {
+    const optional<Box::Interval> old_interval{
+        cs.output_old_interval(changed_dim)};
+    if (!round_changed_[changed_dim]) {
+      // This is the first change of the dimension in this round.
+      round_changed_[changed_dim] = true;
+      round_dims_.push_back(changed_dim);
+      if (old_interval) {
+        round_old_intervals_.push_back(*old_interval);
+      } else {
+        round_old_intervals_.push_back(cs.box()[changed_dim]);
+        round_has_unknown_change_ = true;
+      }
+    }
+    if (propagation_threshold_ > 0.0 &&
+        !IsSignificantChange(changed_dim, old_interval,
+                             cs.box()[changed_dim])) {
+      GetStat().num_suppressed_propagation_++;
+      continue;
+    }
+    AddToWorklist(changed_dim);
+  }
+}
+
+void ContractorWorklistFixpoint::AddToWorklist(const int dim) const {
+  for (const int ctc_idx : (*input_to_contractors_)[dim]) {
+    if (scheduler_) {
+      scheduler_->Enqueue(ctc_idx);
+    } else {
+      worklist_.add(ctc_idx);
+    }
+  }
+}
+
+bool ContractorWorklistFixpoint::IsSignificantChange(
+    const int dim, const optional<Box::Interval>& old_interval,
+    const Box::Interval& new_interval) const {
+  if (!watched_[dim]) {
+    watched_[dim] = true;
+    watched_dims_.push_back(dim);
+    if (!old_interval) {
+      // The size of the change is unknown.
+      watched_intervals_[dim] = new_interval;
+      return true;
+    }
+    watched_intervals_[dim] = *old_interval;
+  }
+  if (RelativeChange(watched_intervals_[dim], new_interval) <=
+      propagation_threshold_) {
+    return false;
+  }
+  watched_intervals_[dim] = new_interval;
+  return true;
+}
+
+bool ContractorWorklistFixpoint::RoundTerminated(
+    const ContractorStatus& cs) const {
+  if (round_dims_.empty()) {
+    // Nothing has changed.
+    return true;
+  }
+  if (round_has_unknown_change_) {
+    return false;
+  }
+  const int n = round_dims_.size();
+  if (round_old_iv_.size() != n) {
+    round_old_iv_.resize(n);
+    round_new_iv_.resize(n);
+  }
+  for (int i = 0; i < n; ++i) {
+    round_old_iv_[i] = round_old_intervals_[i];
+    round_new_iv_[i] = cs.box()[round_dims_[i]];
+  }
+  return term_cond_(round_old_iv_, round_new_iv_);
+}
+
+shared_ptr<ContractorCell> ContractorWorklistFixpoint::Clone() const {
+  return shared_ptr<ContractorCell>{new ContractorWorklistFixpoint{*this}};
 }
 
 ostream& ContractorWorklistFixpoint::display(ostream& os) const {
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <experimental/optional>
 #include <functional>
+#include <memory>
 #include <ostream>
 #include <unordered_map>
 #include <unordered_set>
@@ -8,6 +10,7 @@
 
 #include "dreal/contractor/contractor.h"
 #include "dreal/contractor/contractor_cell.h"
+#include "dreal/contractor/contractor_scheduler.h"
 #include "dreal/util/box.h"
 
 namespace dreal {
@@ -15,6 +18,10 @@ namespace dreal {
 /// Fixpoint contractor using the worklist algorithm: apply C₁, ..., Cₙ
 /// until it reaches a fixpoint or it satisfies a given termination
 /// condition.
+///
+/// The termination condition is checked after each round over the
+/// dimensions changed in the round only. It is called with the intervals
+/// of those dimensions at the start and at the end of the round.
 class ContractorWorklistFixpoint : public ContractorCell {
  public:
   /// Deletes default constructor.
@@ -22,33 +29,104 @@ class ContractorWorklistFixpoint : public ContractorCell {
 
   /// Constructs a fixpoint contractor with a termination condition
   /// (Box × Box → Bool) and a sequence of Contractors {C₁, ..., Cₙ}.
+  ///
+  /// If @p use_scheduler is true, it picks the contractor with the highest
+  /// priority from the worklist instead of the one with the smallest index,
+  /// and skips the ineffective ones. See ContractorScheduler.
+  ///
+  /// A change of a dimension wakes up the contractors depending on it only
+  /// if a bound has moved by more than @p propagation_threshold since the
+  /// last time it woke them up, relative to the width of the interval at
+  /// that time. See RelativeChange(). With the default value, 0, any
+  /// change wakes them up.
   ContractorWorklistFixpoint(TerminationCondition term_cond,
-                             std::vector<Contractor> contractors);
+                             std::vector<Contractor> contractors,
+                             bool use_scheduler = false,
+                             double propagation_threshold = 0.0);
 
   /// Default destructor.
   ~ContractorWorklistFixpoint() = default;
 
   void Prune(ContractorStatus* cs) const override;
+  std::shared_ptr<ContractorCell> Clone() const override;
   std::ostream& display(std::ostream& os) const override;
 
  private:
+  // Constructs a clone of @p other. See Clone().
+  ContractorWorklistFixpoint(const ContractorWorklistFixpoint& other);
+
+  // Prune() with the scheduler. The queue of the scheduler is used as the
+  // worklist. See ContractorScheduler::Dequeue().
+  void PruneWithScheduler(ContractorStatus* cs) const;
+
+  // Resets the propagation states and starts the first round for a box of
+  // @p size dimensions.
+  void StartPruning(int size) const;
+
+  // Starts a round of the fixed-point iteration.
+  void StartRound() const;
+
+  // Records the dimensions in `cs.output()` as changed in the current
+  // round, and adds the contractors depending on them into the worklist
+  // if the changes are significant.
+  void UpdateWorklist(const ContractorStatus& cs) const;
+
+  // Adds the contractors depending on the @p dim -th dimension into the
+  // worklist.
+  void AddToWorklist(int dim) const;
+
+  // Returns true if the change of the @p dim -th dimension from the last
+  // time it woke up the contractors is larger than the propagation
+  // threshold. @p old_interval is the interval before the last pruning
+  // if it is known.
+  bool IsSignificantChange(
+      int dim, const std::experimental::optional<Box::Interval>& old_interval,
+      const Box::Interval& new_interval) const;
+
+  // Returns true if the current round satisfies the termination
+  // condition.
+  bool RoundTerminated(const ContractorStatus& cs) const;
+
   // Stop the fixed-point iteration if term_cond(old_box, new_box) is true.
   const TerminationCondition term_cond_;
   std::vector<Contractor> contractors_;
+  const double propagation_threshold_{0.0};
+
+  // input_to_contractors_[i] lists the contractors whose input includes
+  // the i-th variable in ascending order. That is, j ∈
+  // input_to_contractors_[i] indicates that if i-th dimension of the
+  // current box changes in a pruning operation, we need to run
+  // contractors_[j] because i ∈ contractors_[j].input(). Its size is the
+  // total size of the inputs of the contractors. This map is constructed
+  // in the constructor and shared by the clones of this contractor.
+  std::shared_ptr<const std::vector<std::vector<int>>> input_to_contractors_;
 
-  // input_to_contractors_[i] is the set of contractors whose input
-  // includes the i-th variable. That is, `input_to_contractors_[i][j]
-  // = true` indicates that if i-th dimension of the current box
-  // changes in a pruning operation, we need to run contractors_[j]
-  // because i ∈ contractors_[j].input(). This map is constructed in
-  // the constructor.
-  std::vector<ibex::BitSet> input_to_contractors_;
+  // It is nullptr if the scheduler is not used.
+  const std::unique_ptr<ContractorScheduler> scheduler_;
 
   // worklist_[i] means that i-th contractor in contractors_ needs to be
-  // applied.
+  // applied. It is not used with the scheduler.
   mutable ibex::BitSet worklist_;
-  // A temporary variable to save an old interval vector.
-  mutable Box::IntervalVector old_iv_;
+
+  // The dimensions changed in the current round, and their intervals at
+  // the start of the round. `round_changed_[i]` is true if the i-th
+  // dimension is in `round_dims_`.
+  mutable std::vector<int> round_dims_;
+  mutable std::vector<Box::Interval> round_old_intervals_;
+  mutable std::vector<bool> round_changed_;
+  // True if a change in the current round is not recorded with its old
+  // interval. The round does not terminate in this case.
+  mutable bool round_has_unknown_change_{false};
+  // Temporary variables to pass the changed dimensions to term_cond_.
+  mutable Box::IntervalVector round_old_iv_;
+  mutable Box::IntervalVector round_new_iv_;
+
+  // `watched_intervals_[i]` is the i-th interval when it last woke up the
+  // contractors, if `watched_[i]` is true. They are used only with a
+  // positive propagation threshold.
+  mutable std::vector<int> watched_dims_;
+  mutable std::vector<Box::Interval> watched_intervals_;
+  mutable std::vector<bool> watched_;
 };
 
 }  // namespace dreal
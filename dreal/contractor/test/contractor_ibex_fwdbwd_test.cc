@@ -1,6 +1,7 @@
 #include "dreal/contractor/contractor_ibex_fwdbwd.h"
 
 #include <iostream>
+#include <string>
 
 #include <gtest/gtest.h>
 
@@ -54,6 +55,18 @@ TEST_F(ContractorIbexFwdbwdTest, Sat) {
   EXPECT_TRUE(cs.output()[0]);
   EXPECT_FALSE(cs.output()[1]);
   EXPECT_FALSE(cs.output()[2]);
+
+  // The size of the change is recorded. The lower bound of x moves by
+  // about 81% of the old width.
+  ASSERT_TRUE(cs.output_old_interval(0));
+  EXPECT_EQ(*cs.output_old_interval(0), Box::Interval(0.0, 3.14 / 2));
+  EXPECT_GT(cs.output_change(0), 0.8);
+  EXPECT_LT(cs.output_change(0), 0.82);
+  EXPECT_FALSE(cs.output_old_interval(1));
+
+  cs.ClearOutput();
+  EXPECT_FALSE(cs.output()[0]);
+  EXPECT_FALSE(cs.output_old_interval(0));
 }
 
 TEST_F(ContractorIbexFwdbwdTest, Unsat) {
@@ -82,5 +95,61 @@ TEST_F(ContractorIbexFwdbwdTest, Unsat) {
   EXPECT_TRUE(cs.output()[1]);
   EXPECT_TRUE(cs.output()[2]);
 }
+
+TEST_F(ContractorIbexFwdbwdTest, SubsetOfLargeBox) {
+  // A constraint over two of 1000 variables works on the sub-vector of
+  // its own variables.
+  Box box;
+  vector<Variable> vars;
+  for (int i = 0; i < 1000; ++i) {
+    vars.emplace_back("v" + std::to_string(i));
+    box.Add(vars.back(), -10, 10);
+  }
+  const Variable& v1{vars[700]};
+  const Variable& v2{vars[300]};
+  const ContractorIbexFwdbwd ctc{v1 == v2 + 1, box};
+  EXPECT_EQ(ctc.input().size(), 2);
+  EXPECT_TRUE(ctc.input()[300]);
+  EXPECT_TRUE(ctc.input()[700]);
+
+  ContractorStatus cs{box};
+  ctc.Prune(&cs);
+  EXPECT_EQ(cs.box()[v1], Box::Interval(-9, 10));
+  EXPECT_EQ(cs.box()[v2], Box::Interval(-10, 9));
+  EXPECT_EQ(cs.box()[vars[0]], Box::Interval(-10, 10));
+  EXPECT_TRUE(ctc.Evaluate(cs.box()).contains(0.0));
+
+  // Outputs are the indices in the box.
+  EXPECT_EQ(cs.output().size(), 2);
+  EXPECT_TRUE(cs.output()[300]);
+  EXPECT_TRUE(cs.output()[700]);
+  ASSERT_TRUE(cs.output_old_interval(700));
+  EXPECT_EQ(*cs.output_old_interval(700), Box::Interval(-10, 10));
+}
+
+TEST_F(ContractorIbexFwdbwdTest, Clone) {
+  const Formula f{cos(x_) == sin(y_)};
+  box_[x_] = Box::Interval(0.0, 3.14 / 2);
+  box_[y_] = Box::Interval(0.2, 0.3);
+  box_[z_] = Box::Interval(0.0, 1.0);
+  const Contractor ctc{make_contractor_ibex_fwdbwd(f, box_)};
+  const Contractor clone{ctc.Clone()};
+
+  EXPECT_TRUE(is_ibex_fwdbwd(clone));
+  for (int i = 0; i < box_.size(); ++i) {
+    EXPECT_EQ(clone.input()[i], ctc.input()[i]);
+  }
+
+  ContractorStatus cs1{box_};
+  ContractorStatus cs2{box_};
+  ctc.Prune(&cs1);
+  clone.Prune(&cs2);
+
+  // The clone prunes the box in the same way.
+  EXPECT_EQ(cs1.box(), cs2.box());
+  for (int i = 0; i < box_.size(); ++i) {
+    EXPECT_EQ(cs1.output()[i], cs2.output()[i]);
+  }
+}
 }  // namespace
 }  // namespace dreal
@@ -0,0 +1,168 @@
+#include "dreal/contractor/contractor_ibex_shared_fwdbwd.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+#include "dreal/util/ibex_constraint_cache.h"
+
+namespace dreal {
+namespace {
+
+using std::vector;
+
+class ContractorIbexSharedFwdbwdTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_[x_] = Box::Interval(-10, 10);
+    box_[y_] = Box::Interval(-10, 10);
+    box_[z_] = Box::Interval(-10, 10);
+  }
+
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  const Variable z_{"z", Variable::Type::CONTINUOUS};
+  const vector<Variable> vars_{{x_, y_, z_}};
+  Box box_{vars_};
+};
+
+TEST_F(ContractorIbexSharedFwdbwdTest, Sat) {
+  const Expression r{x_ * x_ + y_ * y_};
+  const Contractor ctc{
+      make_contractor_ibex_shared_fwdbwd({r <= 4, !(r < 1), x_ >= 1}, box_)};
+  EXPECT_TRUE(is_ibex_shared_fwdbwd(ctc));
+
+  // Inputs
+  EXPECT_TRUE(ctc.input()[0]);
+  EXPECT_TRUE(ctc.input()[1]);
+  EXPECT_FALSE(ctc.input()[2]);
+
+  ContractorStatus cs{box_};
+  ctc.Prune(&cs);
+  EXPECT_FALSE(cs.box().empty());
+  EXPECT_TRUE(cs.box()[x_].is_subset(Box::Interval(1, 2)));
+  EXPECT_TRUE(cs.box()[y_].is_subset(Box::Interval(-2, 2)));
+  EXPECT_EQ(cs.box()[z_], Box::Interval(-10, 10));
+
+  // Outputs. z is not changed.
+  EXPECT_TRUE(cs.output()[0]);
+  EXPECT_TRUE(cs.output()[1]);
+  EXPECT_FALSE(cs.output()[2]);
+  EXPECT_EQ(cs.used_constraints().size(), 3u);
+}
+
+TEST_F(ContractorIbexSharedFwdbwdTest, SharedNodeIsNarrowedByAllConstraints) {
+  // x² + y² is shared by the two constraints. The backward sweep narrows
+  // it to [0, 1] ∩ [4, ∞) = ∅, so a single pruning refutes the box.
+  const Expression r{x_ * x_ + y_ * y_};
+  const Contractor ctc{
+      make_contractor_ibex_shared_fwdbwd({r <= 1, r >= 4}, box_)};
+  ContractorStatus cs{box_};
+  ctc.Prune(&cs);
+  EXPECT_TRUE(cs.box().empty());
+  EXPECT_EQ(cs.unsat_witness().size(), 2u);
+}
+
+TEST_F(ContractorIbexSharedFwdbwdTest, NotEqualToIsIgnored) {
+  const Contractor ctc{
+      make_contractor_ibex_shared_fwdbwd({x_ != 0, !(y_ == 1)}, box_)};
+  ContractorStatus cs{box_};
+  ctc.Prune(&cs);
+  EXPECT_EQ(cs.box(), box_);
+  EXPECT_TRUE(cs.output().empty());
+}
+
+TEST_F(ContractorIbexSharedFwdbwdTest, Clone) {
+  const Expression s{sin(z_)};
+  const Contractor ctc{make_contractor_ibex_shared_fwdbwd(
+      {s + x_ == 0, s - y_ == 0, x_ >= 0.5}, box_)};
+  const Contractor clone{ctc.Clone()};
+  ContractorStatus cs1{box_};
+  ContractorStatus cs2{box_};
+  ctc.Prune(&cs1);
+  clone.Prune(&cs2);
+  EXPECT_EQ(cs1.box(), cs2.box());
+  // y = sin(z) ∈ [-1, 1].
+  EXPECT_TRUE(cs1.box()[y_].is_subset(Box::Interval(-1.01, 1.01)));
+}
+
+TEST_F(ContractorIbexSharedFwdbwdTest, InactiveAtoms) {
+  const Expression r{x_ * x_ + y_ * y_};
+  const Formula f1{r <= 4};
+  const Formula f2{x_ >= 1};
+  const Formula f3{y_ >= 1};
+  const Formula f4{r >= 9};
+  const std::set<Formula> atoms{f1, f2, f3, f4};
+  const Contractor ctc{
+      make_contractor_ibex_shared_fwdbwd({f1, f2}, atoms, box_)};
+
+  // f3 and f4 do not prune the box.
+  ContractorStatus cs{box_};
+  ctc.Prune(&cs);
+  EXPECT_FALSE(cs.box().empty());
+  EXPECT_TRUE(cs.box()[x_].is_subset(Box::Interval(1, 2)));
+  EXPECT_TRUE(cs.box()[y_].is_subset(Box::Interval(-2, 2)));
+  EXPECT_TRUE(cs.box()[y_].contains(-1.5));
+  EXPECT_EQ(cs.used_constraints().size(), 2u);
+
+  // Another subset of the atoms reuses the compiled function.
+  IbexConstraintCache& cache{IbexConstraintCache::Global()};
+  const int num_misses{cache.num_misses()};
+  const Contractor ctc2{
+      make_contractor_ibex_shared_fwdbwd({f1, !f3, f4}, atoms, box_)};
+  EXPECT_EQ(cache.num_misses(), num_misses);
+  ContractorStatus cs2{box_};
+  ctc2.Prune(&cs2);
+  EXPECT_TRUE(cs2.box().empty());
+  EXPECT_EQ(cs2.unsat_witness().size(), 3u);
+}
+
+TEST_F(ContractorIbexSharedFwdbwdTest, SubsetOfLargeBox) {
+  // The contractor works on the sub-vector over x and y only.
+  vector<Variable> vars{vars_};
+  for (int i = 0; i < 1000; ++i) {
+    vars.emplace_back("w" + std::to_string(i), Variable::Type::CONTINUOUS);
+  }
+  Box box{vars};
+  for (const Variable& var : vars) {
+    box[var] = Box::Interval(-10, 10);
+  }
+  const Expression r{x_ * x_ + y_ * y_};
+  const Contractor ctc{
+      make_contractor_ibex_shared_fwdbwd({r <= 4, x_ >= 1}, box)};
+  EXPECT_EQ(ctc.input().size(), 2);
+
+  // The function is compiled once.
+  IbexConstraintCache& cache{IbexConstraintCache::Global()};
+  const int num_hits{cache.num_hits()};
+  const Contractor ctc2{
+      make_contractor_ibex_shared_fwdbwd({x_ >= 1, r <= 4}, box)};
+  EXPECT_EQ(cache.num_hits(), num_hits + 1);
+
+  ContractorStatus cs{box};
+  ctc.Prune(&cs);
+  EXPECT_TRUE(cs.box()[x_].is_subset(Box::Interval(1, 2)));
+  EXPECT_TRUE(cs.box()[y_].is_subset(Box::Interval(-2, 2)));
+  for (int i = 2; i < box.size(); ++i) {
+    EXPECT_EQ(cs.box()[i], Box::Interval(-10, 10));
+  }
+  EXPECT_TRUE(cs.output()[box.index(x_)]);
+  EXPECT_TRUE(cs.output()[box.index(y_)]);
+  EXPECT_EQ(cs.output().size(), 2);
+
+  // An empty result is reported over the whole box.
+  const Contractor ctc3{
+      make_contractor_ibex_shared_fwdbwd({r <= 1, x_ >= 2}, box)};
+  ContractorStatus cs3{box};
+  ctc3.Prune(&cs3);
+  EXPECT_TRUE(cs3.box().empty());
+  EXPECT_EQ(cs3.output().size(), box.size());
+}
+
+}  // namespace
+}  // namespace dreal
@@ -0,0 +1,166 @@
+#include "dreal/contractor/contractor_scheduler.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+namespace {
+
+using std::numeric_limits;
+using std::vector;
+
+// Stops when no dimension is improved by 1% or more.
+bool TermCond(const Box::IntervalVector& old_iv,
+              const Box::IntervalVector& new_iv) {
+  for (int i = 0; i < old_iv.size(); ++i) {
+    const double old_i{old_iv[i].diam()};
+    const double new_i{new_iv[i].diam()};
+    if (old_i > 0 && !std::isinf(new_i) && 1 - new_i / old_i >= 0.01) {
+      return false;
+    }
+  }
+  return true;
+}
+
+class ContractorSchedulerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_.Add(x_, -10, 10);
+    box_.Add(y_, -10, 10);
+    box_.Add(i_, -10, 10);
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Variable i_{"i", Variable::Type::INTEGER};
+  Box box_;
+};
+
+TEST_F(ContractorSchedulerTest, Priority) {
+  const vector<Contractor> contractors{
+      make_contractor_ibex_fwdbwd(x_ >= 0, box_),
+      make_contractor_ibex_fwdbwd(y_ >= -100, box_)};
+  ContractorScheduler scheduler{contractors};
+  // The contractors which have not run yet have the highest priority.
+  EXPECT_EQ(scheduler.priority(0), numeric_limits<double>::infinity());
+  EXPECT_EQ(scheduler.priority(1), numeric_limits<double>::infinity());
+
+  scheduler.StartPruning();
+  ContractorStatus cs{box_};
+  EXPECT_TRUE(scheduler.Prune(0, contractors[0], &cs));
+  EXPECT_EQ(cs.box()[x_], Box::Interval(0, 10));
+  EXPECT_FALSE(scheduler.Prune(1, contractors[1], &cs));
+  EXPECT_GT(scheduler.priority(0), scheduler.priority(1));
+
+  vector<int> cheap;
+  vector<int> expensive;
+  scheduler.Schedule(&cheap, &expensive);
+  EXPECT_EQ(cheap, (vector<int>{0, 1}));
+  EXPECT_TRUE(expensive.empty());
+}
+
+TEST_F(ContractorSchedulerTest, Suspension) {
+  const vector<Contractor> contractors{
+      make_contractor_ibex_fwdbwd(x_ >= -100, box_),
+      make_contractor_integer(box_)};
+  ContractorScheduler scheduler{contractors};
+  box_[i_] = Box::Interval(0, 1);
+  ContractorStatus cs{box_};
+  for (int n = 0; n < 3; ++n) {
+    scheduler.StartPruning();
+    EXPECT_FALSE(scheduler.is_suspended(0));
+    EXPECT_FALSE(scheduler.Prune(0, contractors[0], &cs));
+    EXPECT_FALSE(scheduler.Prune(1, contractors[1], &cs));
+  }
+  // The first one has had no effect three times in a row. The integer
+  // contractor is never suspended.
+  EXPECT_TRUE(scheduler.is_suspended(0));
+  EXPECT_FALSE(scheduler.is_suspended(1));
+
+  scheduler.Enqueue(0);
+  scheduler.Enqueue(1);
+  EXPECT_EQ(scheduler.Dequeue(), 1);
+  // The suspended one is dropped from the queue.
+  EXPECT_EQ(scheduler.Dequeue(), -1);
+  EXPECT_EQ(scheduler.queue_size(), 0);
+
+  // The suspension is over in the next call of the fixpoint contractor.
+  scheduler.StartPruning();
+  EXPECT_FALSE(scheduler.is_suspended(0));
+}
+
+TEST_F(ContractorSchedulerTest, ExpensiveContractor) {
+  const vector<Contractor> contractors{
+      make_contractor_join({make_contractor_ibex_fwdbwd(x_ >= 0, box_),
+                            make_contractor_ibex_fwdbwd(x_ <= -1, box_)}),
+      make_contractor_ibex_fwdbwd(y_ >= 0, box_)};
+  ContractorScheduler scheduler{contractors};
+  EXPECT_TRUE(scheduler.is_expensive(0));
+  EXPECT_FALSE(scheduler.is_expensive(1));
+
+  // A cheap contractor is selected before an expensive one.
+  scheduler.Enqueue(0);
+  scheduler.Enqueue(1);
+  EXPECT_EQ(scheduler.Dequeue(), 1);
+  EXPECT_EQ(scheduler.Dequeue(), 0);
+}
+
+TEST_F(ContractorSchedulerTest, Queue) {
+  const vector<Contractor> contractors{
+      make_contractor_ibex_fwdbwd(x_ >= -100, box_),
+      make_contractor_ibex_fwdbwd(x_ >= 0, box_),
+      make_contractor_ibex_fwdbwd(y_ >= 0, box_)};
+  ContractorScheduler scheduler{contractors};
+  scheduler.StartPruning();
+  ContractorStatus cs{box_};
+  EXPECT_FALSE(scheduler.Prune(0, contractors[0], &cs));
+  EXPECT_TRUE(scheduler.Prune(1, contractors[1], &cs));
+
+  // A contractor is queued once.
+  scheduler.Enqueue(0);
+  scheduler.Enqueue(1);
+  scheduler.Enqueue(0);
+  scheduler.Enqueue(2);
+  EXPECT_EQ(scheduler.queue_size(), 3);
+
+  // The one which has not run yet comes first. The one which has shrunk
+  // the box comes before the one which has not.
+  EXPECT_EQ(scheduler.Dequeue(), 2);
+  EXPECT_EQ(scheduler.Dequeue(), 1);
+  EXPECT_EQ(scheduler.Dequeue(), 0);
+  EXPECT_EQ(scheduler.Dequeue(), -1);
+
+  scheduler.Enqueue(0);
+  scheduler.ClearQueue();
+  EXPECT_EQ(scheduler.queue_size(), 0);
+  scheduler.Enqueue(0);
+  EXPECT_EQ(scheduler.queue_size(), 1);
+}
+
+TEST_F(ContractorSchedulerTest, Fixpoint) {
+  const vector<Contractor> contractors{
+      make_contractor_ibex_fwdbwd(x_ == y_ + 1, box_),
+      make_contractor_ibex_fwdbwd(y_ == 2, box_),
+      make_contractor_ibex_fwdbwd(x_ >= -100, box_)};
+  for (const bool use_scheduler : {false, true}) {
+    for (const Contractor& fixpoint :
+         {make_contractor_fixpoint(TermCond, contractors, use_scheduler),
+          make_contractor_worklist_fixpoint(TermCond, contractors,
+                                            use_scheduler)}) {
+      ContractorStatus cs{box_};
+      fixpoint.Prune(&cs);
+      EXPECT_TRUE(cs.box()[x_].is_subset(Box::Interval(2.99, 3.01)));
+      EXPECT_TRUE(cs.box()[y_].is_subset(Box::Interval(1.99, 2.01)));
+    }
+  }
+}
+
+}  // namespace
+}  // namespace dreal
@@ -1,9 +1,14 @@
 #include "dreal/contractor/contractor.h"
 
 #include <type_traits>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
 namespace dreal {
 namespace {
 
@@ -16,5 +21,26 @@ GTEST_TEST(ContractorTest, is_nothrow_move_constructible) {
                 "Contractor should be nothrow_move_constructible.");
 }
 
+GTEST_TEST(ContractorTest, SkipEntailedConstraint) {
+  const Variable x{"x"};
+  Box box;
+  box.Add(x, 0, 2);
+  Contractor ctc{make_contractor_ibex_fwdbwd(x >= 1, box)};
+  ctc.set_constraint_id(0);
+  EXPECT_EQ(ctc.constraint_id(), 0);
+  // The clone keeps the constraint id.
+  EXPECT_EQ(ctc.Clone().constraint_id(), 0);
+
+  // If the constraint is flagged as entailed, the contractor does nothing.
+  ContractorStatus cs1{box};
+  cs1.mutable_entailed() = std::vector<bool>{true};
+  ctc.Prune(&cs1);
+  EXPECT_EQ(cs1.box()[x], Box::Interval(0, 2));
+
+  ContractorStatus cs2{box};
+  ctc.Prune(&cs2);
+  EXPECT_EQ(cs2.box()[x], Box::Interval(1, 2));
+}
+
 }  // namespace
 }  // namespace dreal
@@ -0,0 +1,93 @@
+#include "dreal/contractor/contractor_worklist_fixpoint.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+namespace {
+
+using std::vector;
+
+// Never stops before reaching a fixpoint.
+bool NoTermination(const Box::IntervalVector& /* old_iv */,
+                   const Box::IntervalVector& /* new_iv */) {
+  return false;
+}
+
+class ContractorWorklistFixpointTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_.Add(w_, 0, 10);
+    box_.Add(x_, 0, 10);
+    box_.Add(y_, 0, 10);
+  }
+
+  const Variable w_{"w"};
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  Box box_;
+};
+
+TEST_F(ContractorWorklistFixpointTest, PropagationThreshold) {
+  // Starting from a branching on w, the first contractor moves the upper
+  // bound of x by 0.1% of its width. It wakes up the second one only if
+  // the threshold is smaller than that.
+  const vector<Contractor> contractors{
+      make_contractor_ibex_fwdbwd(x_ <= 0.999 * w_, box_),
+      make_contractor_ibex_fwdbwd(y_ <= x_, box_)};
+  const int branching_point{box_.index(w_)};
+
+  const Contractor propagate_all{make_contractor_worklist_fixpoint(
+      NoTermination, contractors, false, 0.0)};
+  ContractorStatus cs1{box_, branching_point};
+  propagate_all.Prune(&cs1);
+  EXPECT_TRUE(cs1.box()[y_].is_subset(Box::Interval(0, 9.991)));
+
+  const Contractor propagate_large_changes{make_contractor_worklist_fixpoint(
+      NoTermination, contractors, false, 0.01)};
+  ContractorStatus cs2{box_, branching_point};
+  propagate_large_changes.Prune(&cs2);
+  EXPECT_TRUE(cs2.box()[x_].is_subset(Box::Interval(0, 9.991)));
+  EXPECT_EQ(cs2.box()[y_], Box::Interval(0, 10));
+}
+
+TEST_F(ContractorWorklistFixpointTest, LargeChangeIsPropagated) {
+  const vector<Contractor> contractors{
+      make_contractor_ibex_fwdbwd(x_ <= 0.5 * w_, box_),
+      make_contractor_ibex_fwdbwd(y_ <= x_, box_)};
+  const Contractor fixpoint{make_contractor_worklist_fixpoint(
+      NoTermination, contractors, false, 0.01)};
+  ContractorStatus cs{box_, box_.index(w_)};
+  fixpoint.Prune(&cs);
+  EXPECT_TRUE(cs.box()[y_].is_subset(Box::Interval(0, 5.001)));
+}
+
+TEST_F(ContractorWorklistFixpointTest, TerminationOverChangedDimensions) {
+  // The termination condition only sees the dimensions changed in a
+  // round. Here, it is y alone.
+  vector<int> sizes;
+  const TerminationCondition term_cond{
+      [&sizes](const Box::IntervalVector& old_iv,
+               const Box::IntervalVector& new_iv) {
+        EXPECT_EQ(old_iv.size(), new_iv.size());
+        sizes.push_back(old_iv.size());
+        return false;
+      }};
+  const vector<Contractor> contractors{
+      make_contractor_ibex_fwdbwd(y_ <= 5, box_),
+      make_contractor_ibex_fwdbwd(w_ + x_ >= 0, box_)};
+  const Contractor fixpoint{
+      make_contractor_worklist_fixpoint(term_cond, contractors)};
+  ContractorStatus cs{box_};
+  fixpoint.Prune(&cs);
+  EXPECT_EQ(cs.box()[y_], Box::Interval(0, 5));
+  EXPECT_EQ(sizes, vector<int>{1});
+}
+
+}  // namespace
+}  // namespace dreal
@@ -85,11 +85,211 @@ void MainProgram::AddOptions() {
            "Use polytope contractor in forall contractor.\n",
            "--forall-polytope");
 
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Merge the constraints sharing variables into one "
+           "forward/backward contractor which evaluates their common "
+           "subexpressions once.\n",
+           "--shared-fwdbwd");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Evaluate the two halves of a bisected box in one batch and "
+           "drop the halves refuted by the evaluation.\n",
+           "--batched-evaluation");
+
   opt_.add("false" /* Default */, false /* Required? */,
            0 /* Number of args expected. */,
            0 /* Delimiter if expecting multiple args. */,
            "Use worklist fixpoint algorithm in ICP.\n", "--worklist-fixpoint");
 
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Order the contractors in the fixpoint by their measured "
+           "effectiveness and skip the ineffective ones.\n",
+           "--adaptive-scheduling");
+
+  const double propagation_threshold[1] = {0.0};
+  ez::ezOptionValidator* const propagation_threshold_option_validator =
+      new ez::ezOptionValidator(ez::ezOptionValidator::D,
+                                ez::ezOptionValidator::GE,
+                                propagation_threshold, 1);
+  opt_.add("0.0" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "In the worklist fixpoint, wake up the contractors depending on "
+           "a variable only if a bound moves by more than this ratio of "
+           "the width of its interval (default = 0.0).\n",
+           "--propagation-threshold", propagation_threshold_option_validator);
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Keep a single working box in the depth-first ICP and undo its "
+           "changes on backtracking.\n",
+           "--trail-icp");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Skip the sibling of a refuted box in the depth-first ICP if the "
+           "refutation does not depend on the branching. It implies "
+           "--trail-icp.\n",
+           "--icp-backjumping");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Reuse the boxes pruned by the theory literals shared with the "
+           "previous theory checks.\n",
+           "--incremental-icp");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Explore the branches containing the model of the previous "
+           "delta-SAT check first.\n",
+           "--warm-start");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Propagate the theory literals implied by pruning to the SAT "
+           "solver.\n",
+           "--theory-propagation");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Minimize the explanations of theory conflicts.\n",
+           "--minimize-explanation");
+
+  const int budget[1] = {0};
+  ez::ezOptionValidator* const explanation_minimizer_budget_option_validator =
+      new ez::ezOptionValidator(ez::ezOptionValidator::S4,
+                                ez::ezOptionValidator::GT, budget, 1);
+  opt_.add("100" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Maximum number of refutation checks to minimize an explanation "
+           "(default = 100)\n",
+           "--explanation-minimizer-budget",
+           explanation_minimizer_budget_option_validator);
+
+  const int jobs[1] = {0};
+  ez::ezOptionValidator* const jobs_option_validator =
+      new ez::ezOptionValidator(ez::ezOptionValidator::S4,
+                                ez::ezOptionValidator::GT, jobs, 1);
+  opt_.add("1" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Number of parallel jobs used in ICP (default = 1)\n", "--jobs",
+           "-j", jobs_option_validator);
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Run differently configured solvers in parallel and take the first "
+           "result.\n",
+           "--portfolio");
+
+  ez::ezOptionValidator* const sat_solver_option_validator =
+      new ez::ezOptionValidator("t", "in", "picosat", true);
+  opt_.add("picosat" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "SAT solver used in the DPLL(T) loop. Only picosat is "
+           "available (default = picosat).\n",
+           "--sat-solver", sat_solver_option_validator);
+
+  const double timeout[1] = {0.0};
+  ez::ezOptionValidator* const timeout_option_validator =
+      new ez::ezOptionValidator(ez::ezOptionValidator::D,
+                                ez::ezOptionValidator::GE, timeout, 1);
+  opt_.add("0" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Time limit in seconds for each check-sat, 0 for no limit "
+           "(default = 0)\n",
+           "--timeout", timeout_option_validator);
+
+  const int limit[1] = {0};
+  ez::ezOptionValidator* const max_branchings_option_validator =
+      new ez::ezOptionValidator(ez::ezOptionValidator::S4,
+                                ez::ezOptionValidator::GE, limit, 1);
+  opt_.add("0" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Maximum number of branchings for each check-sat, 0 for no limit "
+           "(default = 0)\n",
+           "--max-branchings", max_branchings_option_validator);
+
+  ez::ezOptionValidator* const max_prunings_option_validator =
+      new ez::ezOptionValidator(ez::ezOptionValidator::S4,
+                                ez::ezOptionValidator::GE, limit, 1);
+  opt_.add("0" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Maximum number of prunings for each check-sat, 0 for no limit "
+           "(default = 0)\n",
+           "--max-prunings", max_prunings_option_validator);
+
+  ez::ezOptionValidator* const max_sat_calls_option_validator =
+      new ez::ezOptionValidator(ez::ezOptionValidator::S4,
+                                ez::ezOptionValidator::GE, limit, 1);
+  opt_.add("0" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Maximum number of SAT-solver calls for each check-sat, 0 for no "
+           "limit (default = 0)\n",
+           "--max-sat-calls", max_sat_calls_option_validator);
+
+  ez::ezOptionValidator* const branching_heuristic_option_validator =
+      new ez::ezOptionValidator("t", "in", "max-diam,round-robin,smear",
+                                true);
+  opt_.add("max-diam" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Branching heuristic used in ICP. Either one of these "
+           "(default = max-diam):\n"
+           "max-diam, round-robin, smear\n",
+           "--branching-heuristic", branching_heuristic_option_validator);
+
+  ez::ezOptionValidator* const exploration_order_option_validator =
+      new ez::ezOptionValidator("t", "in", "depth-first,best-first", true);
+  opt_.add("depth-first" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Order to explore boxes in ICP. Either one of these "
+           "(default = depth-first):\n"
+           "depth-first, best-first\n",
+           "--exploration-order", exploration_order_option_validator);
+
+  const int queue_size[1] = {0};
+  ez::ezOptionValidator* const best_first_max_queue_size_option_validator =
+      new ez::ezOptionValidator(ez::ezOptionValidator::S4,
+                                ez::ezOptionValidator::GT, queue_size, 1);
+  opt_.add("100000" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Maximum number of boxes in the queue of the best-first "
+           "exploration (default = 100000)\n",
+           "--best-first-max-queue-size",
+           best_first_max_queue_size_option_validator);
+
+  ez::ezOptionValidator* const icp_nogood_capacity_option_validator =
+      new ez::ezOptionValidator(ez::ezOptionValidator::S4,
+                                ez::ezOptionValidator::GE, limit, 1);
+  opt_.add("0" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Maximum number of refuted boxes kept by --icp-backjumping to "
+           "prune the later boxes, 0 to disable (default = 0)\n",
+           "--icp-nogood-capacity", icp_nogood_capacity_option_validator);
+
   ez::ezOptionValidator* const verbose_option_validator =
       new ez::ezOptionValidator(
           "t", "in", "trace,debug,info,warning,error,critical,off", true);
@@ -143,6 +343,13 @@ void MainProgram::ExtractOptions() {
   // Temporary variables used to set options.
   string verbosity;
   double precision{0.0};
+  int jobs{0};
+  double timeout{0.0};
+  double propagation_threshold{0.0};
+  int limit{0};
+  string branching_heuristic;
+  string exploration_order;
+  string sat_solver;
 
   opt_.get("--verbose")->getString(verbosity);
   if (verbosity == "trace") {
@@ -188,12 +395,207 @@ void MainProgram::ExtractOptions() {
                     config_.use_polytope_in_forall());
   }
 
+  // --shared-fwdbwd
+  if (opt_.isSet("--shared-fwdbwd")) {
+    config_.mutable_use_shared_fwdbwd().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --shared-fwdbwd = {}",
+                    config_.use_shared_fwdbwd());
+  }
+
+  // --batched-evaluation
+  if (opt_.isSet("--batched-evaluation")) {
+    config_.mutable_use_batched_evaluation().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --batched-evaluation = {}",
+                    config_.use_batched_evaluation());
+  }
+
   // --worklist-fixpoint
   if (opt_.isSet("--worklist-fixpoint")) {
     config_.mutable_use_worklist_fixpoint().set_from_command_line(true);
     DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --worklist-fixpoint = {}",
                     config_.use_worklist_fixpoint());
   }
+
+  // --adaptive-scheduling
+  if (opt_.isSet("--adaptive-scheduling")) {
+    config_.mutable_use_adaptive_scheduling().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --adaptive-scheduling = {}",
+                    config_.use_adaptive_scheduling());
+  }
+
+  // --propagation-threshold
+  if (opt_.isSet("--propagation-threshold")) {
+    opt_.get("--propagation-threshold")->getDouble(propagation_threshold);
+    config_.mutable_propagation_threshold().set_from_command_line(
+        propagation_threshold);
+    DREAL_LOG_DEBUG(
+        "MainProgram::ExtractOptions() --propagation-threshold = {}",
+        config_.propagation_threshold());
+  }
+
+  // --trail-icp
+  if (opt_.isSet("--trail-icp")) {
+    config_.mutable_use_trail_icp().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --trail-icp = {}",
+                    config_.use_trail_icp());
+  }
+
+  // --icp-backjumping
+  if (opt_.isSet("--icp-backjumping")) {
+    config_.mutable_use_icp_backjumping().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --icp-backjumping = {}",
+                    config_.use_icp_backjumping());
+  }
+
+  // --incremental-icp
+  if (opt_.isSet("--incremental-icp")) {
+    config_.mutable_use_incremental_icp().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --incremental-icp = {}",
+                    config_.use_incremental_icp());
+  }
+
+  // --warm-start
+  if (opt_.isSet("--warm-start")) {
+    config_.mutable_use_warm_start().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --warm-start = {}",
+                    config_.use_warm_start());
+  }
+
+  // --theory-propagation
+  if (opt_.isSet("--theory-propagation")) {
+    config_.mutable_use_theory_propagation().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --theory-propagation = {}",
+                    config_.use_theory_propagation());
+  }
+
+  // --minimize-explanation
+  if (opt_.isSet("--minimize-explanation")) {
+    config_.mutable_use_explanation_minimizer().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --minimize-explanation = {}",
+                    config_.use_explanation_minimizer());
+  }
+
+  // --explanation-minimizer-budget
+  if (opt_.isSet("--explanation-minimizer-budget")) {
+    opt_.get("--explanation-minimizer-budget")->getInt(limit);
+    config_.mutable_explanation_minimizer_budget().set_from_command_line(
+        limit);
+    DREAL_LOG_DEBUG(
+        "MainProgram::ExtractOptions() --explanation-minimizer-budget = {}",
+        config_.explanation_minimizer_budget());
+  }
+
+  // --jobs
+  if (opt_.isSet("--jobs")) {
+    opt_.get("--jobs")->getInt(jobs);
+    config_.mutable_number_of_jobs().set_from_command_line(jobs);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --jobs = {}",
+                    config_.number_of_jobs());
+  }
+
+  // --portfolio
+  if (opt_.isSet("--portfolio")) {
+    config_.mutable_use_portfolio().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --portfolio = {}",
+                    config_.use_portfolio());
+  }
+
+  // --sat-solver
+  if (opt_.isSet("--sat-solver")) {
+    opt_.get("--sat-solver")->getString(sat_solver);
+    if (sat_solver == "picosat") {
+      config_.mutable_sat_solver_backend().set_from_command_line(
+          Config::SatSolverBackend::PICOSAT);
+    } else {
+      DREAL_UNREACHABLE();
+    }
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --sat-solver = {}",
+                    config_.sat_solver_backend());
+  }
+
+  // --timeout
+  if (opt_.isSet("--timeout")) {
+    opt_.get("--timeout")->getDouble(timeout);
+    config_.mutable_timeout().set_from_command_line(timeout);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --timeout = {}",
+                    config_.timeout());
+  }
+
+  // --max-branchings
+  if (opt_.isSet("--max-branchings")) {
+    opt_.get("--max-branchings")->getInt(limit);
+    config_.mutable_max_branchings().set_from_command_line(limit);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --max-branchings = {}",
+                    config_.max_branchings());
+  }
+
+  // --max-prunings
+  if (opt_.isSet("--max-prunings")) {
+    opt_.get("--max-prunings")->getInt(limit);
+    config_.mutable_max_prunings().set_from_command_line(limit);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --max-prunings = {}",
+                    config_.max_prunings());
+  }
+
+  // --max-sat-calls
+  if (opt_.isSet("--max-sat-calls")) {
+    opt_.get("--max-sat-calls")->getInt(limit);
+    config_.mutable_max_sat_calls().set_from_command_line(limit);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --max-sat-calls = {}",
+                    config_.max_sat_calls());
+  }
+
+  // --branching-heuristic
+  if (opt_.isSet("--branching-heuristic")) {
+    opt_.get("--branching-heuristic")->getString(branching_heuristic);
+    if (branching_heuristic == "max-diam") {
+      config_.mutable_branching_heuristic().set_from_command_line(
+          Config::BranchingHeuristic::MAX_DIAM);
+    } else if (branching_heuristic == "round-robin") {
+      config_.mutable_branching_heuristic().set_from_command_line(
+          Config::BranchingHeuristic::ROUND_ROBIN);
+    } else if (branching_heuristic == "smear") {
+      config_.mutable_branching_heuristic().set_from_command_line(
+          Config::BranchingHeuristic::SMEAR);
+    } else {
+      DREAL_UNREACHABLE();
+    }
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --branching-heuristic = {}",
+                    config_.branching_heuristic());
+  }
+
+  // --exploration-order
+  if (opt_.isSet("--exploration-order")) {
+    opt_.get("--exploration-order")->getString(exploration_order);
+    if (exploration_order == "depth-first") {
+      config_.mutable_exploration_order().set_from_command_line(
+          Config::ExplorationOrder::DEPTH_FIRST);
+    } else if (exploration_order == "best-first") {
+      config_.mutable_exploration_order().set_from_command_line(
+          Config::ExplorationOrder::BEST_FIRST);
+    } else {
+      DREAL_UNREACHABLE();
+    }
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --exploration-order = {}",
+                    config_.exploration_order());
+  }
+
+  // --best-first-max-queue-size
+  if (opt_.isSet("--best-first-max-queue-size")) {
+    opt_.get("--best-first-max-queue-size")->getInt(limit);
+    config_.mutable_best_first_max_queue_size().set_from_command_line(limit);
+    DREAL_LOG_DEBUG(
+        "MainProgram::ExtractOptions() --best-first-max-queue-size = {}",
+        config_.best_first_max_queue_size());
+  }
+
+  // --icp-nogood-capacity
+  if (opt_.isSet("--icp-nogood-capacity")) {
+    opt_.get("--icp-nogood-capacity")->getInt(limit);
+    config_.mutable_icp_nogood_capacity().set_from_command_line(limit);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --icp-nogood-capacity = {}",
+                    config_.icp_nogood_capacity());
+  }
 }
 
 int MainProgram::Run() {
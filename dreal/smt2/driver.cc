@@ -5,7 +5,6 @@
 #include <sstream>
 #include <string>
 #include <utility>
-#include <experimental/optional>
 
 #include "dreal/smt2/scanner.h"
 #include "dreal/util/logging.h"
@@ -14,7 +13,6 @@ namespace dreal {
 
 using std::cout;
 using std::endl;
-using std::experimental::optional;
 using std::ifstream;
 using std::istream;
 using std::istringstream;
@@ -53,14 +51,21 @@ void Smt2Driver::error(const class location& l, const string& m) {
 void Smt2Driver::error(const string& m) { log()->error("{}", m); }
 
 void Smt2Driver::CheckSat() {
-  const optional<Box> model{context_.CheckSat()};
-  if (model) {
-    cout << "delta-sat with delta = " << context_.config().precision() << endl;
-    if (context_.config().produce_models()) {
-      cout << *model << endl;
-    }
-  } else {
-    cout << "unsat" << endl;
+  Box model;
+  switch (context_.CheckSat(&model)) {
+    case SatCheckResult::DELTA_SAT:
+      cout << "delta-sat with delta = " << context_.config().precision()
+           << endl;
+      if (context_.config().produce_models()) {
+        cout << model << endl;
+      }
+      return;
+    case SatCheckResult::UNSAT:
+      cout << "unsat" << endl;
+      return;
+    case SatCheckResult::UNKNOWN:
+      cout << "unknown" << endl;
+      return;
   }
 }
 
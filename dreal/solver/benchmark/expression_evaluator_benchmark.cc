@@ -0,0 +1,124 @@
+// Compares the evaluation of expressions over a batch of boxes with the
+// evaluation of the same boxes one by one.
+//
+// Usage: expression_evaluator_benchmark [repetitions]
+//
+// For each expression and batch size, it prints the time per box of the
+// scalar evaluation, of the batched evaluation, and of the batched
+// evaluation including the construction of the batch. The first
+// expression only uses the operations with vector kernels. The second one
+// also has operations evaluated box by box.
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dreal/solver/expression_evaluator.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+#include "dreal/util/box_batch.h"
+#include "dreal/util/logging.h"
+
+namespace dreal {
+namespace {
+
+using std::cout;
+using std::max;
+using std::min;
+using std::mt19937;
+using std::string;
+using std::uniform_real_distribution;
+using std::vector;
+
+// Keeps the compiler from removing the evaluations.
+volatile double benchmark_sink;
+
+// Returns the seconds taken by @p f.
+template <typename F>
+double Seconds(F f) {
+  using std::chrono::steady_clock;
+  const steady_clock::time_point start{steady_clock::now()};
+  f();
+  const std::chrono::duration<double> elapsed{steady_clock::now() - start};
+  return elapsed.count();
+}
+
+// Returns @p n random boxes over @p variables.
+vector<Box> MakeBoxes(const vector<Variable>& variables, const int n) {
+  mt19937 gen{0};
+  uniform_real_distribution<double> dist{-10, 10};
+  vector<Box> boxes;
+  for (int k = 0; k < n; ++k) {
+    Box box;
+    for (const Variable& var : variables) {
+      const double a{dist(gen)};
+      const double b{dist(gen)};
+      box.Add(var, min(a, b), max(a, b));
+    }
+    boxes.push_back(box);
+  }
+  return boxes;
+}
+
+void Run(const string& name, const Expression& e, const vector<Box>& boxes,
+         const int repetitions) {
+  using fmt::print;
+  const ExpressionEvaluator evaluator{e};
+  const int n{static_cast<int>(boxes.size())};
+  double sink{0.0};
+  const double scalar{Seconds([&] {
+    for (int i = 0; i < repetitions; ++i) {
+      for (const Box& box : boxes) {
+        sink += evaluator(box).ub();
+      }
+    }
+  })};
+  const BoxBatch batch{boxes};
+  const double batched{Seconds([&] {
+    for (int i = 0; i < repetitions; ++i) {
+      for (const Box::Interval& iv : evaluator(batch)) {
+        sink += iv.ub();
+      }
+    }
+  })};
+  const double batched_with_packing{Seconds([&] {
+    for (int i = 0; i < repetitions; ++i) {
+      for (const Box::Interval& iv : evaluator(BoxBatch{boxes})) {
+        sink += iv.ub();
+      }
+    }
+  })};
+  const double to_ns{1e9 / (static_cast<double>(repetitions) * n)};
+  print(cout,
+        "{:<10} batch = {:>4}: scalar = {:>8.1f} ns/box, batched = {:>8.1f} "
+        "ns/box ({:.2f}x), with packing = {:>8.1f} ns/box ({:.2f}x)\n",
+        name, n, scalar * to_ns, batched * to_ns, scalar / batched,
+        batched_with_packing * to_ns, scalar / batched_with_packing);
+  benchmark_sink = sink;
+}
+
+void expression_evaluator_benchmark_main(const int repetitions) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  const Variable z{"z"};
+  const Variable w{"w"};
+  const Expression polynomial{3 * x * y - 2 * y * z + x * x * w - z * z +
+                              0.5 * w * x * y + 7};
+  const Expression mixed{x * sin(y) + pow(z, 2) / (1 + abs(w)) - x * z};
+  for (const int n : {2, 8, 64}) {
+    const vector<Box> boxes{MakeBoxes({x, y, z, w}, n)};
+    Run("polynomial", polynomial, boxes, repetitions);
+    Run("mixed", mixed, boxes, repetitions);
+  }
+}
+
+}  // namespace
+}  // namespace dreal
+
+int main(int argc, char* argv[]) {
+  const int repetitions{argc > 1 ? std::atoi(argv[1]) : 100000};
+  dreal::expression_evaluator_benchmark_main(repetitions);
+}
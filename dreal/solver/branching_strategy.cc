@@ -0,0 +1,207 @@
+#include "dreal/solver/branching_strategy.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <experimental/optional>
+
+#include "dreal/solver/expression_evaluator.h"
+#include "dreal/solver/icp.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
+#include "dreal/util/logging.h"
+
+namespace dreal {
+
+using std::experimental::nullopt;
+using std::experimental::optional;
+using std::make_shared;
+using std::max;
+using std::move;
+using std::pair;
+using std::runtime_error;
+using std::shared_ptr;
+using std::unique_ptr;
+using std::vector;
+
+namespace {
+
+// Selects the dimension with the largest diameter.
+class MaxDiamBranchingStrategy : public BranchingStrategy {
+ public:
+  int Select(const Box& box, const ibex::BitSet& candidates) override {
+    return FindMaxDiam(box, candidates).second;
+  }
+
+  unique_ptr<BranchingStrategy> Clone() const override {
+    return unique_ptr<BranchingStrategy>{new MaxDiamBranchingStrategy{*this}};
+  }
+};
+
+// Selects the dimensions in turn. It picks the first bisectable candidate
+// after the one selected last time, wrapping around at the end.
+class RoundRobinBranchingStrategy : public BranchingStrategy {
+ public:
+  int Select(const Box& box, const ibex::BitSet& candidates) override {
+    DREAL_ASSERT(!candidates.empty());
+    int first{-1};  // The first bisectable candidate.
+    int next{-1};   // The first bisectable candidate after last_.
+    for (int i = 0, idx = candidates.min(); i < candidates.size();
+         ++i, idx = candidates.next(idx)) {
+      if (!box[idx].is_bisectable()) {
+        continue;
+      }
+      if (first < 0) {
+        first = idx;
+      }
+      if (idx > last_) {
+        next = idx;
+        break;
+      }
+    }
+    last_ = next >= 0 ? next : first;
+    return last_;
+  }
+
+  unique_ptr<BranchingStrategy> Clone() const override {
+    return unique_ptr<BranchingStrategy>{
+        new RoundRobinBranchingStrategy{*this}};
+  }
+
+ private:
+  int last_{-1};
+};
+
+// Returns e₁ - e₂ for a relational formula f = (e₁ op e₂) or its negation.
+Expression ExtractExpression(const Formula& f) {
+  if (is_negation(f)) {
+    return ExtractExpression(get_operand(f));
+  }
+  DREAL_ASSERT(is_relational(f));
+  return get_lhs_expression(f) - get_rhs_expression(f);
+}
+
+using SmearConstraints = vector<shared_ptr<const SmearConstraint>>;
+
+// Selects the dimension with the largest smear value. The smear value of a
+// variable x is max |∂f/∂x| · diam(x) over the constraints f whose
+// evaluations are wider than the precision.
+class SmearBranchingStrategy : public BranchingStrategy {
+ public:
+  SmearBranchingStrategy(SmearConstraints smear_constraints,
+                         const double precision)
+      : constraints_{
+            make_shared<const SmearConstraints>(move(smear_constraints))},
+        precision_{precision} {}
+
+  int Select(const Box& box, const ibex::BitSet& candidates) override {
+    DREAL_ASSERT(!candidates.empty());
+    vector<double> smears(box.size(), 0.0);
+    for (const shared_ptr<const SmearConstraint>& constraint : *constraints_) {
+      if (constraint->f(box).diam() <= precision_) {
+        // This constraint is already satisfied within the precision.
+        continue;
+      }
+      for (const pair<Variable, optional<ExpressionEvaluator>>& p :
+           constraint->partials) {
+        const int idx{box.index(p.first)};
+        const Box::Interval& x{box[idx]};
+        if (!candidates.contain(idx) || !x.is_bisectable()) {
+          continue;
+        }
+        double smear{x.diam()};
+        if (p.second) {
+          const Box::Interval derivative{(*p.second)(box)};
+          if (derivative.is_empty()) {
+            continue;
+          }
+          smear *= derivative.mag();
+        }
+        smears[idx] = max(smears[idx], smear);
+      }
+    }
+    double max_smear{0.0};
+    int max_smear_idx{-1};
+    for (int i = 0, idx = candidates.min(); i < candidates.size();
+         ++i, idx = candidates.next(idx)) {
+      if (smears[idx] > max_smear) {
+        max_smear = smears[idx];
+        max_smear_idx = idx;
+      }
+    }
+    if (max_smear_idx < 0) {
+      // All the smear values are zero. Fall back to the max-diam strategy.
+      return FindMaxDiam(box, candidates).second;
+    }
+    return max_smear_idx;
+  }
+
+  unique_ptr<BranchingStrategy> Clone() const override {
+    return unique_ptr<BranchingStrategy>{new SmearBranchingStrategy{*this}};
+  }
+
+ private:
+  // Shared by the clones.
+  shared_ptr<const SmearConstraints> constraints_;
+  double precision_{};
+};
+
+}  // namespace
+
+shared_ptr<const SmearConstraint> MakeSmearConstraint(const Formula& formula) {
+  if (!is_relational(formula) &&
+      !(is_negation(formula) && is_relational(get_operand(formula)))) {
+    // We do not compute the smear values of forall constraints.
+    return nullptr;
+  }
+  const Expression f{ExtractExpression(formula)};
+  auto constraint = make_shared<SmearConstraint>(
+      SmearConstraint{ExpressionEvaluator{f}, {}});
+  for (const Variable& x : f.GetVariables()) {
+    try {
+      constraint->partials.emplace_back(
+          x, ExpressionEvaluator{f.Differentiate(x)});
+    } catch (const runtime_error& e) {
+      DREAL_LOG_DEBUG(
+          "MakeSmearConstraint: {} is not differentiable with respect to {}: "
+          "{}",
+          f, x, e.what());
+      constraint->partials.emplace_back(x, nullopt);
+    }
+  }
+  return constraint;
+}
+
+unique_ptr<BranchingStrategy> MakeBranchingStrategy(
+    const Config::BranchingHeuristic heuristic,
+    const vector<FormulaEvaluator>& formula_evaluators,
+    const double precision) {
+  SmearConstraints smear_constraints;
+  if (heuristic == Config::BranchingHeuristic::SMEAR) {
+    for (const FormulaEvaluator& formula_evaluator : formula_evaluators) {
+      shared_ptr<const SmearConstraint> constraint{
+          MakeSmearConstraint(formula_evaluator.formula())};
+      if (constraint) {
+        smear_constraints.push_back(move(constraint));
+      }
+    }
+  }
+  return MakeBranchingStrategy(heuristic, move(smear_constraints), precision);
+}
+
+unique_ptr<BranchingStrategy> MakeBranchingStrategy(
+    const Config::BranchingHeuristic heuristic,
+    SmearConstraints smear_constraints, const double precision) {
+  switch (heuristic) {
+    case Config::BranchingHeuristic::MAX_DIAM:
+      return unique_ptr<BranchingStrategy>{new MaxDiamBranchingStrategy{}};
+    case Config::BranchingHeuristic::ROUND_ROBIN:
+      return unique_ptr<BranchingStrategy>{new RoundRobinBranchingStrategy{}};
+    case Config::BranchingHeuristic::SMEAR:
+      return unique_ptr<BranchingStrategy>{
+          new SmearBranchingStrategy{move(smear_constraints), precision}};
+  }
+  DREAL_UNREACHABLE();
+}
+
+}  // namespace dreal
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include <experimental/optional>
+
+#include "./ibex.h"
+
+#include "dreal/solver/config.h"
+#include "dreal/solver/expression_evaluator.h"
+#include "dreal/solver/formula_evaluator.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+
+/// Interface of branching strategies in ICP. A branching strategy selects
+/// a dimension of a box to bisect.
+///
+/// A strategy may keep a mutable state. Each ICP worker should have its own
+/// strategy (see Clone()).
+class BranchingStrategy {
+ public:
+  BranchingStrategy() = default;
+  BranchingStrategy(const BranchingStrategy&) = default;
+  BranchingStrategy(BranchingStrategy&&) = default;
+  BranchingStrategy& operator=(const BranchingStrategy&) = default;
+  BranchingStrategy& operator=(BranchingStrategy&&) = default;
+  virtual ~BranchingStrategy() = default;
+
+  /// Selects a bisectable dimension of @p box among the ones enabled in @p
+  /// candidates.
+  ///
+  /// @returns the index of the selected dimension, or -1 if there is no
+  /// bisectable dimension.
+  /// @pre @p candidates is not empty.
+  virtual int Select(const Box& box, const ibex::BitSet& candidates) = 0;
+
+  /// Returns a copy of this strategy.
+  virtual std::unique_ptr<BranchingStrategy> Clone() const = 0;
+};
+
+/// Constraint used by the smear-based strategy. It is built from a
+/// relational formula `e₁ op e₂` or its negation.
+struct SmearConstraint {
+  /// f = e₁ - e₂.
+  ExpressionEvaluator f;
+  /// (x, ∂f/∂x) for each variable x in f. The partial derivative is nullopt
+  /// if f is not differentiable with respect to x. In that case, diam(x) is
+  /// used as the smear value.
+  std::vector<
+      std::pair<Variable, std::experimental::optional<ExpressionEvaluator>>>
+      partials;
+};
+
+/// Returns the smear constraint of @p formula. It returns nullptr if
+/// @p formula is not a relational formula or its negation.
+///
+/// @note It differentiates f with respect to each of its variables. A
+/// caller checking the same formula repeatedly should keep the result (see
+/// TheorySolver::Cache).
+std::shared_ptr<const SmearConstraint> MakeSmearConstraint(
+    const Formula& formula);
+
+/// Makes a branching strategy for @p heuristic. @p formula_evaluators and
+/// @p precision are used by the smear-based strategy to find the
+/// constraints which are not yet satisfied within the precision.
+std::unique_ptr<BranchingStrategy> MakeBranchingStrategy(
+    Config::BranchingHeuristic heuristic,
+    const std::vector<FormulaEvaluator>& formula_evaluators, double precision);
+
+/// Makes a branching strategy for @p heuristic. The smear-based strategy
+/// uses @p smear_constraints, which are shared by its clones.
+std::unique_ptr<BranchingStrategy> MakeBranchingStrategy(
+    Config::BranchingHeuristic heuristic,
+    std::vector<std::shared_ptr<const SmearConstraint>> smear_constraints,
+    double precision);
+
+}  // namespace dreal
@@ -1,6 +1,9 @@
 #include "dreal/solver/config.h"
 
 #include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "dreal/util/exception.h"
 
 namespace dreal {
 
@@ -22,6 +25,18 @@ OptionValue<bool>& Config::mutable_use_polytope_in_forall() {
   return use_polytope_in_forall_;
 }
 
+bool Config::use_shared_fwdbwd() const { return use_shared_fwdbwd_.get(); }
+OptionValue<bool>& Config::mutable_use_shared_fwdbwd() {
+  return use_shared_fwdbwd_;
+}
+
+bool Config::use_batched_evaluation() const {
+  return use_batched_evaluation_.get();
+}
+OptionValue<bool>& Config::mutable_use_batched_evaluation() {
+  return use_batched_evaluation_;
+}
+
 bool Config::use_worklist_fixpoint() const {
   return use_worklist_fixpoint_.get();
 }
@@ -29,17 +44,194 @@ OptionValue<bool>& Config::mutable_use_worklist_fixpoint() {
   return use_worklist_fixpoint_;
 }
 
+bool Config::use_adaptive_scheduling() const {
+  return use_adaptive_scheduling_.get();
+}
+OptionValue<bool>& Config::mutable_use_adaptive_scheduling() {
+  return use_adaptive_scheduling_;
+}
+
+double Config::propagation_threshold() const {
+  return propagation_threshold_.get();
+}
+OptionValue<double>& Config::mutable_propagation_threshold() {
+  return propagation_threshold_;
+}
+
+bool Config::use_trail_icp() const { return use_trail_icp_.get(); }
+OptionValue<bool>& Config::mutable_use_trail_icp() { return use_trail_icp_; }
+
+bool Config::use_icp_backjumping() const {
+  return use_icp_backjumping_.get();
+}
+OptionValue<bool>& Config::mutable_use_icp_backjumping() {
+  return use_icp_backjumping_;
+}
+
+int Config::icp_nogood_capacity() const { return icp_nogood_capacity_.get(); }
+OptionValue<int>& Config::mutable_icp_nogood_capacity() {
+  return icp_nogood_capacity_;
+}
+
+bool Config::use_incremental_icp() const { return use_incremental_icp_.get(); }
+OptionValue<bool>& Config::mutable_use_incremental_icp() {
+  return use_incremental_icp_;
+}
+
+bool Config::use_warm_start() const { return use_warm_start_.get(); }
+OptionValue<bool>& Config::mutable_use_warm_start() { return use_warm_start_; }
+
+bool Config::use_theory_propagation() const {
+  return use_theory_propagation_.get();
+}
+OptionValue<bool>& Config::mutable_use_theory_propagation() {
+  return use_theory_propagation_;
+}
+
+bool Config::use_explanation_minimizer() const {
+  return use_explanation_minimizer_.get();
+}
+OptionValue<bool>& Config::mutable_use_explanation_minimizer() {
+  return use_explanation_minimizer_;
+}
+
+int Config::explanation_minimizer_budget() const {
+  return explanation_minimizer_budget_.get();
+}
+OptionValue<int>& Config::mutable_explanation_minimizer_budget() {
+  return explanation_minimizer_budget_;
+}
+
+int Config::number_of_jobs() const { return number_of_jobs_.get(); }
+OptionValue<int>& Config::mutable_number_of_jobs() { return number_of_jobs_; }
+
+Config::BranchingHeuristic Config::branching_heuristic() const {
+  return branching_heuristic_.get();
+}
+OptionValue<Config::BranchingHeuristic>&
+Config::mutable_branching_heuristic() {
+  return branching_heuristic_;
+}
+
+Config::ExplorationOrder Config::exploration_order() const {
+  return exploration_order_.get();
+}
+OptionValue<Config::ExplorationOrder>& Config::mutable_exploration_order() {
+  return exploration_order_;
+}
+
+int Config::best_first_max_queue_size() const {
+  return best_first_max_queue_size_.get();
+}
+OptionValue<int>& Config::mutable_best_first_max_queue_size() {
+  return best_first_max_queue_size_;
+}
+
+Config::SatSolverBackend Config::sat_solver_backend() const {
+  return sat_solver_backend_.get();
+}
+OptionValue<Config::SatSolverBackend>& Config::mutable_sat_solver_backend() {
+  return sat_solver_backend_;
+}
+
+bool Config::use_portfolio() const { return use_portfolio_.get(); }
+OptionValue<bool>& Config::mutable_use_portfolio() { return use_portfolio_; }
+
+double Config::timeout() const { return timeout_.get(); }
+OptionValue<double>& Config::mutable_timeout() { return timeout_; }
+
+int Config::max_branchings() const { return max_branchings_.get(); }
+OptionValue<int>& Config::mutable_max_branchings() { return max_branchings_; }
+
+int Config::max_prunings() const { return max_prunings_.get(); }
+OptionValue<int>& Config::mutable_max_prunings() { return max_prunings_; }
+
+int Config::max_sat_calls() const { return max_sat_calls_.get(); }
+OptionValue<int>& Config::mutable_max_sat_calls() { return max_sat_calls_; }
+
+const CancellationToken& Config::cancellation_token() const {
+  return cancellation_token_;
+}
+CancellationToken& Config::mutable_cancellation_token() {
+  return cancellation_token_;
+}
+
+ostream& operator<<(ostream& os, const Config::BranchingHeuristic heuristic) {
+  switch (heuristic) {
+    case Config::BranchingHeuristic::MAX_DIAM:
+      return os << "max-diam";
+    case Config::BranchingHeuristic::ROUND_ROBIN:
+      return os << "round-robin";
+    case Config::BranchingHeuristic::SMEAR:
+      return os << "smear";
+  }
+  DREAL_UNREACHABLE();
+}
+
+ostream& operator<<(ostream& os, const Config::ExplorationOrder order) {
+  switch (order) {
+    case Config::ExplorationOrder::DEPTH_FIRST:
+      return os << "depth-first";
+    case Config::ExplorationOrder::BEST_FIRST:
+      return os << "best-first";
+  }
+  DREAL_UNREACHABLE();
+}
+
+ostream& operator<<(ostream& os, const Config::SatSolverBackend backend) {
+  switch (backend) {
+    case Config::SatSolverBackend::PICOSAT:
+      return os << "picosat";
+  }
+  DREAL_UNREACHABLE();
+}
+
 ostream& operator<<(ostream& os, const Config& config) {
   return os << fmt::format(
              "Config("
              "precision = {}, "
              "produce_model = {}, "
              "use_polytope = {}, "
-             "use_polytope_in_forall = {}"
-             "use_worklist_fixpoint = {}"
+             "use_polytope_in_forall = {}, "
+             "use_shared_fwdbwd = {}, "
+             "use_batched_evaluation = {}, "
+             "use_worklist_fixpoint = {}, "
+             "use_adaptive_scheduling = {}, "
+             "propagation_threshold = {}, "
+             "use_trail_icp = {}, "
+             "use_icp_backjumping = {}, "
+             "icp_nogood_capacity = {}, "
+             "use_incremental_icp = {}, "
+             "use_warm_start = {}, "
+             "use_theory_propagation = {}, "
+             "use_explanation_minimizer = {}, "
+             "explanation_minimizer_budget = {}, "
+             "number_of_jobs = {}, "
+             "branching_heuristic = {}, "
+             "exploration_order = {}, "
+             "best_first_max_queue_size = {}, "
+             "sat_solver_backend = {}, "
+             "use_portfolio = {}, "
+             "timeout = {}, "
+             "max_branchings = {}, "
+             "max_prunings = {}, "
+             "max_sat_calls = {}"
              ")",
              config.precision(), config.produce_models(), config.use_polytope(),
-             config.use_polytope_in_forall(), config.use_worklist_fixpoint());
+             config.use_polytope_in_forall(), config.use_shared_fwdbwd(),
+             config.use_batched_evaluation(),
+             config.use_worklist_fixpoint(),
+             config.use_adaptive_scheduling(), config.propagation_threshold(),
+             config.use_trail_icp(),
+             config.use_icp_backjumping(), config.icp_nogood_capacity(),
+             config.use_incremental_icp(),
+             config.use_warm_start(), config.use_theory_propagation(),
+             config.use_explanation_minimizer(),
+             config.explanation_minimizer_budget(), config.number_of_jobs(),
+             config.branching_heuristic(), config.exploration_order(),
+             config.best_first_max_queue_size(), config.sat_solver_backend(),
+             config.use_portfolio(), config.timeout(), config.max_branchings(),
+             config.max_prunings(), config.max_sat_calls());
 }
 
 }  // namespace dreal
@@ -1,12 +1,33 @@
 #pragma once
 #include <ostream>
 
+#include "dreal/util/cancellation_token.h"
 #include "dreal/util/option_value.h"
 
 namespace dreal {
 
 class Config {
  public:
+  /// Heuristics to select a branching dimension in ICP.
+  enum class BranchingHeuristic {
+    MAX_DIAM,     ///< The dimension with the largest diameter.
+    ROUND_ROBIN,  ///< The dimensions in turn.
+    SMEAR,        ///< The dimension with the largest smear value,
+                  ///< |∂f/∂x| · diam(x), over the constraints f.
+  };
+
+  /// Orders to explore the boxes in ICP.
+  enum class ExplorationOrder {
+    DEPTH_FIRST,  ///< The most recently branched box first.
+    BEST_FIRST,   ///< The box whose constraint evaluations are the closest
+                  ///< to satisfaction first.
+  };
+
+  /// SAT solvers used in the DPLL(T) loop.
+  enum class SatSolverBackend {
+    PICOSAT,  ///< PicoSAT.
+  };
+
   Config() = default;
   ~Config() = default;
 
@@ -34,12 +55,184 @@ class Config {
   /// Returns a mutable OptionValue for 'use_polytope_in_forall'.
   OptionValue<bool>& mutable_use_polytope_in_forall();
 
+  /// Returns whether it merges the non-quantified constraints sharing
+  /// variables into one forward/backward contractor, in which their
+  /// common subexpressions are evaluated once.
+  bool use_shared_fwdbwd() const;
+
+  /// Returns a mutable OptionValue for 'use_shared_fwdbwd'.
+  OptionValue<bool>& mutable_use_shared_fwdbwd();
+
+  /// Returns whether the ICP evaluates the two halves of a bisected box in
+  /// one batch and drops the halves refuted by the evaluation.
+  bool use_batched_evaluation() const;
+
+  /// Returns a mutable OptionValue for 'use_batched_evaluation'.
+  OptionValue<bool>& mutable_use_batched_evaluation();
+
   /// Returns whether it uses worklist-fixpoint algorithm.
   bool use_worklist_fixpoint() const;
 
   /// Returns a mutable OptionValue for 'use_worklist_fixpoint'.
   OptionValue<bool>& mutable_use_worklist_fixpoint();
 
+  /// Returns whether the fixpoint contractors order their contractors by
+  /// the measured effectiveness and temporarily skip the ineffective
+  /// ones.
+  bool use_adaptive_scheduling() const;
+
+  /// Returns a mutable OptionValue for 'use_adaptive_scheduling'.
+  OptionValue<bool>& mutable_use_adaptive_scheduling();
+
+  /// Returns the threshold of the worklist fixpoint. A change of a
+  /// variable wakes up the contractors depending on it only if a bound
+  /// moves by more than this ratio of the width of its interval.
+  double propagation_threshold() const;
+
+  /// Returns a mutable OptionValue for 'propagation_threshold'.
+  OptionValue<double>& mutable_propagation_threshold();
+
+  /// Returns whether the depth-first ICP keeps a single working box and
+  /// undoes its changes on backtracking, instead of storing boxes.
+  bool use_trail_icp() const;
+
+  /// Returns a mutable OptionValue for 'use_trail_icp'.
+  OptionValue<bool>& mutable_use_trail_icp();
+
+  /// Returns whether the depth-first ICP skips the sibling of a refuted
+  /// box when the refutation does not depend on the branching dimension.
+  /// It implies `use_trail_icp`.
+  bool use_icp_backjumping() const;
+
+  /// Returns a mutable OptionValue for 'use_icp_backjumping'.
+  OptionValue<bool>& mutable_use_icp_backjumping();
+
+  /// Returns the maximum number of refuted boxes (nogoods) which the ICP
+  /// with backjumping keeps and checks the later boxes against. Zero
+  /// disables the nogood store.
+  int icp_nogood_capacity() const;
+
+  /// Returns a mutable OptionValue for 'icp_nogood_capacity'.
+  OptionValue<int>& mutable_icp_nogood_capacity();
+
+  /// Returns whether the theory solver reuses the boxes pruned by the
+  /// theory literals shared with the previous theory checks.
+  bool use_incremental_icp() const;
+
+  /// Returns a mutable OptionValue for 'use_incremental_icp'.
+  OptionValue<bool>& mutable_use_incremental_icp();
+
+  /// Returns whether the ICP first explores the branches containing the
+  /// model of the previous delta-SAT check of a context.
+  bool use_warm_start() const;
+
+  /// Returns a mutable OptionValue for 'use_warm_start'.
+  OptionValue<bool>& mutable_use_warm_start();
+
+  /// Returns whether the theory solver propagates the theory literals
+  /// implied by the pruned boxes to the SAT solver.
+  bool use_theory_propagation() const;
+
+  /// Returns a mutable OptionValue for 'use_theory_propagation'.
+  OptionValue<bool>& mutable_use_theory_propagation();
+
+  /// Returns whether the theory solver minimizes the explanations of
+  /// UNSAT results before they are learned by the SAT solver.
+  bool use_explanation_minimizer() const;
+
+  /// Returns a mutable OptionValue for 'use_explanation_minimizer'.
+  OptionValue<bool>& mutable_use_explanation_minimizer();
+
+  /// Returns the maximum number of refutation checks which the
+  /// explanation minimizer runs for an explanation.
+  int explanation_minimizer_budget() const;
+
+  /// Returns a mutable OptionValue for 'explanation_minimizer_budget'.
+  OptionValue<int>& mutable_explanation_minimizer_budget();
+
+  /// Returns the number of parallel jobs used in ICP.
+  int number_of_jobs() const;
+
+  /// Returns a mutable OptionValue for 'number_of_jobs'.
+  OptionValue<int>& mutable_number_of_jobs();
+
+  /// Returns the branching heuristic used in ICP.
+  BranchingHeuristic branching_heuristic() const;
+
+  /// Returns a mutable OptionValue for 'branching_heuristic'.
+  OptionValue<BranchingHeuristic>& mutable_branching_heuristic();
+
+  /// Returns the order to explore the boxes in ICP.
+  ///
+  /// @note The parallel ICP (`number_of_jobs` > 1) always explores the
+  /// boxes in depth-first order.
+  ExplorationOrder exploration_order() const;
+
+  /// Returns a mutable OptionValue for 'exploration_order'.
+  OptionValue<ExplorationOrder>& mutable_exploration_order();
+
+  /// Returns the maximum number of boxes in the priority queue of the
+  /// best-first exploration. When the queue is full, ICP explores the new
+  /// boxes in depth-first order until it runs out of them.
+  int best_first_max_queue_size() const;
+
+  /// Returns a mutable OptionValue for 'best_first_max_queue_size'.
+  OptionValue<int>& mutable_best_first_max_queue_size();
+
+  /// Returns the SAT solver used in the DPLL(T) loop.
+  SatSolverBackend sat_solver_backend() const;
+
+  /// Returns a mutable OptionValue for 'sat_solver_backend'.
+  OptionValue<SatSolverBackend>& mutable_sat_solver_backend();
+
+  /// Returns whether it runs a portfolio of differently configured
+  /// solvers and takes the first result.
+  ///
+  /// @note The portfolio mode is not incremental. The solvers are built
+  /// from scratch in each CheckSat call, so they do not keep the clauses
+  /// learned in the previous calls.
+  bool use_portfolio() const;
+
+  /// Returns a mutable OptionValue for 'use_portfolio'.
+  OptionValue<bool>& mutable_use_portfolio();
+
+  /// Returns the time limit (in seconds) of a CheckSat call. Zero
+  /// means no limit.
+  double timeout() const;
+
+  /// Returns a mutable OptionValue for 'timeout'.
+  OptionValue<double>& mutable_timeout();
+
+  /// Returns the maximum number of branching operations in a CheckSat
+  /// call. Zero means no limit.
+  int max_branchings() const;
+
+  /// Returns a mutable OptionValue for 'max_branchings'.
+  OptionValue<int>& mutable_max_branchings();
+
+  /// Returns the maximum number of pruning operations in a CheckSat
+  /// call. Zero means no limit.
+  int max_prunings() const;
+
+  /// Returns a mutable OptionValue for 'max_prunings'.
+  OptionValue<int>& mutable_max_prunings();
+
+  /// Returns the maximum number of SAT-solver calls in a CheckSat
+  /// call. Zero means no limit.
+  int max_sat_calls() const;
+
+  /// Returns a mutable OptionValue for 'max_sat_calls'.
+  OptionValue<int>& mutable_max_sat_calls();
+
+  /// Returns the cancellation token. A solver using this config stops as
+  /// soon as possible when the token is cancelled.
+  ///
+  /// @note Copies of a config share the same token.
+  const CancellationToken& cancellation_token() const;
+
+  /// Returns a mutable cancellation token.
+  CancellationToken& mutable_cancellation_token();
+
  private:
   // NOTE: Make sure to match the default values specified here with the ones
   // specified in dreal/dreal.cc.
@@ -47,8 +240,42 @@ class Config {
   OptionValue<bool> produce_models_{false};
   OptionValue<bool> use_polytope_{false};
   OptionValue<bool> use_polytope_in_forall_{false};
+  OptionValue<bool> use_shared_fwdbwd_{false};
+  OptionValue<bool> use_batched_evaluation_{false};
   OptionValue<bool> use_worklist_fixpoint_{false};
+  OptionValue<bool> use_adaptive_scheduling_{false};
+  OptionValue<double> propagation_threshold_{0.0};
+  OptionValue<bool> use_trail_icp_{false};
+  OptionValue<bool> use_icp_backjumping_{false};
+  OptionValue<int> icp_nogood_capacity_{0};
+  OptionValue<bool> use_incremental_icp_{false};
+  OptionValue<bool> use_warm_start_{false};
+  OptionValue<bool> use_theory_propagation_{false};
+  OptionValue<bool> use_explanation_minimizer_{false};
+  OptionValue<int> explanation_minimizer_budget_{100};
+  OptionValue<int> number_of_jobs_{1};
+  OptionValue<BranchingHeuristic> branching_heuristic_{
+      BranchingHeuristic::MAX_DIAM};
+  OptionValue<ExplorationOrder> exploration_order_{
+      ExplorationOrder::DEPTH_FIRST};
+  OptionValue<int> best_first_max_queue_size_{100000};
+  OptionValue<SatSolverBackend> sat_solver_backend_{
+      SatSolverBackend::PICOSAT};
+  OptionValue<bool> use_portfolio_{false};
+  OptionValue<double> timeout_{0.0};
+  OptionValue<int> max_branchings_{0};
+  OptionValue<int> max_prunings_{0};
+  OptionValue<int> max_sat_calls_{0};
+
+  CancellationToken cancellation_token_;
 };
 
+std::ostream& operator<<(std::ostream& os,
+                         Config::BranchingHeuristic heuristic);
+
+std::ostream& operator<<(std::ostream& os, Config::ExplorationOrder order);
+
+std::ostream& operator<<(std::ostream& os, Config::SatSolverBackend backend);
+
 std::ostream& operator<<(std::ostream& os, const Config& config);
 }  // namespace dreal
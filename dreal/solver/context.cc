@@ -1,28 +1,46 @@
 #include "dreal/solver/context.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <exception>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <sstream>
+#include <thread>
 #include <unordered_set>
 
 #include "dreal/solver/assertion_filter.h"
+#include "dreal/solver/resource_monitor.h"
 #include "dreal/solver/sat_solver.h"
 #include "dreal/solver/theory_solver.h"
 #include "dreal/util/assert.h"
+#include "dreal/util/cancellation_token.h"
 #include "dreal/util/exception.h"
 #include "dreal/util/logging.h"
 #include "dreal/util/scoped_vector.h"
 
+using std::any_of;
+using std::chrono::duration;
+using std::chrono::duration_cast;
+using std::exception_ptr;
 using std::experimental::optional;
 using std::isfinite;
+using std::lock_guard;
+using std::make_unique;
 using std::move;
+using std::mutex;
 using std::numeric_limits;
+using std::ostream;
 using std::ostringstream;
 using std::pair;
 using std::set;
 using std::string;
+using std::thread;
+using std::unique_ptr;
 using std::unordered_set;
 using std::vector;
 
@@ -35,7 +53,7 @@ class Context::Impl {
   ~Impl() { DREAL_LOG_DEBUG("Context::Impl::~Impl()"); }
   explicit Impl(Config config);
   void Assert(const Formula& f);
-  std::experimental::optional<Box> CheckSat();
+  SatCheckResult CheckSat(Box* model);
   void DeclareVariable(const Variable& v);
   void DeclareVariable(const Variable& v, const Expression& lb,
                        const Expression& ub);
@@ -55,6 +73,37 @@ class Context::Impl {
  private:
   Box& box() { return boxes_.last(); }
 
+  // Adds the formulas in `stack_` which are not in `sat_solver_` yet.
+  void AddPendingAssertions();
+
+  // Runs the DPLL(T) loop with @p config. The formulas in `stack_` should
+  // be added to `sat_solver_` before calling this method.
+  SatCheckResult CheckSatCore(const Config& config,
+                              ResourceMonitor* resource_monitor, Box* model);
+
+  // Runs CheckSatCore with the precisions in @p precisions in order. As
+  // UNSAT results do not depend on the precision, it returns as soon as one
+  // of them is UNSAT. After a delta-SAT result under a coarse precision, it
+  // runs CheckSatCore again from scratch with the next precision. Only the
+  // clauses learned by `sat_solver_` are kept between the runs.
+  //
+  // @pre The last element of @p precisions is `config.precision()`.
+  SatCheckResult CheckSatWithPrecisionSchedule(
+      const Config& config, const std::vector<double>& precisions,
+      ResourceMonitor* resource_monitor, Box* model);
+
+  // Runs differently configured solvers on threads and returns the result of
+  // the solver which finishes first. The other solvers are cancelled.
+  //
+  // The solvers are built from the assertions in `stack_` in each call and
+  // dropped at the end of it. So the portfolio mode is not incremental: the
+  // clauses learned and the contractors built in a call are not used in the
+  // next one. Only `last_model_` is passed to the solvers, for the warm
+  // start.
+  SatCheckResult CheckSatPortfolio(const Config& config,
+                                   ResourceMonitor* resource_monitor,
+                                   Box* model);
+
   Config config_;
   std::experimental::optional<Logic> logic_{};
   std::unordered_map<std::string, Variable> name_to_var_map_;
@@ -64,11 +113,24 @@ class Context::Impl {
   ScopedVector<Box> boxes_;  // Stack of boxes. The top one is the current box.
   ScopedVector<Formula> stack_;  // Stack of asserted formulas.
   SatSolver sat_solver_;
+  // Number of the formulas in `stack_` which are added to `sat_solver_`.
+  // They are the first ones in `stack_`.
+  size_t num_added_assertions_{0};
+
+  // Model of the last delta-SAT check. It is used to warm-start the next
+  // check when `config_.use_warm_start()` is true.
+  std::experimental::optional<Box> last_model_;
+
+  // Contractors and formula evaluators built by the theory solvers. They
+  // are reused by the following CheckSat calls, which may have different
+  // domains set by SetInterval.
+  TheorySolver::Cache theory_solver_cache_;
 };
 
 Context::Impl::Impl() { boxes_.push_back(Box{}); }
 
-Context::Impl::Impl(Config config) : config_{move(config)} {
+Context::Impl::Impl(Config config)
+    : config_{move(config)}, sat_solver_{config_} {
   boxes_.push_back(Box{});
 }
 
@@ -79,26 +141,94 @@ void Context::Impl::Assert(const Formula& f) {
   stack_.push_back(f);
 }
 
-optional<Box> Context::Impl::CheckSat() {
+SatCheckResult Context::Impl::CheckSat(Box* const model) {
   DREAL_LOG_DEBUG("Context::CheckSat()");
   DREAL_LOG_TRACE("Context::CheckSat: Box =\n{}", box());
+  DREAL_ASSERT(model);
   if (box().empty()) {
-    return {};
+    return SatCheckResult::UNSAT;
   }
   // If false ∈ stack_, it's UNSAT.
   for (const auto& f : stack_.get_vector()) {
     if (is_false(f)) {
-      return {};
+      return SatCheckResult::UNSAT;
     }
   }
   // If stack_ = ∅ or stack_ = {true}, it's trivially SAT.
   if (stack_.empty() || (stack_.size() == 1 && is_true(stack_.first()))) {
-    return box();
+    *model = box();
+    return SatCheckResult::DELTA_SAT;
   }
-  sat_solver_.AddFormulas(stack_.get_vector());
 
-  TheorySolver theory_solver{config_, box()};
+  // Set up the cancellation token and the resource limits of this call. The
+  // token is a child of the one in config_, so that a user can cancel the
+  // call with the token in config_.
+  Config config{config_};
+  const CancellationToken cancellation_token{
+      config_.cancellation_token().MakeChild()};
+  if (config_.timeout() > 0.0) {
+    cancellation_token.set_deadline(
+        CancellationToken::Clock::now() +
+        duration_cast<CancellationToken::Clock::duration>(
+            duration<double>{config_.timeout()}));
+  }
+  config.mutable_cancellation_token() = cancellation_token;
+  ResourceMonitor resource_monitor{config, cancellation_token};
+
+  bool use_portfolio{config.use_portfolio()};
+  // Forall formulas are handled by nested contexts which are not safe to
+  // run concurrently. We fall back to the sequential mode in that case.
+  if (use_portfolio &&
+      any_of(stack_.begin(), stack_.end(),
+             [](const Formula& f) { return is_forall(f); })) {
+    DREAL_LOG_DEBUG(
+        "Context::CheckSat() - Portfolio mode is disabled due to forall "
+        "formulas.");
+    use_portfolio = false;
+  }
+  if (!use_portfolio) {
+    AddPendingAssertions();
+  }
+  const SatCheckResult result{
+      use_portfolio ? CheckSatPortfolio(config, &resource_monitor, model)
+                    : CheckSatCore(config, &resource_monitor, model)};
+  if (result == SatCheckResult::DELTA_SAT) {
+    last_model_ = *model;
+  }
+  return result;
+}
+
+void Context::Impl::AddPendingAssertions() {
+  DREAL_LOG_DEBUG("Context::AddPendingAssertions() # of new assertions = {}",
+                  stack_.size() - num_added_assertions_);
+  for (; num_added_assertions_ < stack_.size(); ++num_added_assertions_) {
+    const Formula& f{stack_[num_added_assertions_]};
+    // CheckSat() returns UNSAT without the SAT solver while false is in
+    // `stack_`.
+    if (!is_false(f)) {
+      sat_solver_.AddFormula(f);
+    }
+  }
+}
+
+SatCheckResult Context::Impl::CheckSatCore(
+    const Config& config, ResourceMonitor* const resource_monitor,
+    Box* const model) {
+  const CancellationToken& cancellation_token{config.cancellation_token()};
+  TheorySolver theory_solver{config, box(), resource_monitor,
+                             &theory_solver_cache_};
+  if (config.use_warm_start() && last_model_) {
+    theory_solver.set_warm_start_model(*last_model_);
+  }
+  if (config.use_shared_fwdbwd()) {
+    theory_solver.set_theory_predicates(sat_solver_.theory_predicates());
+  }
   while (true) {
+    resource_monitor->AddSatCall();
+    if (cancellation_token.is_cancelled()) {
+      DREAL_LOG_DEBUG("Context::CheckSat() - Cancelled");
+      return SatCheckResult::UNKNOWN;
+    }
     const auto optional_model = sat_solver_.CheckSat();
     if (optional_model) {
       const vector<pair<Variable, bool>>& boolean_model{optional_model->first};
@@ -115,11 +245,17 @@ optional<Box> Context::Impl::CheckSat() {
           assertions.push_back(p.second ? sat_solver_.theory_literal(p.first)
                                         : !sat_solver_.theory_literal(p.first));
         }
-        if (theory_solver.CheckSat(box(), assertions)) {
+        const bool theory_result{theory_solver.CheckSat(box(), assertions)};
+        if (cancellation_token.is_cancelled()) {
+          // The result of a cancelled theory solver is meaningless.
+          DREAL_LOG_DEBUG("Context::CheckSat() - Cancelled");
+          return SatCheckResult::UNKNOWN;
+        }
+        if (theory_result) {
           // SAT from TheorySolver.
           DREAL_LOG_DEBUG("Context::CheckSat() - Theroy Check = delta-SAT");
-          const Box model{theory_solver.GetModel()};
-          return model;
+          *model = theory_solver.GetModel();
+          return SatCheckResult::DELTA_SAT;
         } else {
           // UNSAT from TheorySolver.
           DREAL_LOG_DEBUG("Context::CheckSat() - Theroy Check = UNSAT");
@@ -131,22 +267,169 @@ optional<Box> Context::Impl::CheckSat() {
               "size = {}",
               explanation.size(), stack_.get_vector().size());
           sat_solver_.AddLearnedClause(explanation);
+          if (config.use_theory_propagation()) {
+            const TheorySolver::Propagation propagation{
+                theory_solver.Propagate(sat_solver_.theory_predicates())};
+            for (const Formula& literal : propagation.literals) {
+              sat_solver_.AddTheoryPropagation(propagation.reason, literal);
+            }
+          }
         }
       } else {
-        return box();
+        *model = box();
+        return SatCheckResult::DELTA_SAT;
       }
     } else {
       // UNSAT from SATSolver. Escape the loop.
       DREAL_LOG_DEBUG("Context::CheckSat() - Sat Check = UNSAT");
-      return {};
+      return SatCheckResult::UNSAT;
+    }
+  }
+}
+
+SatCheckResult Context::Impl::CheckSatWithPrecisionSchedule(
+    const Config& config, const vector<double>& precisions,
+    ResourceMonitor* const resource_monitor, Box* const model) {
+  DREAL_ASSERT(!precisions.empty());
+  DREAL_ASSERT(precisions.back() == config.precision());
+  SatCheckResult result{SatCheckResult::UNKNOWN};
+  for (const double precision : precisions) {
+    Config config_i{config};
+    config_i.mutable_precision() = precision;
+    DREAL_LOG_DEBUG("Context::CheckSatWithPrecisionSchedule() precision = {}",
+                    precision);
+    result = CheckSatCore(config_i, resource_monitor, model);
+    if (result != SatCheckResult::DELTA_SAT) {
+      // UNSAT or UNKNOWN.
+      break;
     }
   }
+  return result;
+}
+
+namespace {
+// A solver in the portfolio mode, a configuration and a precision schedule.
+struct PortfolioEntry {
+  Config config;
+  vector<double> precisions;
+};
+
+// Derives the portfolio from @p config. The solvers in the portfolio share
+// @p cancellation_token.
+vector<PortfolioEntry> MakePortfolio(
+    const Config& config, const CancellationToken& cancellation_token) {
+  Config base{config};
+  base.mutable_use_portfolio() = false;
+  // The solvers already run in parallel.
+  base.mutable_number_of_jobs() = 1;
+  base.mutable_cancellation_token() = cancellation_token;
+  const double precision{base.precision()};
+
+  vector<PortfolioEntry> portfolio;
+  // 1. The given configuration.
+  portfolio.push_back({base, {precision}});
+  // 2. Toggle polytope contractor.
+  portfolio.push_back({base, {precision}});
+  portfolio.back().config.mutable_use_polytope() = !base.use_polytope();
+  // 3. Toggle worklist fixpoint algorithm.
+  portfolio.push_back({base, {precision}});
+  portfolio.back().config.mutable_use_worklist_fixpoint() =
+      !base.use_worklist_fixpoint();
+  // 4. Start with coarse precisions and refine them.
+  portfolio.push_back({base, {precision * 100, precision * 10, precision}});
+  // 5. Use a different branching heuristic.
+  portfolio.push_back({base, {precision}});
+  portfolio.back().config.mutable_branching_heuristic() =
+      base.branching_heuristic() == Config::BranchingHeuristic::SMEAR
+          ? Config::BranchingHeuristic::MAX_DIAM
+          : Config::BranchingHeuristic::SMEAR;
+  return portfolio;
+}
+}  // namespace
+
+SatCheckResult Context::Impl::CheckSatPortfolio(
+    const Config& config, ResourceMonitor* const resource_monitor,
+    Box* const model) {
+  // The token is cancelled when one of the solvers finishes, or when the
+  // token of this call is cancelled.
+  const CancellationToken cancellation_token{
+      config.cancellation_token().MakeChild()};
+  const vector<PortfolioEntry> portfolio{
+      MakePortfolio(config, cancellation_token)};
+  const int num_solvers = portfolio.size();
+  DREAL_LOG_DEBUG("Context::CheckSatPortfolio() # of solvers = {}",
+                  num_solvers);
+
+  // We set up the solvers in this thread because the CNF conversion in
+  // SatSolver::AddFormulas creates new variables, which is not thread-safe.
+  vector<unique_ptr<Impl>> solvers;
+  solvers.reserve(num_solvers);
+  for (const PortfolioEntry& entry : portfolio) {
+    solvers.push_back(make_unique<Impl>(entry.config));
+    Impl& solver{*solvers.back()};
+    solver.box() = box();
+    solver.last_model_ = last_model_;
+    for (const Formula& f : stack_) {
+      solver.stack_.push_back(f);
+    }
+    solver.AddPendingAssertions();
+  }
+
+  mutex result_mutex;
+  int winner{-1};
+  SatCheckResult result{SatCheckResult::UNKNOWN};
+  exception_ptr exception;
+  vector<thread> threads;
+  threads.reserve(num_solvers);
+  for (int i = 0; i < num_solvers; ++i) {
+    threads.emplace_back([&, i]() {
+      try {
+        Box solver_model;
+        const SatCheckResult solver_result{
+            solvers[i]->CheckSatWithPrecisionSchedule(
+                portfolio[i].config, portfolio[i].precisions,
+                resource_monitor, &solver_model)};
+        if (solver_result == SatCheckResult::UNKNOWN) {
+          // Cancelled.
+          return;
+        }
+        lock_guard<mutex> lock{result_mutex};
+        if (winner < 0) {
+          winner = i;
+          result = solver_result;
+          *model = move(solver_model);
+          cancellation_token.Cancel();
+        }
+      } catch (...) {
+        lock_guard<mutex> lock{result_mutex};
+        if (!exception) {
+          exception = std::current_exception();
+        }
+      }
+    });
+  }
+  for (thread& t : threads) {
+    t.join();
+  }
+  if (winner < 0) {
+    if (exception) {
+      // All the solvers failed.
+      std::rethrow_exception(exception);
+    }
+    DREAL_LOG_DEBUG("Context::CheckSatPortfolio() Cancelled");
+    return SatCheckResult::UNKNOWN;
+  }
+  DREAL_LOG_DEBUG("Context::CheckSatPortfolio() Solver {} wins. {}", winner,
+                  portfolio[winner].config);
+  return result;
 }
 
 void Context::Impl::DeclareVariable(const Variable& v) {
   DREAL_LOG_DEBUG("Context::DeclareVariable({})", v);
   name_to_var_map_.emplace(v.get_name(), v);
   box().Add(v);
+  // The cached contractors are built for the previous set of variables.
+  theory_solver_cache_.contractors.clear();
 }
 
 void Context::Impl::DeclareVariable(const Variable& v, const Expression& lb,
@@ -207,14 +490,25 @@ void Context::Impl::Pop() {
   stack_.pop();
   boxes_.pop();
   sat_solver_.Pop();
+  // All the formulas in `stack_` were added before the matching Push().
+  num_added_assertions_ = stack_.size();
+  theory_solver_cache_.contractors.pop();
+  theory_solver_cache_.formula_evaluators.pop();
+  theory_solver_cache_.smear_constraints.pop();
 }
 
 void Context::Impl::Push() {
   DREAL_LOG_DEBUG("Context::Push()");
+  // The pending assertions belong to the current scope. Add them before
+  // opening a new scope so that they outlive it in `sat_solver_`.
+  AddPendingAssertions();
   sat_solver_.Push();
   boxes_.push();
   boxes_.push_back(boxes_.last());
   stack_.push();
+  theory_solver_cache_.contractors.push();
+  theory_solver_cache_.formula_evaluators.push();
+  theory_solver_cache_.smear_constraints.push();
 }
 
 namespace {
@@ -294,7 +588,23 @@ Context::Context(Config config) : impl_{new Impl{move(config)}} {}
 
 void Context::Assert(const Formula& f) { impl_->Assert(f); }
 
-optional<Box> Context::CheckSat() { return impl_->CheckSat(); }
+optional<Box> Context::CheckSat() {
+  Box model;
+  switch (impl_->CheckSat(&model)) {
+    case SatCheckResult::DELTA_SAT:
+      return model;
+    case SatCheckResult::UNSAT:
+      return {};
+    case SatCheckResult::UNKNOWN:
+      throw DREAL_RUNTIME_ERROR(
+          "Context::CheckSat() is cancelled or exceeds its resource limits.");
+  }
+  DREAL_UNREACHABLE();
+}
+
+SatCheckResult Context::CheckSat(Box* const model) {
+  return impl_->CheckSat(model);
+}
 
 void Context::DeclareVariable(const Variable& v) { impl_->DeclareVariable(v); }
 
@@ -365,4 +675,16 @@ Config& Context::mutable_config() { return impl_->mutable_config(); }
 
 string Context::version() { return DREAL_VERSION_STRING; }
 
+ostream& operator<<(ostream& os, const SatCheckResult result) {
+  switch (result) {
+    case SatCheckResult::DELTA_SAT:
+      return os << "delta-sat";
+    case SatCheckResult::UNSAT:
+      return os << "unsat";
+    case SatCheckResult::UNKNOWN:
+      return os << "unknown";
+  }
+  DREAL_UNREACHABLE();
+}
+
 }  // namespace dreal
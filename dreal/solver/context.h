@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <ostream>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -15,6 +16,15 @@
 
 namespace dreal {
 
+/// Result of Context::CheckSat.
+enum class SatCheckResult {
+  DELTA_SAT,  ///< There is a delta-satisfying model.
+  UNSAT,      ///< There is no model.
+  UNKNOWN,    ///< The check is cancelled or hits one of its resource limits.
+};
+
+std::ostream& operator<<(std::ostream& os, SatCheckResult result);
+
 /// TODO(soonho): add documentation.
 class Context {
  public:
@@ -28,8 +38,22 @@ class Context {
   void Assert(const Formula& f);
 
   /// Checks the satisfiability of the asserted formulas.
+  ///
+  /// @throws std::runtime_error if the result is unknown. It happens when
+  /// the cancellation token in the config is cancelled or one of the
+  /// resource limits in the config is exceeded. Use CheckSat(Box*) to
+  /// handle the unknown result.
   std::experimental::optional<Box> CheckSat();
 
+  /// Checks the satisfiability of the asserted formulas. When it returns
+  /// SatCheckResult::DELTA_SAT, a model is saved in @p model.
+  ///
+  /// It returns SatCheckResult::UNKNOWN, instead of running forever, if
+  /// the cancellation token in the config is cancelled, or one of the
+  /// limits (timeout, max_branchings, max_prunings, and max_sat_calls) in
+  /// the config is exceeded.
+  SatCheckResult CheckSat(Box* model);
+
   /// Declare a variable @p v.
   void DeclareVariable(const Variable& v);
 
@@ -1,103 +1,31 @@
 #include "dreal/solver/expression_evaluator.h"
 
 #include <algorithm>  // to suppress cpplint for the use of 'min'
-#include <numeric>
+#include <limits>
+#include <unordered_map>
 #include <utility>
 
 #include "dreal/util/assert.h"
 #include "dreal/util/exception.h"
+#include "dreal/util/interval_kernels.h"
 #include "dreal/util/logging.h"
 #include "dreal/util/math.h"
 
 namespace dreal {
 
-using std::accumulate;
+using std::atomic;
+using std::copy;
+using std::fill;
+using std::memory_order_relaxed;
 using std::move;
+using std::numeric_limits;
 using std::pair;
+using std::unordered_map;
+using std::vector;
 
-ExpressionEvaluator::ExpressionEvaluator(Expression e) : e_{move(e)} {}
-
-Box::Interval ExpressionEvaluator::operator()(const Box& box) const {
-  return Visit(e_, box);
-}
-
-Box::Interval ExpressionEvaluator::Visit(const Expression& e,
-                                         const Box& box) const {
-  return VisitExpression<Box::Interval>(this, e, box);
-}
-
-Box::Interval ExpressionEvaluator::VisitVariable(const Expression& e,
-                                                 const Box& box) const {
-  const Variable& var{get_variable(e)};
-  return box[var];
-}
-
-Box::Interval ExpressionEvaluator::VisitConstant(const Expression& e,
-                                                 const Box&) const {
-  const double c{get_constant_value(e)};
-  return Box::Interval{c};
-}
-
-Box::Interval ExpressionEvaluator::VisitAddition(const Expression& e,
-                                                 const Box& box) const {
-  const double c{get_constant_in_addition(e)};
-  const auto& expr_to_coeff_map = get_expr_to_coeff_map_in_addition(e);
-  return accumulate(expr_to_coeff_map.begin(), expr_to_coeff_map.end(),
-                    ibex::Interval{c},
-                    [this, &box](const Box::Interval init,
-                                 const pair<Expression, double>& p) {
-                      return init + Visit(p.first, box) * p.second;
-                    });
-}
-
-Box::Interval ExpressionEvaluator::VisitMultiplication(const Expression& e,
-                                                       const Box& box) const {
-  const double c{get_constant_in_multiplication(e)};
-  const auto& base_to_exponent_map =
-      get_base_to_exponent_map_in_multiplication(e);
-  return accumulate(base_to_exponent_map.begin(), base_to_exponent_map.end(),
-                    ibex::Interval{c},
-                    [this, &box](const Box::Interval init,
-                                 const pair<Expression, Expression>& p) {
-                      return init * VisitPow(p.first, p.second, box);
-                    });
-}
-
-Box::Interval ExpressionEvaluator::VisitDivision(const Expression& e,
-                                                 const Box& box) const {
-  return Visit(get_first_argument(e), box) / Visit(get_second_argument(e), box);
-}
-
-Box::Interval ExpressionEvaluator::VisitLog(const Expression& e,
-                                            const Box& box) const {
-  return log(Visit(get_argument(e), box));
-}
-
-Box::Interval ExpressionEvaluator::VisitAbs(const Expression& e,
-                                            const Box& box) const {
-  return abs(Visit(get_argument(e), box));
-}
-
-Box::Interval ExpressionEvaluator::VisitExp(const Expression& e,
-                                            const Box& box) const {
-  return exp(Visit(get_argument(e), box));
-}
-
-Box::Interval ExpressionEvaluator::VisitSqrt(const Expression& e,
-                                             const Box& box) const {
-  return sqrt(Visit(get_argument(e), box));
-}
-
-Box::Interval ExpressionEvaluator::VisitPow(const Expression& e,
-                                            const Box& box) const {
-  return VisitPow(get_first_argument(e), get_second_argument(e), box);
-}
-
-Box::Interval ExpressionEvaluator::VisitPow(const Expression& e1,
-                                            const Expression& e2,
-                                            const Box& box) const {
-  const Box::Interval first{Visit(e1, box)};
-  const Box::Interval second{Visit(e2, box)};
+namespace {
+// Evaluates `pow(first, second)`.
+Box::Interval Pow(const Box::Interval& first, const Box::Interval& second) {
   if (second.is_degenerated() && !second.is_empty()) {
     // This indicates that this interval is a point.
     DREAL_ASSERT(second.lb() == second.ub());
@@ -116,77 +44,332 @@ Box::Interval ExpressionEvaluator::VisitPow(const Expression& e1,
   }
 }
 
-Box::Interval ExpressionEvaluator::VisitSin(const Expression& e,
-                                            const Box& box) const {
-  return sin(Visit(get_argument(e), box));
+// Returns [lb, ub]. It is empty if lb is NaN. See BoxBatch.
+Box::Interval MakeInterval(const double lb, const double ub) {
+  // NaN is not equal to itself.
+  if (lb != lb) {
+    return Box::Interval::EMPTY_SET;
+  }
+  return Box::Interval{lb, ub};
 }
 
-Box::Interval ExpressionEvaluator::VisitCos(const Expression& e,
-                                            const Box& box) const {
-  return cos(Visit(get_argument(e), box));
+// Stores @p iv into @p lb and @p ub in the layout of BoxBatch.
+void StoreInterval(const Box::Interval& iv, double* const lb,
+                   double* const ub) {
+  if (iv.is_empty()) {
+    *lb = numeric_limits<double>::quiet_NaN();
+    *ub = numeric_limits<double>::quiet_NaN();
+  } else {
+    *lb = iv.lb();
+    *ub = iv.ub();
+  }
 }
+}  // namespace
+
+class ExpressionEvaluator::TapeBuilder {
+ public:
+  TapeBuilder(vector<Variable>* const variables,
+              vector<Instruction>* const tape)
+      : variables_{variables}, tape_{tape} {}
+
+  // Appends the instructions computing @p e to the tape and returns the
+  // register holding its value. A subexpression which has been built
+  // already is not built again.
+  int Build(const Expression& e) {
+    const auto it = registers_.find(e);
+    if (it != registers_.end()) {
+      return it->second;
+    }
+    const int reg{VisitExpression<int>(this, e)};
+    registers_.emplace(e, reg);
+    return reg;
+  }
 
-Box::Interval ExpressionEvaluator::VisitTan(const Expression& e,
-                                            const Box& box) const {
-  return tan(Visit(get_argument(e), box));
-}
+  int VisitVariable(const Expression& e) {
+    variables_->push_back(get_variable(e));
+    return Emit(Opcode::VARIABLE, variables_->size() - 1);
+  }
 
-Box::Interval ExpressionEvaluator::VisitAsin(const Expression& e,
-                                             const Box& box) const {
-  return asin(Visit(get_argument(e), box));
-}
+  int VisitConstant(const Expression& e) {
+    return Emit(Opcode::CONSTANT, -1, -1, get_constant_value(e));
+  }
 
-Box::Interval ExpressionEvaluator::VisitAcos(const Expression& e,
-                                             const Box& box) const {
-  return acos(Visit(get_argument(e), box));
-}
+  int VisitAddition(const Expression& e) {
+    // c₀ + c₁e₁ + ... + cₙeₙ is computed from left to right.
+    int reg{Build(Expression{get_constant_in_addition(e)})};
+    for (const pair<Expression, double>& p :
+         get_expr_to_coeff_map_in_addition(e)) {
+      reg = Emit(Opcode::ADD_SCALED, reg, Build(p.first), p.second);
+    }
+    return reg;
+  }
 
-Box::Interval ExpressionEvaluator::VisitAtan(const Expression& e,
-                                             const Box& box) const {
-  return atan(Visit(get_argument(e), box));
-}
+  int VisitMultiplication(const Expression& e) {
+    // c₀ * b₁^e₁ * ... * bₙ^eₙ is computed from left to right.
+    int reg{Build(Expression{get_constant_in_multiplication(e)})};
+    for (const pair<Expression, Expression>& p :
+         get_base_to_exponent_map_in_multiplication(e)) {
+      reg = Emit(Opcode::MUL, reg, BuildPow(p.first, p.second));
+    }
+    return reg;
+  }
 
-Box::Interval ExpressionEvaluator::VisitAtan2(const Expression& e,
-                                              const Box& box) const {
-  return atan2(Visit(get_first_argument(e), box),
-               Visit(get_second_argument(e), box));
-}
+  int VisitDivision(const Expression& e) { return EmitBinary(Opcode::DIV, e); }
+  int VisitLog(const Expression& e) { return EmitUnary(Opcode::LOG, e); }
+  int VisitAbs(const Expression& e) { return EmitUnary(Opcode::ABS, e); }
+  int VisitExp(const Expression& e) { return EmitUnary(Opcode::EXP, e); }
+  int VisitSqrt(const Expression& e) { return EmitUnary(Opcode::SQRT, e); }
+  int VisitPow(const Expression& e) {
+    return BuildPow(get_first_argument(e), get_second_argument(e));
+  }
+  int VisitSin(const Expression& e) { return EmitUnary(Opcode::SIN, e); }
+  int VisitCos(const Expression& e) { return EmitUnary(Opcode::COS, e); }
+  int VisitTan(const Expression& e) { return EmitUnary(Opcode::TAN, e); }
+  int VisitAsin(const Expression& e) { return EmitUnary(Opcode::ASIN, e); }
+  int VisitAcos(const Expression& e) { return EmitUnary(Opcode::ACOS, e); }
+  int VisitAtan(const Expression& e) { return EmitUnary(Opcode::ATAN, e); }
+  int VisitAtan2(const Expression& e) {
+    return EmitBinary(Opcode::ATAN2, e);
+  }
+  int VisitSinh(const Expression& e) { return EmitUnary(Opcode::SINH, e); }
+  int VisitCosh(const Expression& e) { return EmitUnary(Opcode::COSH, e); }
+  int VisitTanh(const Expression& e) { return EmitUnary(Opcode::TANH, e); }
+  int VisitMin(const Expression& e) { return EmitBinary(Opcode::MIN, e); }
+  int VisitMax(const Expression& e) { return EmitBinary(Opcode::MAX, e); }
+
+  // If-then-else and uninterpreted functions are not supported. They are
+  // compiled into instructions which throw when they are evaluated.
+  int VisitIfThenElse(const Expression&) {
+    return Emit(Opcode::IF_THEN_ELSE);
+  }
+  int VisitUninterpretedFunction(const Expression&) {
+    return Emit(Opcode::UNINTERPRETED_FUNCTION);
+  }
 
-Box::Interval ExpressionEvaluator::VisitSinh(const Expression& e,
-                                             const Box& box) const {
-  return sinh(Visit(get_argument(e), box));
-}
+ private:
+  int Emit(const Opcode op, const int arg1 = -1, const int arg2 = -1,
+           const double c = 0.0) {
+    tape_->push_back(Instruction{op, arg1, arg2, c});
+    return tape_->size() - 1;
+  }
+
+  int EmitUnary(const Opcode op, const Expression& e) {
+    return Emit(op, Build(get_argument(e)));
+  }
+
+  int EmitBinary(const Opcode op, const Expression& e) {
+    const int arg1{Build(get_first_argument(e))};
+    const int arg2{Build(get_second_argument(e))};
+    return Emit(op, arg1, arg2);
+  }
+
+  // Appends the instructions computing `pow(e1, e2)`. A constant exponent
+  // is specialized here instead of being checked at each evaluation.
+  int BuildPow(const Expression& e1, const Expression& e2) {
+    const int base{Build(e1)};
+    if (!is_constant(e2)) {
+      return Emit(Opcode::POW, base, Build(e2));
+    }
+    const double point{get_constant_value(e2)};
+    if (!is_integer(point)) {
+      return Emit(Opcode::POW_REAL, base, -1, point);
+    }
+    if (point == 1.0) {
+      return base;
+    }
+    if (point == 2.0) {
+      return Emit(Opcode::SQR, base);
+    }
+    return Emit(Opcode::POW_INT, base, static_cast<int>(point));
+  }
+
+  vector<Variable>* const variables_;
+  vector<Instruction>* const tape_;
+
+  // Map from a subexpression to the register holding its value.
+  unordered_map<Expression, int, hash_value<Expression>> registers_;
+};
 
-Box::Interval ExpressionEvaluator::VisitCosh(const Expression& e,
-                                             const Box& box) const {
-  return cosh(Visit(get_argument(e), box));
+ExpressionEvaluator::ExpressionEvaluator(Expression e) : e_{move(e)} {
+  TapeBuilder{&variables_, &tape_}.Build(e_);
+  index_hints_.reset(new atomic<int>[variables_.size()]);
+  for (size_t i = 0; i < variables_.size(); ++i) {
+    index_hints_[i].store(-1, memory_order_relaxed);
+  }
+  DREAL_LOG_TRACE("ExpressionEvaluator: {} is compiled into {} instructions",
+                  e_, tape_.size());
 }
 
-Box::Interval ExpressionEvaluator::VisitTanh(const Expression& e,
-                                             const Box& box) const {
-  return tanh(Visit(get_argument(e), box));
+ExpressionEvaluator::ExpressionEvaluator(const ExpressionEvaluator& other)
+    : e_{other.e_},
+      variables_{other.variables_},
+      index_hints_{new atomic<int>[other.variables_.size()]},
+      tape_{other.tape_} {
+  for (size_t i = 0; i < variables_.size(); ++i) {
+    index_hints_[i].store(other.index_hints_[i].load(memory_order_relaxed),
+                          memory_order_relaxed);
+  }
 }
 
-Box::Interval ExpressionEvaluator::VisitMin(const Expression& e,
-                                            const Box& box) const {
-  return min(Visit(get_first_argument(e), box),
-             Visit(get_second_argument(e), box));
+template <typename Boxes>
+int ExpressionEvaluator::VariableIndex(const Boxes& boxes, const int i) const {
+  const Variable& var{variables_[i]};
+  const vector<Variable>& box_variables{boxes.variables()};
+  int idx{index_hints_[i].load(memory_order_relaxed)};
+  if (idx < 0 || idx >= static_cast<int>(box_variables.size()) ||
+      !box_variables[idx].equal_to(var)) {
+    // The box has a new layout.
+    idx = boxes.index(var);
+    index_hints_[i].store(idx, memory_order_relaxed);
+  }
+  return idx;
 }
 
-Box::Interval ExpressionEvaluator::VisitMax(const Expression& e,
-                                            const Box& box) const {
-  return max(Visit(get_first_argument(e), box),
-             Visit(get_second_argument(e), box));
+template <typename Registers>
+Box::Interval ExpressionEvaluator::Apply(const Instruction& inst,
+                                         const Registers& r) {
+  switch (inst.op) {
+    case Opcode::CONSTANT:
+    case Opcode::VARIABLE:
+      // They are handled by the callers.
+      DREAL_UNREACHABLE();
+    case Opcode::ADD_SCALED:
+      return r(inst.arg1) + r(inst.arg2) * inst.c;
+    case Opcode::MUL:
+      return r(inst.arg1) * r(inst.arg2);
+    case Opcode::DIV:
+      return r(inst.arg1) / r(inst.arg2);
+    case Opcode::POW:
+      return Pow(r(inst.arg1), r(inst.arg2));
+    case Opcode::POW_INT:
+      return pow(r(inst.arg1), inst.arg2);
+    case Opcode::POW_REAL:
+      return pow(r(inst.arg1), inst.c);
+    case Opcode::SQR:
+      return sqr(r(inst.arg1));
+    case Opcode::LOG:
+      return log(r(inst.arg1));
+    case Opcode::ABS:
+      return abs(r(inst.arg1));
+    case Opcode::EXP:
+      return exp(r(inst.arg1));
+    case Opcode::SQRT:
+      return sqrt(r(inst.arg1));
+    case Opcode::SIN:
+      return sin(r(inst.arg1));
+    case Opcode::COS:
+      return cos(r(inst.arg1));
+    case Opcode::TAN:
+      return tan(r(inst.arg1));
+    case Opcode::ASIN:
+      return asin(r(inst.arg1));
+    case Opcode::ACOS:
+      return acos(r(inst.arg1));
+    case Opcode::ATAN:
+      return atan(r(inst.arg1));
+    case Opcode::ATAN2:
+      return atan2(r(inst.arg1), r(inst.arg2));
+    case Opcode::SINH:
+      return sinh(r(inst.arg1));
+    case Opcode::COSH:
+      return cosh(r(inst.arg1));
+    case Opcode::TANH:
+      return tanh(r(inst.arg1));
+    case Opcode::MIN:
+      return min(r(inst.arg1), r(inst.arg2));
+    case Opcode::MAX:
+      return max(r(inst.arg1), r(inst.arg2));
+    case Opcode::IF_THEN_ELSE:
+      throw DREAL_RUNTIME_ERROR(
+          "If-then-else expression is not supported yet.");
+    case Opcode::UNINTERPRETED_FUNCTION:
+      throw DREAL_RUNTIME_ERROR("Uninterpreted function is not supported.");
+  }
+  DREAL_UNREACHABLE();
 }
 
-Box::Interval ExpressionEvaluator::VisitIfThenElse(const Expression&,
-                                                   const Box&) const {
-  throw DREAL_RUNTIME_ERROR("If-then-else expression is not supported yet.");
+Box::Interval ExpressionEvaluator::operator()(const Box& box) const {
+  // Registers of the tape. It is thread-local so that an evaluator can be
+  // shared by threads without allocating them at each call.
+  thread_local vector<Box::Interval> r;
+  if (r.size() < tape_.size()) {
+    r.resize(tape_.size());
+  }
+  const auto registers = [](const int i) -> const Box::Interval& {
+    return r[i];
+  };
+  for (size_t i = 0; i < tape_.size(); ++i) {
+    const Instruction& inst{tape_[i]};
+    switch (inst.op) {
+      case Opcode::CONSTANT:
+        r[i] = Box::Interval{inst.c};
+        break;
+      case Opcode::VARIABLE:
+        r[i] = box[VariableIndex(box, inst.arg1)];
+        break;
+      default:
+        r[i] = Apply(inst, registers);
+    }
+  }
+  return r[tape_.size() - 1];
 }
 
-Box::Interval ExpressionEvaluator::VisitUninterpretedFunction(
-    const Expression&, const Box&) const {
-  throw DREAL_RUNTIME_ERROR("Uninterpreted function is not supported.");
+vector<Box::Interval> ExpressionEvaluator::operator()(
+    const BoxBatch& batch) const {
+  // Registers of the tape in the layout of BoxBatch. The k-th lane of the
+  // i-th register is [lb[i * n + k], ub[i * n + k]].
+  thread_local vector<double> lb;
+  thread_local vector<double> ub;
+  const int n{batch.size()};
+  const size_t num_lanes{tape_.size() * n};
+  if (lb.size() < num_lanes) {
+    lb.resize(num_lanes);
+    ub.resize(num_lanes);
+  }
+  for (size_t i = 0; i < tape_.size(); ++i) {
+    const Instruction& inst{tape_[i]};
+    double* const lb_i{&lb[i * n]};
+    double* const ub_i{&ub[i * n]};
+    switch (inst.op) {
+      case Opcode::CONSTANT:
+        fill(lb_i, lb_i + n, inst.c);
+        fill(ub_i, ub_i + n, inst.c);
+        break;
+      case Opcode::VARIABLE: {
+        const int idx{VariableIndex(batch, inst.arg1)};
+        copy(batch.lb(idx), batch.lb(idx) + n, lb_i);
+        copy(batch.ub(idx), batch.ub(idx) + n, ub_i);
+        break;
+      }
+      case Opcode::ADD_SCALED:
+        AddScaled(n, &lb[inst.arg1 * n], &ub[inst.arg1 * n],
+                  &lb[inst.arg2 * n], &ub[inst.arg2 * n], inst.c, lb_i, ub_i);
+        break;
+      case Opcode::MUL:
+        Mul(n, &lb[inst.arg1 * n], &ub[inst.arg1 * n], &lb[inst.arg2 * n],
+            &ub[inst.arg2 * n], lb_i, ub_i);
+        break;
+      case Opcode::SQR:
+        Sqr(n, &lb[inst.arg1 * n], &ub[inst.arg1 * n], lb_i, ub_i);
+        break;
+      default:
+        // Falls back to the scalar operation for each box.
+        for (int k = 0; k < n; ++k) {
+          const auto registers = [k, n](const int j) {
+            return MakeInterval(lb[j * n + k], ub[j * n + k]);
+          };
+          StoreInterval(Apply(inst, registers), &lb_i[k], &ub_i[k]);
+        }
+    }
+  }
+  vector<Box::Interval> results;
+  results.reserve(n);
+  const double* const lb_last{&lb[(tape_.size() - 1) * n]};
+  const double* const ub_last{&ub[(tape_.size() - 1) * n]};
+  for (int k = 0; k < n; ++k) {
+    results.push_back(MakeInterval(lb_last[k], ub_last[k]));
+  }
+  return results;
 }
 
 std::ostream& operator<<(std::ostream& os,
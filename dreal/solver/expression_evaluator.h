@@ -1,64 +1,135 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <ostream>
+#include <vector>
 
 #include "./ibex.h"
 
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
+#include "dreal/util/box_batch.h"
 
 namespace dreal {
 
+/// Evaluates an expression over a box using interval arithmetic.
+///
+/// At construction, it compiles the expression into a tape, a sequence of
+/// interval instructions in topological order. Common subexpressions are
+/// shared, and each variable is loaded from a box only once per
+/// evaluation. The evaluation runs over the tape in a single loop.
+///
+/// A variable is loaded by its index in a box. The index is looked up
+/// by the variable when the evaluator meets a box of a new layout, and is
+/// reused while the following boxes have the variable at the same index.
+///
+/// It also evaluates the expression over a batch of boxes. Then each
+/// instruction runs over all the boxes before the next one. Additions,
+/// multiplications, and squares use the vector kernels in
+/// interval_kernels.h. The other operations are evaluated box by box as in
+/// the scalar evaluation.
 class ExpressionEvaluator {
  public:
   explicit ExpressionEvaluator(Expression e);
 
+  /// Copy constructor. The copy starts with the indices known to
+  /// @p other.
+  ExpressionEvaluator(const ExpressionEvaluator& other);
+
+  /// Move constructor.
+  ExpressionEvaluator(ExpressionEvaluator&& other) = default;
+
+  /// Deleted copy-assignment operator.
+  ExpressionEvaluator& operator=(const ExpressionEvaluator&) = delete;
+
+  /// Deleted move-assignment operator.
+  ExpressionEvaluator& operator=(ExpressionEvaluator&&) = delete;
+
+  ~ExpressionEvaluator() = default;
+
   /// Evaluates the expression with @p box.
   Box::Interval operator()(const Box& box) const;
 
+  /// Evaluates the expression with each box in @p batch. The k-th element
+  /// of the result is the evaluation with the k-th box.
+  std::vector<Box::Interval> operator()(const BoxBatch& batch) const;
+
   Variables variables() const { return e_.GetVariables(); }
 
+  /// Returns the number of instructions in the tape.
+  int tape_size() const { return tape_.size(); }
+
  private:
-  Box::Interval Visit(const Expression& e, const Box& box) const;
-  Box::Interval VisitVariable(const Expression& e, const Box& box) const;
-  Box::Interval VisitConstant(const Expression& e, const Box& box) const;
-  Box::Interval VisitAddition(const Expression& e, const Box& box) const;
-  Box::Interval VisitMultiplication(const Expression& e, const Box& box) const;
-  Box::Interval VisitDivision(const Expression& e, const Box& box) const;
-  Box::Interval VisitLog(const Expression& e, const Box& box) const;
-  Box::Interval VisitAbs(const Expression& e, const Box& box) const;
-  Box::Interval VisitExp(const Expression& e, const Box& box) const;
-  Box::Interval VisitSqrt(const Expression& e, const Box& box) const;
-  Box::Interval VisitPow(const Expression& e, const Box& box) const;
-
-  // Evaluates `pow(e1, e2)` with the @p box.
-  Box::Interval VisitPow(const Expression& e1, const Expression& e2,
-                         const Box& box) const;
-  Box::Interval VisitSin(const Expression& e, const Box& box) const;
-  Box::Interval VisitCos(const Expression& e, const Box& box) const;
-  Box::Interval VisitTan(const Expression& e, const Box& box) const;
-  Box::Interval VisitAsin(const Expression& e, const Box& box) const;
-  Box::Interval VisitAcos(const Expression& e, const Box& box) const;
-  Box::Interval VisitAtan(const Expression& e, const Box& box) const;
-  Box::Interval VisitAtan2(const Expression& e, const Box& box) const;
-  Box::Interval VisitSinh(const Expression& e, const Box& box) const;
-  Box::Interval VisitCosh(const Expression& e, const Box& box) const;
-  Box::Interval VisitTanh(const Expression& e, const Box& box) const;
-  Box::Interval VisitMin(const Expression& e, const Box& box) const;
-  Box::Interval VisitMax(const Expression& e, const Box& box) const;
-  Box::Interval VisitIfThenElse(const Expression& e, const Box& box) const;
-  Box::Interval VisitUninterpretedFunction(const Expression& e,
-                                           const Box& box) const;
-
-  // Makes VisitExpression a friend of this class so that it can use private
-  // operator()s.
-  friend Box::Interval drake::symbolic::VisitExpression<Box::Interval>(
-      const ExpressionEvaluator*, const Expression&, const Box&);
+  // Operation codes of the instructions in a tape.
+  enum class Opcode {
+    CONSTANT,    // c
+    VARIABLE,    // box[variables_[arg1]]
+    ADD_SCALED,  // r[arg1] + r[arg2] * c
+    MUL,         // r[arg1] * r[arg2]
+    DIV,         // r[arg1] / r[arg2]
+    POW,         // pow(r[arg1], r[arg2])
+    POW_INT,     // pow(r[arg1], arg2)
+    POW_REAL,    // pow(r[arg1], c)
+    SQR,         // sqr(r[arg1])
+    LOG,
+    ABS,
+    EXP,
+    SQRT,
+    SIN,
+    COS,
+    TAN,
+    ASIN,
+    ACOS,
+    ATAN,
+    ATAN2,  // atan2(r[arg1], r[arg2])
+    SINH,
+    COSH,
+    TANH,
+    MIN,  // min(r[arg1], r[arg2])
+    MAX,  // max(r[arg1], r[arg2])
+    IF_THEN_ELSE,
+    UNINTERPRETED_FUNCTION,
+  };
+
+  // The i-th instruction of a tape computes the value of the i-th register
+  // from the constant `c` and the registers `arg1` and `arg2`, which are
+  // smaller than i. Unary operations only use `arg1`.
+  struct Instruction {
+    Opcode op;
+    int arg1;
+    int arg2;
+    double c;
+  };
+
+  // Compiles an expression into a tape. It is defined in the .cc file.
+  class TapeBuilder;
+
+  // Returns the index of variables_[i] in @p boxes, a Box or a BoxBatch.
+  template <typename Boxes>
+  int VariableIndex(const Boxes& boxes, int i) const;
+
+  // Computes the result of @p inst other than CONSTANT and VARIABLE. The
+  // i-th register is given by `r(i)`.
+  template <typename Registers>
+  static Box::Interval Apply(const Instruction& inst, const Registers& r);
 
   friend std::ostream& operator<<(
       std::ostream& os, const ExpressionEvaluator& expression_evaluator);
 
   const Expression e_;
+
+  // Variables loaded by the VARIABLE instructions.
+  std::vector<Variable> variables_;
+
+  // index_hints_[i] is the index of variables_[i] in the last box or batch
+  // it was loaded from, or -1. A load checks that the box has variables_[i] at
+  // the index before using it. An evaluator may be shared by threads, so
+  // the hints are atomic.
+  std::unique_ptr<std::atomic<int>[]> index_hints_;
+
+  // The last instruction computes the value of `e_`.
+  std::vector<Instruction> tape_;
 };
 
 std::ostream& operator<<(std::ostream& os,
@@ -1,8 +1,8 @@
 #include "dreal/solver/forall_formula_evaluator.h"
 
+#include <limits>
 #include <set>
 #include <utility>
-#include <experimental/optional>
 
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/assert.h"
@@ -11,8 +11,8 @@
 
 namespace dreal {
 
-using std::experimental::optional;
 using std::move;
+using std::numeric_limits;
 using std::ostream;
 using std::set;
 using std::vector;
@@ -41,13 +41,15 @@ vector<RelationalFormulaEvaluator> BuildFormulaEvaluators(const Formula& f) {
 
 }  // namespace
 
-ForallFormulaEvaluator::ForallFormulaEvaluator(Formula f, const double epsilon,
-                                               const double delta)
+ForallFormulaEvaluator::ForallFormulaEvaluator(
+    Formula f, const double epsilon, const double delta,
+    const CancellationToken& cancellation_token)
     : FormulaEvaluatorCell{move(f)},
       evaluators_{BuildFormulaEvaluators(formula())} {
   DREAL_ASSERT(is_forall(formula()));
   DREAL_LOG_DEBUG("ForallFormulaEvaluator({})", formula());
   context_.mutable_config().mutable_precision() = delta;
+  context_.mutable_config().mutable_cancellation_token() = cancellation_token;
   for (const Variable& exist_var : formula().GetFreeVariables()) {
     context_.DeclareVariable(exist_var);
   }
@@ -66,17 +68,27 @@ FormulaEvaluationResult ForallFormulaEvaluator::operator()(
   for (const Variable& v : box.variables()) {
     context_.SetInterval(v, box[v].lb(), box[v].ub());
   }
-  optional<Box> counterexample = context_.CheckSat();
+  Box counterexample;
+  const SatCheckResult result{context_.CheckSat(&counterexample)};
   DREAL_LOG_DEBUG("ForallFormulaEvaluator::operator({})", box);
-  if (counterexample) {
+  if (result == SatCheckResult::UNKNOWN) {
+    // The nested context is cancelled. We do not know whether there is a
+    // counterexample. Return an unbounded error so that it is not regarded
+    // as a delta-solution.
+    DREAL_LOG_DEBUG("ForallFormulaEvaluator::operator()  --  Cancelled");
+    return FormulaEvaluationResult{
+        FormulaEvaluationResult::Type::UNKNOWN,
+        Box::Interval(0.0, numeric_limits<double>::infinity())};
+  }
+  if (result == SatCheckResult::DELTA_SAT) {
     DREAL_LOG_DEBUG("ForallFormulaEvaluator::operator()  --  CE found: ",
-                    *counterexample);
+                    counterexample);
     for (const Variable& exist_var : box.variables()) {
-      (*counterexample)[exist_var] = box[exist_var];
+      counterexample[exist_var] = box[exist_var];
     }
     double max_diam = 0.0;
     for (const RelationalFormulaEvaluator& evaluator : evaluators_) {
-      const FormulaEvaluationResult eval_result = evaluator(*counterexample);
+      const FormulaEvaluationResult eval_result = evaluator(counterexample);
       if (eval_result.type() == FormulaEvaluationResult::Type::UNSAT) {
         continue;
       }
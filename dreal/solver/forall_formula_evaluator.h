@@ -37,12 +37,16 @@ namespace dreal {
 ///
 class ForallFormulaEvaluator : public FormulaEvaluatorCell {
  public:
-  ForallFormulaEvaluator(Formula f, double epsilon, double delta);
+  ForallFormulaEvaluator(Formula f, double epsilon, double delta,
+                         const CancellationToken& cancellation_token);
 
   ~ForallFormulaEvaluator() override;
 
   FormulaEvaluationResult operator()(const Box& box) const override;
 
+  // A batch is evaluated box by box.
+  using FormulaEvaluatorCell::operator();
+
   std::ostream& Display(std::ostream& os) const override;
 
   Variables variables() const override;
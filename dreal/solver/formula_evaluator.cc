@@ -55,6 +55,11 @@ FormulaEvaluationResult FormulaEvaluator::operator()(const Box& box) const {
   return (*ptr_)(box);
 }
 
+vector<FormulaEvaluationResult> FormulaEvaluator::operator()(
+    const BoxBatch& batch) const {
+  return (*ptr_)(batch);
+}
+
 Variables FormulaEvaluator::variables() const { return ptr_->variables(); }
 
 const Formula& FormulaEvaluator::formula() const { return ptr_->formula(); }
@@ -67,12 +72,12 @@ FormulaEvaluator make_relational_formula_evaluator(const Formula& f) {
   return FormulaEvaluator{make_shared<RelationalFormulaEvaluator>(f)};
 }
 
-FormulaEvaluator make_forall_formula_evaluator(const Formula& f,
-                                               const double epsilon,
-                                               const double delta) {
+FormulaEvaluator make_forall_formula_evaluator(
+    const Formula& f, const double epsilon, const double delta,
+    const CancellationToken& cancellation_token) {
   DREAL_ASSERT(is_forall(f));
-  return FormulaEvaluator{
-      make_shared<ForallFormulaEvaluator>(f, epsilon, delta)};
+  return FormulaEvaluator{make_shared<ForallFormulaEvaluator>(
+      f, epsilon, delta, cancellation_token)};
 }
 
 }  // namespace dreal
@@ -6,6 +6,8 @@
 
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
+#include "dreal/util/box_batch.h"
+#include "dreal/util/cancellation_token.h"
 #include "dreal/util/logging.h"
 
 namespace dreal {
@@ -65,6 +67,10 @@ class FormulaEvaluator {
   /// Evaluates the constraint/formula with @p box.
   FormulaEvaluationResult operator()(const Box& box) const;
 
+  /// Evaluates the constraint/formula with each box in @p batch. The k-th
+  /// element of the result is the evaluation with the k-th box.
+  std::vector<FormulaEvaluationResult> operator()(const BoxBatch& batch) const;
+
   /// Returns the occurred variables in the formula.
   Variables variables() const;
 
@@ -81,18 +87,20 @@ class FormulaEvaluator {
 
   friend FormulaEvaluator make_relational_formula_evaluator(const Formula& f);
 
-  friend FormulaEvaluator make_forall_formula_evaluator(const Formula& f,
-                                                        double epsilon,
-                                                        double delta);
+  friend FormulaEvaluator make_forall_formula_evaluator(
+      const Formula& f, double epsilon, double delta,
+      const CancellationToken& cancellation_token);
 };
 
 /// Creates FormulaEvaluator for a relational formula @p f using @p variables.
 FormulaEvaluator make_relational_formula_evaluator(const Formula& f);
 
 /// Creates FormulaEvaluator for a univerally quantified formula @p f
-/// using @p variables, @p epsilon, and @p delta.
-FormulaEvaluator make_forall_formula_evaluator(const Formula& f, double epsilon,
-                                               double delta);
+/// using @p variables, @p epsilon, and @p delta. The nested context to find
+/// counterexamples stops when @p cancellation_token is cancelled.
+FormulaEvaluator make_forall_formula_evaluator(
+    const Formula& f, double epsilon, double delta,
+    const CancellationToken& cancellation_token);
 
 std::ostream& operator<<(std::ostream& os, const FormulaEvaluator& evaluator);
 
@@ -5,7 +5,18 @@
 namespace dreal {
 
 using std::move;
+using std::vector;
 
 FormulaEvaluatorCell::FormulaEvaluatorCell(Formula f) : f_{move(f)} {}
 
+vector<FormulaEvaluationResult> FormulaEvaluatorCell::operator()(
+    const BoxBatch& batch) const {
+  vector<FormulaEvaluationResult> results;
+  results.reserve(batch.size());
+  for (int k = 0; k < batch.size(); ++k) {
+    results.push_back((*this)(batch.box(k)));
+  }
+  return results;
+}
+
 }  // namespace dreal
@@ -6,6 +6,7 @@
 
 #include "dreal/solver/formula_evaluator.h"
 #include "dreal/util/box.h"
+#include "dreal/util/box_batch.h"
 
 namespace dreal {
 
@@ -21,6 +22,11 @@ class FormulaEvaluatorCell {
   /// Evaluates the constraint/formula with @p box.
   virtual FormulaEvaluationResult operator()(const Box& box) const = 0;
 
+  /// Evaluates the constraint/formula with each box in @p batch. By
+  /// default, it evaluates the boxes one by one.
+  virtual std::vector<FormulaEvaluationResult> operator()(
+      const BoxBatch& batch) const;
+
   virtual Variables variables() const = 0;
 
   virtual std::ostream& Display(std::ostream& os) const = 0;
@@ -1,91 +1,338 @@
 #include "dreal/solver/icp.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <ostream>
 #include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "dreal/util/assert.h"
+#include "dreal/util/box_batch.h"
 #include "dreal/util/logging.h"
 
+using std::atomic;
 using std::cout;
 using std::experimental::nullopt;
 using std::experimental::optional;
 using std::make_pair;
+using std::pop_heap;
+using std::push_heap;
 using std::move;
 using std::pair;
 using std::tie;
+using std::unique_ptr;
+using std::unordered_map;
 using std::unordered_set;
 using std::vector;
 
 namespace dreal {
 
 namespace {
-/// Finds the dimension with the maximum diameter in a @p box. It only
-/// consider the dimensions enabled in @p bitset.
+// Stores the intervals of boxes over the same variables in a flat array,
+// together with the flags of the constraints entailed by the boxes. A box
+// occupies a slot of `dimension` consecutive intervals and
+// `num_constraints` consecutive flags. The slots of the loaded boxes are
+// recycled. Therefore, once it has as many slots as the maximum number of
+// boxes alive in a search, storing and loading a box does not allocate
+// memory.
+class BoxSlab {
+ public:
+  BoxSlab(const int dimension, const int num_constraints)
+      : dimension_{dimension}, num_constraints_{num_constraints} {}
+
+  // Stores the box and the entailment flags of @p cs and returns its slot.
+  // If @p i is not negative, the i-th interval of the stored box is @p iv
+  // instead of box[i].
+  int Store(const ContractorStatus& cs, const int i,
+            const Box::Interval& iv) {
+    const Box& box{cs.box()};
+    const vector<bool>& entailed{cs.entailed()};
+    DREAL_ASSERT(box.size() == dimension_);
+    DREAL_ASSERT(static_cast<int>(entailed.size()) == num_constraints_);
+    int slot{0};
+    if (free_slots_.empty()) {
+      slot = intervals_.size() / dimension_;
+      intervals_.resize(intervals_.size() + dimension_);
+      entailed_.resize(entailed_.size() + num_constraints_);
+    } else {
+      slot = free_slots_.back();
+      free_slots_.pop_back();
+    }
+    Box::Interval* const intervals{&intervals_[slot * dimension_]};
+    for (int j = 0; j < dimension_; ++j) {
+      intervals[j] = box[j];
+    }
+    if (i >= 0) {
+      intervals[i] = iv;
+    }
+    for (int j = 0; j < num_constraints_; ++j) {
+      entailed_[slot * num_constraints_ + j] = entailed[j];
+    }
+    return slot;
+  }
+
+  // Loads the box and the entailment flags at @p slot into @p cs and
+  // releases the slot.
+  //
+  // @pre The box of @p cs has the variables of the boxes stored in this
+  // slab.
+  void Load(const int slot, ContractorStatus* const cs) {
+    DREAL_ASSERT(cs->box().size() == dimension_);
+    const Box::Interval* const intervals{&intervals_[slot * dimension_]};
+    Box::IntervalVector& iv{cs->mutable_box().mutable_interval_vector()};
+    for (int j = 0; j < dimension_; ++j) {
+      iv[j] = intervals[j];
+    }
+    vector<bool>& entailed{cs->mutable_entailed()};
+    for (int j = 0; j < num_constraints_; ++j) {
+      entailed[j] = entailed_[slot * num_constraints_ + j];
+    }
+    free_slots_.push_back(slot);
+  }
+
+ private:
+  const int dimension_;
+  const int num_constraints_;
+  vector<Box::Interval> intervals_;
+  vector<bool> entailed_;
+  vector<int> free_slots_;
+};
+
+// Boxes to explore, paired with the branching points which produced them.
+// All the boxes have the variables of the box given to the constructor.
+// Their intervals and entailment flags are kept in a BoxSlab.
+//
+// In the depth-first order, it is a stack. In the best-first order, it
+// keeps the boxes in a priority queue ordered by their scores, where a
+// smaller score is better. Ties are broken in favor of the box pushed
+// later, which is the deeper one. When the queue is full, new boxes go to a
+// stack, which is popped before the queue. That is, it falls back to the
+// depth-first search until the stack becomes empty.
+class BoxFrontier {
+ public:
+  BoxFrontier(const ContractorStatus& cs, const Config::ExplorationOrder order,
+              const int max_queue_size)
+      : slab_{cs.box().size(), static_cast<int>(cs.entailed().size())},
+        order_{order},
+        max_queue_size_{max_queue_size} {}
+
+  bool empty() const { return stack_.empty() && queue_.empty(); }
+
+  // Pushes the box of @p cs.
+  void Push(const ContractorStatus& cs, const int branching_point,
+            const double score) {
+    PushSlot(slab_.Store(cs, -1, Box::Interval{}), branching_point, score);
+  }
+
+  // Pushes a copy of the box of @p cs whose @p branching_point -th
+  // interval is @p iv.
+  void Push(const ContractorStatus& cs, const int branching_point,
+            const Box::Interval& iv, const double score) {
+    PushSlot(slab_.Store(cs, branching_point, iv), branching_point, score);
+  }
+
+  // Pops a box and writes it, with its entailment flags, to @p cs. Returns
+  // its branching point.
+  //
+  // @pre The frontier is not empty.
+  int Pop(ContractorStatus* const cs) {
+    DREAL_ASSERT(!empty());
+    int slot{0};
+    int branching_point{0};
+    if (!stack_.empty()) {
+      tie(slot, branching_point) = stack_.back();
+      stack_.pop_back();
+    } else {
+      pop_heap(queue_.begin(), queue_.end(), IsWorse);
+      slot = queue_.back().slot;
+      branching_point = queue_.back().branching_point;
+      queue_.pop_back();
+    }
+    slab_.Load(slot, cs);
+    return branching_point;
+  }
+
+ private:
+  struct Entry {
+    double score;
+    int64_t order;  // The number of boxes pushed before this one.
+    int slot;       // Slot in `slab_`.
+    int branching_point;
+  };
+
+  void PushSlot(const int slot, const int branching_point,
+                const double score) {
+    if (order_ == Config::ExplorationOrder::DEPTH_FIRST ||
+        static_cast<int>(queue_.size()) >= max_queue_size_) {
+      stack_.emplace_back(slot, branching_point);
+      return;
+    }
+    queue_.push_back(Entry{score, num_pushed_++, slot, branching_point});
+    push_heap(queue_.begin(), queue_.end(), IsWorse);
+  }
+
+  // Returns true if @p e1 should be explored after @p e2.
+  static bool IsWorse(const Entry& e1, const Entry& e2) {
+    if (e1.score != e2.score) {
+      return e1.score > e2.score;
+    }
+    return e1.order < e2.order;
+  }
+
+  BoxSlab slab_;
+  const Config::ExplorationOrder order_;
+  const int max_queue_size_;
+  vector<pair<int, int>> stack_;  // Pairs of (slot, branching point).
+  vector<Entry> queue_;           // Heap ordered by IsWorse.
+  int64_t num_pushed_{0};
+};
+
+/// Returns true if the left half of a bisection should be explored
+/// first. @p bisected_intervals are the halves of the @p branching_point -th
+/// interval.
 ///
-/// @returns a pair of (max dimension, variable index).
-pair<double, int> FindMaxDiam(const Box& box, const ibex::BitSet& bitset) {
-  DREAL_ASSERT(!bitset.empty());
-  double max_diam{0.0};
-  int max_diam_idx{-1};
-  for (int i = 0, idx = bitset.min(); i < bitset.size();
-       ++i, idx = bitset.next(idx)) {
-    const Box::Interval& iv_i{box[idx]};
-    const double diam_i{iv_i.diam()};
-    if (diam_i > max_diam && iv_i.is_bisectable()) {
-      max_diam = diam_i;
-      max_diam_idx = idx;
+/// If @p warm_start_point has a value in one of the halves, it prefers the
+/// half containing it. Otherwise, it explores the right half first if
+/// `*stack_left_box_first` is true and the left half first if it is false.
+/// It flips `*stack_left_box_first` in both cases.
+bool ExploreLeftFirst(
+    const pair<Box::Interval, Box::Interval>& bisected_intervals,
+    const int branching_point, const vector<double>& warm_start_point,
+    bool* const stack_left_box_first) {
+  const bool default_order{!*stack_left_box_first};
+  // We alternate between adding-the-left-box-first policy and
+  // adding-the-right-box-first policy.
+  *stack_left_box_first = !*stack_left_box_first;
+  if (!warm_start_point.empty()) {
+    // It is NaN if the previous model does not have the variable. Then
+    // neither half contains it.
+    const double p{warm_start_point[branching_point]};
+    if (bisected_intervals.first.contains(p)) {
+      return true;
+    }
+    if (bisected_intervals.second.contains(p)) {
+      return false;
     }
   }
-  return make_pair(max_diam, max_diam_idx);
+  return default_order;
+}
+
+/// Evaluates the formulas over the two halves of the bisected box of
+/// @p cs in one batch. The halves are the copies of the box whose
+/// @p branching_point -th intervals are `bisected_intervals.first` and
+/// `bisected_intervals.second`. Returns a pair of flags which are true if
+/// the first and the second half are refuted by the evaluation. It adds
+/// the refuting formulas to @p cs.
+///
+/// Only the formulas which are not entailed by the box and contain the
+/// bisected variable are evaluated. The others have the same values over
+/// the halves as over the box, which is not refuted. `formula_variables[i]`
+/// is the variables of `formula_evaluators[i]`, or empty if the formula is
+/// not evaluated here.
+pair<bool, bool> RefuteHalves(
+    const vector<FormulaEvaluator>& formula_evaluators,
+    const vector<Variables>& formula_variables, const int branching_point,
+    const pair<Box::Interval, Box::Interval>& bisected_intervals,
+    ContractorStatus* const cs) {
+  const Box& box{cs->box()};
+  const Variable& var{box.variable(branching_point)};
+  const vector<bool>& entailed{cs->entailed()};
+  const bool track_entailment{entailed.size() == formula_evaluators.size()};
+  // It is constructed when the first formula is evaluated.
+  unique_ptr<BoxBatch> batch;
+  bool refuted[2]{false, false};
+  for (size_t i = 0; i < formula_evaluators.size(); ++i) {
+    if ((track_entailment && entailed[i]) ||
+        !formula_variables[i].include(var)) {
+      continue;
+    }
+    if (!batch) {
+      batch.reset(new BoxBatch{
+          box,
+          branching_point,
+          {bisected_intervals.first, bisected_intervals.second}});
+    }
+    const vector<FormulaEvaluationResult> results{
+        formula_evaluators[i](*batch)};
+    for (int k = 0; k < 2; ++k) {
+      if (!refuted[k] &&
+          results[k].type() == FormulaEvaluationResult::Type::UNSAT) {
+        DREAL_LOG_DEBUG(
+            "Icp::CheckSat() Found that the half {} of the box\n"
+            "{}\n"
+            "has no solution for {} (evaluation = {}).",
+            k, box, formula_evaluators[i], results[k].evaluation());
+        refuted[k] = true;
+        cs->AddUsedConstraint(formula_evaluators[i].formula());
+      }
+    }
+    if (refuted[0] && refuted[1]) {
+      break;
+    }
+  }
+  return make_pair(refuted[0], refuted[1]);
 }
 
-/// Partitions @p box into two sub-boxes and add them into the @p
-/// stack. It traverses only the variables enabled by @p bitset, to find a
-/// branching dimension.
+/// Partitions the box of @p cs into two sub-boxes and add them into the @p
+/// frontier with @p score. The sub-boxes inherit the entailment flags of
+/// @p cs. It asks @p branching_strategy to select a
+/// branching dimension among the variables enabled by @p bitset.
+///
+/// The sub-box to explore first is added last. See ExploreLeftFirst() for
+/// the order, which uses @p warm_start_point and @p stack_left_box_first.
+///
+/// If @p formula_evaluators is not nullptr, the sub-boxes refuted by
+/// RefuteHalves() are not added. `formula_variables[i]` is the variables
+/// of `(*formula_evaluators)[i]`.
 ///
 /// @returns true if it finds a branching dimension and adds boxes to the @p
-/// stack.
+/// frontier.
 /// @returns false if it fails to find a branching dimension.
-bool Branch(const Box& box, const ibex::BitSet& bitset,
-            vector<pair<Box, int>>* const stack) {
+bool Branch(const ibex::BitSet& bitset, const double score,
+            const vector<FormulaEvaluator>* const formula_evaluators,
+            const vector<Variables>& formula_variables,
+            BranchingStrategy* const branching_strategy,
+            const vector<double>& warm_start_point,
+            bool* const stack_left_box_first, ContractorStatus* const cs,
+            BoxFrontier* const frontier) {
   DREAL_ASSERT(!bitset.empty());
-
-  // If `stack_left_box_first` is true, we add the left box from the
-  // branching operation to the `stack`. Otherwise, we add the right
-  // box first.
-  static bool stack_left_box_first = false;
-
-  // TODO(soonho): For now, we fixated the branching heuristics.
-  // Generalize it later.
-  const pair<double, int> max_diam_and_idx{FindMaxDiam(box, bitset)};
-  const int branching_point{max_diam_and_idx.second};
+  const Box& box{cs->box()};
+  const int branching_point{branching_strategy->Select(box, bitset)};
   if (branching_point >= 0) {
-    const pair<Box, Box> bisected_boxes{box.bisect(branching_point)};
-    if (stack_left_box_first) {
-      stack->emplace_back(bisected_boxes.first, branching_point);
-      stack->emplace_back(bisected_boxes.second, branching_point);
-      DREAL_LOG_DEBUG(
-          "Icp::CheckSat() Branch {}\n"
-          "on {}\n"
-          "Box1=\n{}\n"
-          "Box2=\n{}",
-          box, box.variable(branching_point), bisected_boxes.first,
-          bisected_boxes.second);
-    } else {
-      stack->emplace_back(bisected_boxes.second, branching_point);
-      stack->emplace_back(bisected_boxes.first, branching_point);
-      DREAL_LOG_DEBUG(
-          "Icp::CheckSat() Branch {}\n"
-          "on {}\n"
-          "Box1=\n{}\n"
-          "Box2=\n{}",
-          box, box.variable(branching_point), bisected_boxes.second,
-          bisected_boxes.first);
-    }
-    // We alternate between adding-the-left-box-first policy and
-    // adding-the-right-box-first policy.
-    stack_left_box_first = !stack_left_box_first;
+    // The sub-boxes only differ from `box` at `branching_point`. We only
+    // compute the bisected intervals and let the frontier copy the rest.
+    const pair<Box::Interval, Box::Interval> bisected_intervals{
+        box.bisect_interval(branching_point)};
+    const pair<bool, bool> refuted{
+        formula_evaluators
+            ? RefuteHalves(*formula_evaluators, formula_variables,
+                           branching_point, bisected_intervals, cs)
+            : make_pair(false, false)};
+    const bool explore_left_first{
+        ExploreLeftFirst(bisected_intervals, branching_point,
+                         warm_start_point, stack_left_box_first)};
+    const Box::Interval& first{explore_left_first
+                                   ? bisected_intervals.second
+                                   : bisected_intervals.first};
+    const Box::Interval& second{explore_left_first
+                                    ? bisected_intervals.first
+                                    : bisected_intervals.second};
+    if (!(explore_left_first ? refuted.second : refuted.first)) {
+      frontier->Push(*cs, branching_point, first, score);
+    }
+    if (!(explore_left_first ? refuted.first : refuted.second)) {
+      frontier->Push(*cs, branching_point, second, score);
+    }
+    DREAL_LOG_DEBUG(
+        "Icp::CheckSat() Branch {}\n"
+        "on {}\n"
+        "Interval1 = {}\n"
+        "Interval2 = {}",
+        box, box.variable(branching_point), first, second);
     return true;
   }
   // Fail to find a branching point.
@@ -97,31 +344,198 @@ bool Branch(const Box& box, const ibex::BitSet& bitset,
 // branching and pruning operations.
 class IcpStat {
  public:
-  IcpStat() = default;
+  explicit IcpStat(const char* const level = "ICP level") : level_{level} {}
   ~IcpStat() {
     if (DREAL_LOG_INFO_ENABLED) {
       using fmt::print;
       print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Branching",
-            "ICP level", num_branch_);
-      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Pruning",
-            "ICP level", num_prune_);
+            level_, num_branch_.load());
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Pruning", level_,
+            num_prune_.load());
     }
   }
-  int num_branch_{0};
-  int num_prune_{0};
+  const char* const level_;
+  atomic<int> num_branch_{0};
+  atomic<int> num_prune_{0};
+};
+
+// A class to show statistics information of the backjumping at
+// destruction. We have a static instance in Icp::CheckSatWithTrail().
+class IcpBackjumpingStat {
+ public:
+  IcpBackjumpingStat() = default;
+  ~IcpBackjumpingStat() {
+    if (DREAL_LOG_INFO_ENABLED && num_backjump_ + num_nogood_hit_ > 0) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Backjumping",
+            "ICP level (trail)", num_backjump_.load());
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Nogood hits",
+            "ICP level (trail)", num_nogood_hit_.load());
+    }
+  }
+  atomic<int> num_backjump_{0};
+  atomic<int> num_nogood_hit_{0};
+};
+
+// Entry of the trail used in Icp::CheckSatWithTrail(). The interval of the
+// `index`-th dimension was `interval` before it was overwritten.
+struct TrailEntry {
+  int index;
+  Box::Interval interval;
 };
+
+// Choice point used in Icp::CheckSatWithTrail(). When the search
+// backtracks to it, it undoes the trails down to `trail_size` and
+// `entailed_trail_size` and explores the box whose `branching_point`-th
+// interval is `interval`.
+//
+// `dependencies` are the dimensions which the refutations of the bisected
+// box and of its refuted halves depend on. They are only computed with the
+// backjumping.
+struct ChoicePoint {
+  size_t trail_size;
+  size_t entailed_trail_size;
+  int branching_point;
+  Box::Interval interval;
+  ibex::BitSet dependencies;
+  bool exploring_second_half;
+};
+
+// Nogood learned in Icp::CheckSatWithTrail(). A box has no solution if its
+// `dimensions[i]`-th interval is a subset of `intervals[i]` for all i.
+// `dependencies` is the set of `dimensions`.
+struct Nogood {
+  vector<int> dimensions;
+  vector<Box::Interval> intervals;
+  ibex::BitSet dependencies;
+};
+
+// Bounded store of nogoods. When it is full, a new nogood replaces the
+// oldest one.
+class NogoodStore {
+ public:
+  explicit NogoodStore(const int capacity) : capacity_{capacity} {}
+
+  // Learns that the boxes agreeing with @p box on @p dependencies have no
+  // solution.
+  void Add(const Box& box, const ibex::BitSet& dependencies) {
+    if (capacity_ <= 0) {
+      return;
+    }
+    Nogood nogood{{}, {}, dependencies};
+    for (int i = 0; i < box.size(); ++i) {
+      if (dependencies.contain(i)) {
+        nogood.dimensions.push_back(i);
+        nogood.intervals.push_back(box[i]);
+      }
+    }
+    if (static_cast<int>(nogoods_.size()) < capacity_) {
+      nogoods_.push_back(move(nogood));
+    } else {
+      nogoods_[next_] = move(nogood);
+      next_ = (next_ + 1) % capacity_;
+    }
+  }
+
+  // Returns a nogood refuting @p box, or nullptr if there is none.
+  const Nogood* Find(const Box& box) const {
+    for (const Nogood& nogood : nogoods_) {
+      bool refuted{true};
+      for (size_t i = 0; i < nogood.dimensions.size() && refuted; ++i) {
+        refuted = box[nogood.dimensions[i]].is_subset(nogood.intervals[i]);
+      }
+      if (refuted) {
+        return &nogood;
+      }
+    }
+    return nullptr;
+  }
+
+ private:
+  const int capacity_;
+  vector<Nogood> nogoods_;
+  int next_{0};  // Index of the nogood to replace when it is full.
+};
+
+// Adds the dimensions of the variables of @p formulas to @p dimensions.
+// @p cache keeps the dimensions of the formulas in @p box.
+void AddDimensions(
+    const unordered_set<Formula, hash_value<Formula>>& formulas,
+    const Box& box,
+    unordered_map<Formula, vector<int>, hash_value<Formula>>* const cache,
+    ibex::BitSet* const dimensions) {
+  for (const Formula& f : formulas) {
+    auto it = cache->find(f);
+    if (it == cache->end()) {
+      vector<int> indices;
+      for (const Variable& var : f.GetFreeVariables()) {
+        if (box.has_variable(var)) {
+          indices.push_back(box.index(var));
+        }
+      }
+      it = cache->emplace(f, move(indices)).first;
+    }
+    for (const int i : it->second) {
+      dimensions->add(i);
+    }
+  }
+}
+
+// Undoes the entries of @p trail above @p trail_size on @p box.
+void Undo(const size_t trail_size, vector<TrailEntry>* const trail,
+          Box* const box) {
+  while (trail->size() > trail_size) {
+    const TrailEntry& entry{trail->back()};
+    (*box)[entry.index] = entry.interval;
+    trail->pop_back();
+  }
+}
 }  // namespace
 
 Icp::Icp(Contractor contractor, vector<FormulaEvaluator> formula_evaluators,
-         const double precision)
+         unique_ptr<BranchingStrategy> branching_strategy,
+         const Config& config, ResourceMonitor* const resource_monitor)
     : contractor_{move(contractor)},
       formula_evaluators_{move(formula_evaluators)},
-      precision_{precision} {}
+      precision_{config.precision()},
+      branching_strategy_{move(branching_strategy)},
+      exploration_order_{config.exploration_order()},
+      best_first_max_queue_size_{config.best_first_max_queue_size()},
+      use_trail_{(config.use_trail_icp() || config.use_icp_backjumping()) &&
+                 exploration_order_ == Config::ExplorationOrder::DEPTH_FIRST},
+      use_backjumping_{use_trail_ && config.use_icp_backjumping()},
+      nogood_capacity_{use_backjumping_ ? config.icp_nogood_capacity() : 0},
+      use_batched_evaluation_{config.use_batched_evaluation()},
+      cancellation_token_{config.cancellation_token()},
+      resource_monitor_{resource_monitor} {
+  DREAL_ASSERT(branching_strategy_);
+  DREAL_ASSERT(resource_monitor_);
+  if (use_batched_evaluation_) {
+    for (const FormulaEvaluator& formula_evaluator : formula_evaluators_) {
+      // A quantified formula is not evaluated in a batch. Its evaluation
+      // runs a nested search for each box.
+      formula_variables_.push_back(is_forall(formula_evaluator.formula())
+                                       ? Variables{}
+                                       : formula_evaluator.variables());
+    }
+  }
+}
 
-optional<ibex::BitSet> Icp::EvaluateBox(const Box& box,
-                                        ContractorStatus* const cs) {
+optional<ibex::BitSet> EvaluateBox(
+    const vector<FormulaEvaluator>& formula_evaluators, const Box& box,
+    const double precision, ContractorStatus* const cs, double* const score) {
   ibex::BitSet branching_candidates(box.size());  // This function returns this.
-  for (const FormulaEvaluator& formula_evaluator : formula_evaluators_) {
+  if (score) {
+    *score = 0.0;
+  }
+  vector<bool>& entailed{cs->mutable_entailed()};
+  const bool track_entailment{entailed.size() == formula_evaluators.size()};
+  for (size_t i = 0; i < formula_evaluators.size(); ++i) {
+    if (track_entailment && entailed[i]) {
+      // The formula is valid in an ancestor of this box.
+      continue;
+    }
+    const FormulaEvaluator& formula_evaluator{formula_evaluators[i]};
     const FormulaEvaluationResult result{formula_evaluator(box)};
     switch (result.type()) {
       case FormulaEvaluationResult::Type::UNSAT:
@@ -139,15 +553,21 @@ optional<ibex::BitSet> Icp::EvaluateBox(const Box& box,
             "{0}\n"
             "satisfies the constraint {1} (evaluation = {2}).",
             box, formula_evaluator, result.evaluation());
+        if (track_entailment) {
+          entailed[i] = true;
+        }
         continue;
       case FormulaEvaluationResult::Type::UNKNOWN: {
         const Box::Interval& evaluation{result.evaluation()};
         const double diam = evaluation.diam();
-        if (diam > precision_) {
+        if (score) {
+          *score += diam;
+        }
+        if (diam > precision) {
           DREAL_LOG_DEBUG(
               "Icp::EvaluateBox() Found an interval >= precision({2}):\n"
               "{0} -> {1}",
-              formula_evaluator, evaluation, precision_);
+              formula_evaluator, evaluation, precision);
           for (const Variable& v : formula_evaluator.variables()) {
             branching_candidates.add(box.index(v));
           }
@@ -158,15 +578,44 @@ optional<ibex::BitSet> Icp::EvaluateBox(const Box& box,
   return branching_candidates;
 }
 
+pair<double, int> FindMaxDiam(const Box& box, const ibex::BitSet& bitset) {
+  DREAL_ASSERT(!bitset.empty());
+  double max_diam{0.0};
+  int max_diam_idx{-1};
+  for (int i = 0, idx = bitset.min(); i < bitset.size();
+       ++i, idx = bitset.next(idx)) {
+    const Box::Interval& iv_i{box[idx]};
+    const double diam_i{iv_i.diam()};
+    if (diam_i > max_diam && iv_i.is_bisectable()) {
+      max_diam = diam_i;
+      max_diam_idx = idx;
+    }
+  }
+  return make_pair(max_diam, max_diam_idx);
+}
+
+void Icp::set_warm_start_point(vector<double> point) {
+  warm_start_point_ = move(point);
+}
+
 bool Icp::CheckSat(ContractorStatus* const cs) {
+  DREAL_ASSERT(warm_start_point_.empty() ||
+               static_cast<int>(warm_start_point_.size()) == cs->box().size());
+  if (use_trail_) {
+    return CheckSatWithTrail(cs);
+  }
   static IcpStat stat;
   DREAL_LOG_DEBUG("Icp::CheckSat()");
-  // Stack of Box x BranchingPoint.
-  vector<pair<Box, int>> stack;
-  stack.emplace_back(
-      cs->box(),
+  // Frontier of Box x BranchingPoint.
+  // Track the constraints entailed by the boxes. See EvaluateBox().
+  cs->mutable_entailed().assign(formula_evaluators_.size(), false);
+  BoxFrontier frontier{*cs, exploration_order_, best_first_max_queue_size_};
+  frontier.Push(
+      *cs,
       // -1 indicates that the very first box does not come from a branching.
-      -1);
+      -1,
+      // The score of the very first box does not matter.
+      0.0);
 
   // `current_box` always points to the box in the contractor status
   // as a mutable reference.
@@ -175,16 +624,20 @@ bool Icp::CheckSat(ContractorStatus* const cs) {
   // the contractor status as a mutable reference.
   int& current_branching_point{cs->mutable_branching_point()};
 
-  while (!stack.empty()) {
+  while (!frontier.empty()) {
     DREAL_LOG_DEBUG("Icp::CheckSat() Loop Head");
-    // 1. Pop the current box from the stack
-    tie(current_box, current_branching_point) = stack.back();
-    stack.pop_back();
+    if (cancellation_token_.is_cancelled()) {
+      DREAL_LOG_DEBUG("Icp::CheckSat() Cancelled");
+      return false;
+    }
+    // 1. Pop the current box from the frontier.
+    current_branching_point = frontier.Pop(cs);
 
     // 2. Prune the current box.
     DREAL_LOG_TRACE("Icp::CheckSat() Current Box:\n{}", current_box);
     contractor_.Prune(cs);
     stat.num_prune_++;
+    resource_monitor_->AddPruning();
     DREAL_LOG_TRACE("Icp::CheckSat() After pruning, the current box =\n{}",
                     current_box);
 
@@ -195,8 +648,10 @@ bool Icp::CheckSat(ContractorStatus* const cs) {
     }
     // 3.2. The box is non-empty. Check if the box is still feasible
     // under evaluation and it's small enough.
+    // The sub-boxes from branching inherit the score of this box.
+    double score{0.0};
     const optional<ibex::BitSet> evaluation_result{
-        EvaluateBox(current_box, cs)};
+        EvaluateBox(formula_evaluators_, current_box, precision_, cs, &score)};
     if (!evaluation_result) {
       // 3.2.1. We detect that the current box is not a feasible solution.
       DREAL_LOG_DEBUG(
@@ -211,7 +666,10 @@ bool Icp::CheckSat(ContractorStatus* const cs) {
       return true;
     }
     // 3.2.3. This box is bigger than delta. Need branching.
-    if (!Branch(current_box, *evaluation_result, &stack)) {
+    if (!Branch(*evaluation_result, score,
+                use_batched_evaluation_ ? &formula_evaluators_ : nullptr,
+                formula_variables_, branching_strategy_.get(),
+                warm_start_point_, &stack_left_box_first_, cs, &frontier)) {
       DREAL_LOG_DEBUG(
           "Icp::CheckSat() Found that the current box is not satisfying "
           "delta-condition but it's not bisectable.:\n{}",
@@ -219,8 +677,214 @@ bool Icp::CheckSat(ContractorStatus* const cs) {
       return true;
     }
     stat.num_branch_++;
+    resource_monitor_->AddBranching();
   }
   DREAL_LOG_DEBUG("Icp::CheckSat() No solution");
   return false;
 }
+
+bool Icp::CheckSatWithTrail(ContractorStatus* const cs) {
+  static IcpStat stat{"ICP level (trail)"};
+  static IcpBackjumpingStat backjumping_stat;
+  DREAL_LOG_DEBUG("Icp::CheckSatWithTrail()");
+  // The working box. The search only changes it in place.
+  Box& current_box{cs->mutable_box()};
+  int& current_branching_point{cs->mutable_branching_point()};
+  current_branching_point = -1;
+
+  vector<TrailEntry> trail;
+  // Indices of the constraints flagged as entailed, in the order they are
+  // flagged. See EvaluateBox().
+  vector<int> entailed_trail;
+  vector<ChoicePoint> choice_points;
+  vector<bool>& entailed{cs->mutable_entailed()};
+  entailed.assign(formula_evaluators_.size(), false);
+  // The intervals of the working box before pruning and the entailment
+  // flags before evaluation. They are reused at each node so that taking
+  // snapshots does not allocate memory.
+  Box::IntervalVector before_pruning{current_box.interval_vector()};
+  vector<bool> entailed_before_evaluation{entailed};
+
+  // With the backjumping, `cs` only keeps the constraints used at the
+  // current node and `explanation` collects them. The dimensions of the
+  // variables in the constraints used at a node are the dependencies of
+  // the node.
+  ContractorStatus explanation{current_box};
+  if (use_backjumping_) {
+    explanation.InplaceMergeExplanation(*cs);
+    cs->ClearExplanation();
+  }
+  const auto merge_explanation = [&explanation, cs, this]() {
+    if (use_backjumping_) {
+      cs->InplaceMergeExplanation(explanation);
+    }
+  };
+  const int dimension{current_box.size()};
+  ibex::BitSet dependencies{ibex::BitSet::empty(dimension)};
+  unordered_map<Formula, vector<int>, hash_value<Formula>> dimension_cache;
+  NogoodStore nogoods{nogood_capacity_};
+
+  while (true) {
+    if (cancellation_token_.is_cancelled()) {
+      DREAL_LOG_DEBUG("Icp::CheckSatWithTrail() Cancelled");
+      merge_explanation();
+      return false;
+    }
+    before_pruning = current_box.interval_vector();
+    entailed_before_evaluation = entailed;
+    // `branching_point` is set if the current box needs branching.
+    int branching_point{-1};
+    const Nogood* const nogood{nogoods.Find(current_box)};
+    if (nogood) {
+      // 1.1. A box explored before shows that the current box has no
+      // solution. The constraints used to refute it are in the explanation
+      // already.
+      DREAL_LOG_DEBUG("Icp::CheckSatWithTrail() A nogood refutes:\n{}",
+                      current_box);
+      dependencies = nogood->dependencies;
+      backjumping_stat.num_nogood_hit_++;
+    } else {
+      // 1.2. Prune the current box.
+      DREAL_LOG_TRACE("Icp::CheckSatWithTrail() Current Box:\n{}",
+                      current_box);
+      contractor_.Prune(cs);
+      stat.num_prune_++;
+      resource_monitor_->AddPruning();
+
+      // 2. Check the pruned box.
+      double score{0.0};
+      if (!current_box.empty()) {
+        const optional<ibex::BitSet> evaluation_result{EvaluateBox(
+            formula_evaluators_, current_box, precision_, cs, &score)};
+        if (evaluation_result) {
+          if (evaluation_result->empty()) {
+            // delta-SAT : We find a box which is smaller enough.
+            DREAL_LOG_DEBUG(
+                "Icp::CheckSatWithTrail() Found a delta-box:\n{}",
+                current_box);
+            merge_explanation();
+            return true;
+          }
+          branching_point =
+              branching_strategy_->Select(current_box, *evaluation_result);
+          if (branching_point < 0) {
+            DREAL_LOG_DEBUG(
+                "Icp::CheckSatWithTrail() Found that the current box is not "
+                "satisfying delta-condition but it's not bisectable.:\n{}",
+                current_box);
+            merge_explanation();
+            return true;
+          }
+        }
+      }
+      if (use_backjumping_) {
+        // A box emptied without an unsat witness, e.g. by the integer
+        // contractor, may depend on any dimension.
+        dependencies.clear();
+        if (current_box.empty() && cs->unsat_witness().empty()) {
+          dependencies.fill(0, dimension - 1);
+        }
+        AddDimensions(cs->used_constraints(), current_box, &dimension_cache,
+                      &dependencies);
+        AddDimensions(cs->unsat_witness(), current_box, &dimension_cache,
+                      &dependencies);
+        explanation.InplaceMergeExplanation(*cs);
+        cs->ClearExplanation();
+      }
+    }
+
+    // 3. Record the intervals changed by pruning and evaluation, and the
+    // constraints newly flagged as entailed. With the backjumping, an
+    // interval of a non-empty box changed without a used constraint (e.g.
+    // by the integer contractor) only depends on its own dimension.
+    const bool add_changed_dimensions{use_backjumping_ &&
+                                      !current_box.empty()};
+    for (int i = 0; i < dimension; ++i) {
+      if (before_pruning[i] != current_box[i]) {
+        trail.push_back(TrailEntry{i, before_pruning[i]});
+        if (add_changed_dimensions) {
+          dependencies.add(i);
+        }
+      }
+    }
+    for (size_t i = 0; i < entailed.size(); ++i) {
+      if (entailed[i] && !entailed_before_evaluation[i]) {
+        entailed_trail.push_back(i);
+      }
+    }
+
+    if (branching_point >= 0) {
+      // 4.1. Explore one half of the box and keep the other half in a
+      // choice point. The order follows Branch().
+      const pair<Box::Interval, Box::Interval> bisected_intervals{
+          current_box.bisect_interval(branching_point)};
+      const bool explore_left_first{
+          ExploreLeftFirst(bisected_intervals, branching_point,
+                           warm_start_point_, &stack_left_box_first_)};
+      const Box::Interval& first{explore_left_first
+                                     ? bisected_intervals.first
+                                     : bisected_intervals.second};
+      const Box::Interval& second{explore_left_first
+                                      ? bisected_intervals.second
+                                      : bisected_intervals.first};
+      choice_points.push_back(ChoicePoint{trail.size(), entailed_trail.size(),
+                                          branching_point, second,
+                                          dependencies, false});
+      trail.push_back(
+          TrailEntry{branching_point, current_box[branching_point]});
+      current_box[branching_point] = first;
+      current_branching_point = branching_point;
+      stat.num_branch_++;
+      resource_monitor_->AddBranching();
+      continue;
+    }
+
+    // 4.2. The box is refuted. Backtrack to the last choice point whose
+    // second half is not explored. `dependencies` are the ones of the box
+    // refuted last.
+    while (true) {
+      if (choice_points.empty()) {
+        DREAL_LOG_DEBUG("Icp::CheckSatWithTrail() No solution");
+        current_box.set_empty();
+        merge_explanation();
+        return false;
+      }
+      ChoicePoint& choice_point{choice_points.back()};
+      Undo(choice_point.trail_size, &trail, &current_box);
+      while (entailed_trail.size() > choice_point.entailed_trail_size) {
+        entailed[entailed_trail.back()] = false;
+        entailed_trail.pop_back();
+      }
+      if (!choice_point.exploring_second_half &&
+          (!use_backjumping_ ||
+           dependencies.contain(choice_point.branching_point))) {
+        // Explore the second half.
+        choice_point.exploring_second_half = true;
+        choice_point.dependencies |= dependencies;
+        trail.push_back(TrailEntry{choice_point.branching_point,
+                                   current_box[choice_point.branching_point]});
+        current_box[choice_point.branching_point] = choice_point.interval;
+        current_branching_point = choice_point.branching_point;
+        break;
+      }
+      // The box of the choice point is refuted. Note that if the refutation
+      // of the first half does not depend on the branching point, the
+      // second half only differs from the first one at the branching point
+      // and it is refuted by the same constraints.
+      if (!choice_point.exploring_second_half) {
+        DREAL_LOG_DEBUG(
+            "Icp::CheckSatWithTrail() Skip the second half of the box "
+            "bisected on {}:\n{}",
+            current_box.variable(choice_point.branching_point), current_box);
+        backjumping_stat.num_backjump_++;
+      }
+      if (use_backjumping_) {
+        dependencies |= choice_point.dependencies;
+        nogoods.Add(current_box, dependencies);
+      }
+      choice_points.pop_back();
+    }
+  }
+}
+
 }  // namespace dreal
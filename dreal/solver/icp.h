@@ -1,48 +1,127 @@
 #pragma once
 
+#include <memory>
+#include <utility>
 #include <vector>
 #include <experimental/optional>
 
 #include "dreal/contractor/contractor.h"
+#include "dreal/solver/branching_strategy.h"
+#include "dreal/solver/config.h"
 #include "dreal/solver/formula_evaluator.h"
+#include "dreal/solver/resource_monitor.h"
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
+#include "dreal/util/cancellation_token.h"
 
 namespace dreal {
 
 /// Class for ICP (Interval Constraint Propagation) algorithm.
 class Icp {
  public:
+  /// Constructs an ICP.
+  ///
+  /// @param contractor         Contractor used in pruning steps.
+  /// @param formula_evaluators Formula evaluators used in evaluation steps.
+  /// @param branching_strategy Strategy to select a branching dimension.
+  /// @param config             Configuration. It uses the precision, the
+  ///                           exploration order, the trail,
+  ///                           backjumping, and batched evaluation
+  ///                           options, and the cancellation token.
+  /// @param resource_monitor   Monitor to record branching and pruning
+  ///                           operations.
   Icp(Contractor contractor, std::vector<FormulaEvaluator> formula_evaluators,
-      double precision);
+      std::unique_ptr<BranchingStrategy> branching_strategy,
+      const Config& config, ResourceMonitor* resource_monitor);
 
   /// Checks the delta-satisfiability of the current assertions.
   /// Returns true  if it's delta-SAT.
   /// Returns false if it's UNSAT.
+  ///
+  /// @note It also returns false when the cancellation token is
+  /// cancelled. The caller should check the token before using the result.
   bool CheckSat(ContractorStatus* cs);
 
+  /// Sets a point to warm-start the search from. When it bisects a box, it
+  /// explores the half containing the point first. The other half is
+  /// explored if the first one has no solution. The i-th element of
+  /// @p point is the value of the i-th variable of the box given to
+  /// CheckSat(), or NaN if there is no value for it. An empty @p point
+  /// disables the warm start.
+  void set_warm_start_point(std::vector<double> point);
+
  private:
-  // Evaluates each assertion fᵢ with @p box.
-  //
-  // Returns None                if there is fᵢ such that fᵢ(box) is empty.
-  //                             (This indicates the problem is UNSAT)
-  //
-  // Returns Some(∅)            if for all fᵢ, we have |fᵢ(B)| ≤ δ.
-  //                             (This indicates the problem is delta-SAT)
+  // Runs the depth-first search with a single working box. Instead of
+  // storing the boxes to explore, it records the intervals overwritten by
+  // pruning and branching on a trail and restores them on backtracking.
   //
-  // Returns Some(Vars)          if there is fᵢ such that |fᵢ(B)| > δ.
-  //                             Vars = {v | v ∈ fᵢ ∧ |fᵢ(B)| > δ for all fᵢs}.
-  //                             (This indicates the problem is delta-SAT)
-  //
-  // It sets @p cs's box empty if it detects UNSAT. It also calls
-  // cs->AddUsedConstraint to store the constraint that is responsible
-  // for the UNSAT.
-  std::experimental::optional<ibex::BitSet> EvaluateBox(const Box& box,
-                                                        ContractorStatus* cs);
+  // With the backjumping, it also computes the dimensions which the
+  // refutation of each box depends on. If the refutation of the first half
+  // of a bisected box does not depend on the bisected dimension, the second
+  // half is refuted for the same reason and it is skipped.
+  bool CheckSatWithTrail(ContractorStatus* cs);
 
   const Contractor contractor_;
   std::vector<FormulaEvaluator> formula_evaluators_;
   const double precision_{};
+  const std::unique_ptr<BranchingStrategy> branching_strategy_;
+  // We alternate between adding-the-left-box-first policy and
+  // adding-the-right-box-first policy. See Branch() in icp.cc.
+  bool stack_left_box_first_{false};
+  std::vector<double> warm_start_point_;
+  const Config::ExplorationOrder exploration_order_;
+  const int best_first_max_queue_size_{};
+  // True if it uses CheckSatWithTrail(). It only applies to the depth-first
+  // order.
+  const bool use_trail_{};
+  // Used in CheckSatWithTrail(). See Config::use_icp_backjumping() and
+  // Config::icp_nogood_capacity().
+  const bool use_backjumping_{};
+  const int nogood_capacity_{};
+  // See Config::use_batched_evaluation(). It is not used in
+  // CheckSatWithTrail().
+  const bool use_batched_evaluation_{};
+  // formula_variables_[i] is the variables of formula_evaluators_[i], or
+  // empty if it is a quantified formula. It is only computed with the
+  // batched evaluation.
+  std::vector<Variables> formula_variables_;
+  const CancellationToken cancellation_token_;
+  ResourceMonitor* const resource_monitor_{};
 };
 
+/// Evaluates each formula in @p formula_evaluators with @p box.
+///
+/// Returns None                if there is fᵢ such that fᵢ(box) is empty.
+///                             (This indicates the problem is UNSAT)
+///
+/// Returns Some(∅)            if for all fᵢ, we have |fᵢ(B)| ≤ δ.
+///                             (This indicates the problem is delta-SAT)
+///
+/// Returns Some(Vars)          if there is fᵢ such that |fᵢ(B)| > δ.
+///                             Vars = {v | v ∈ fᵢ ∧ |fᵢ(B)| > δ for all fᵢs}.
+///                             (This indicates the problem is delta-SAT)
+///
+/// It sets @p cs's box empty if it detects UNSAT. It also calls
+/// cs->AddUsedConstraint to store the constraint that is responsible
+/// for the UNSAT.
+///
+/// If `cs->entailed()` has one flag for each formula, it skips the
+/// formulas flagged as entailed and flags the formulas valid in @p box.
+/// A valid formula stays valid in every sub-box.
+///
+/// If @p score is not nullptr, it stores the sum of |fᵢ(B)| for the
+/// formulas which are neither UNSAT nor VALID. A box with a smaller score
+/// is closer to satisfaction. The score is meaningful only when the
+/// function does not return None.
+std::experimental::optional<ibex::BitSet> EvaluateBox(
+    const std::vector<FormulaEvaluator>& formula_evaluators, const Box& box,
+    double precision, ContractorStatus* cs, double* score);
+
+/// Finds the dimension with the maximum diameter in a @p box. It only
+/// consider the dimensions enabled in @p bitset.
+///
+/// @returns a pair of (max dimension, variable index). The index is -1 if
+/// there is no bisectable dimension.
+std::pair<double, int> FindMaxDiam(const Box& box, const ibex::BitSet& bitset);
+
 }  // namespace dreal
@@ -0,0 +1,361 @@
+#include "dreal/solver/icp_parallel.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <utility>
+
+#include "dreal/solver/icp.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/logging.h"
+
+using std::atomic;
+using std::condition_variable;
+using std::cout;
+using std::cref;
+using std::deque;
+using std::exception_ptr;
+using std::experimental::nullopt;
+using std::experimental::optional;
+using std::lock_guard;
+using std::move;
+using std::mutex;
+using std::pair;
+using std::thread;
+using std::unique_lock;
+using std::unique_ptr;
+using std::vector;
+
+namespace dreal {
+
+namespace {
+
+// Double-ended queue of (Box, BranchingPoint) pairs owned by a worker. The
+// owner pushes and pops at the back of the queue while the other workers
+// steal from the front, where the older and bigger boxes are.
+class WorkQueue {
+ public:
+  void Push(Box box, const int branching_point) {
+    lock_guard<mutex> lock{mutex_};
+    queue_.emplace_back(move(box), branching_point);
+  }
+
+  optional<pair<Box, int>> PopBack() {
+    lock_guard<mutex> lock{mutex_};
+    if (queue_.empty()) {
+      return nullopt;
+    }
+    pair<Box, int> item{move(queue_.back())};
+    queue_.pop_back();
+    return item;
+  }
+
+  optional<pair<Box, int>> PopFront() {
+    lock_guard<mutex> lock{mutex_};
+    if (queue_.empty()) {
+      return nullopt;
+    }
+    pair<Box, int> item{move(queue_.front())};
+    queue_.pop_front();
+    return item;
+  }
+
+ private:
+  mutex mutex_;
+  deque<pair<Box, int>> queue_;
+};
+
+// State shared by the workers of IcpParallel::CheckSat().
+struct SharedState {
+  explicit SharedState(const int num_workers) : queues(num_workers) {}
+
+  vector<WorkQueue> queues;
+
+  // Number of boxes which are either in one of the queues or being
+  // processed by a worker. The search is over when it reaches zero.
+  atomic<int> num_pending_boxes{0};
+
+  // Set when a worker finds a delta-SAT box or throws an exception. The
+  // other workers check this flag and stop.
+  atomic<bool> done{false};
+
+  // Incremented when a box is pushed to a queue or the search is over.
+  // A worker which finds no box to explore waits on `work_available` until
+  // it changes. See NotifyWorkers() and WaitForWork().
+  atomic<int64_t> work_epoch{0};
+  atomic<int> num_idle_workers{0};
+  mutex idle_mutex;
+  condition_variable work_available;
+
+  // Protects `solution` and `exception`.
+  mutex result_mutex;
+  optional<Box> solution;
+  exception_ptr exception;
+};
+
+// A class to show statistics information at destruction. We have a
+// static instance in IcpParallel::CheckSat() to keep track of the numbers
+// of branching, pruning, and stealing operations.
+class IcpParallelStat {
+ public:
+  IcpParallelStat() = default;
+  ~IcpParallelStat() {
+    if (DREAL_LOG_INFO_ENABLED) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Branching",
+            "ICP level (parallel)", num_branch_.load());
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Pruning",
+            "ICP level (parallel)", num_prune_.load());
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Stealing",
+            "ICP level (parallel)", num_steal_.load());
+    }
+  }
+  atomic<int> num_branch_{0};
+  atomic<int> num_prune_{0};
+  atomic<int> num_steal_{0};
+};
+
+// Steals a box from the front of another worker's queue. It visits the
+// queues of the other workers in a round-robin way, starting from the one
+// next to @p id.
+optional<pair<Box, int>> Steal(const int id, SharedState* const state) {
+  const int num_workers = state->queues.size();
+  for (int i = 1; i < num_workers; ++i) {
+    optional<pair<Box, int>> item{
+        state->queues[(id + i) % num_workers].PopFront()};
+    if (item) {
+      return item;
+    }
+  }
+  return nullopt;
+}
+
+// Wakes up the idle workers. It is called when a box is pushed to a queue
+// or the search is over.
+void NotifyWorkers(SharedState* const state) {
+  // A worker increments `num_idle_workers` before it checks `work_epoch`
+  // for the last time. So if it is not counted here, it sees the new epoch
+  // and does not wait.
+  state->work_epoch++;
+  if (state->num_idle_workers > 0) {
+    // A worker counted here either waits already or still holds the lock
+    // until it waits. Taking the lock makes sure that it gets the
+    // notification.
+    { lock_guard<mutex> lock{state->idle_mutex}; }
+    state->work_available.notify_all();
+  }
+}
+
+// Waits until `state->work_epoch` is not @p epoch. The wait is bounded
+// because the cancellation token cannot wake up the worker.
+void WaitForWork(const int64_t epoch, SharedState* const state) {
+  unique_lock<mutex> lock{state->idle_mutex};
+  state->num_idle_workers++;
+  state->work_available.wait_for(
+      lock, std::chrono::milliseconds{10},
+      [state, epoch] { return state->work_epoch != epoch; });
+  state->num_idle_workers--;
+}
+
+// Accounts for a box which is refuted. The search is over when there are
+// no more pending boxes.
+void FinishBox(SharedState* const state) {
+  if (--state->num_pending_boxes == 0) {
+    NotifyWorkers(state);
+  }
+}
+
+// Records @p box as a solution and asks the other workers to stop.
+void ReportSolution(const Box& box, SharedState* const state) {
+  {
+    lock_guard<mutex> lock{state->result_mutex};
+    if (!state->solution) {
+      state->solution = box;
+    }
+    state->done = true;
+  }
+  NotifyWorkers(state);
+}
+
+// Runs the branch-and-prune loop of the @p id -th worker. @p cs is owned by
+// the worker and collects the constraints used while pruning.
+void RunWorker(const int id, const Contractor& contractor,
+               const vector<FormulaEvaluator>& formula_evaluators,
+               const double precision,
+               const BranchingStrategy& branching_strategy,
+               const CancellationToken& cancellation_token,
+               ResourceMonitor* const resource_monitor,
+               SharedState* const state,
+               ContractorStatus* const cs, IcpParallelStat* const stat) {
+  try {
+    WorkQueue& own_queue{state->queues[id]};
+    Box& current_box{cs->mutable_box()};
+    int& current_branching_point{cs->mutable_branching_point()};
+    // Branching strategies may have mutable states. Each worker uses its
+    // own copy.
+    const unique_ptr<BranchingStrategy> own_branching_strategy{
+        branching_strategy.Clone()};
+    // See the comment in Branch() in icp.cc.
+    bool stack_left_box_first{false};
+
+    while (!state->done && !cancellation_token.is_cancelled()) {
+      // 1. Pop a box from the own queue. Steal one if it is empty. The
+      // epoch is read first, so that a box pushed after the attempts ends
+      // the wait below.
+      const int64_t epoch{state->work_epoch};
+      optional<pair<Box, int>> item{own_queue.PopBack()};
+      if (!item) {
+        item = Steal(id, state);
+        if (!item) {
+          if (state->num_pending_boxes == 0) {
+            // No more boxes to explore.
+            break;
+          }
+          // The other workers are processing the remaining boxes. Wait
+          // until they push a box or finish the search.
+          WaitForWork(epoch, state);
+          continue;
+        }
+        stat->num_steal_++;
+      }
+      current_box = move(item->first);
+      current_branching_point = item->second;
+
+      // 2. Prune the current box.
+      DREAL_LOG_TRACE("IcpParallel::CheckSat() Worker {} Current Box:\n{}", id,
+                      current_box);
+      contractor.Prune(cs);
+      stat->num_prune_++;
+      resource_monitor->AddPruning();
+      if (current_box.empty()) {
+        // 3.1. The box is empty after pruning.
+        FinishBox(state);
+        continue;
+      }
+      // 3.2. The box is non-empty. Check if the box is still feasible
+      // under evaluation and it's small enough.
+      const optional<ibex::BitSet> evaluation_result{
+          EvaluateBox(formula_evaluators, current_box, precision, cs,
+                      nullptr /* score */)};
+      if (!evaluation_result) {
+        // 3.2.1. We detect that the current box is not a feasible solution.
+        FinishBox(state);
+        continue;
+      }
+      if (evaluation_result->empty()) {
+        // 3.2.2. delta-SAT : We find a box which is smaller enough.
+        DREAL_LOG_DEBUG(
+            "IcpParallel::CheckSat() Worker {} Found a delta-box:\n{}", id,
+            current_box);
+        ReportSolution(current_box, state);
+        return;
+      }
+      // 3.2.3. This box is bigger than delta. Need branching.
+      const int branching_point{
+          own_branching_strategy->Select(current_box, *evaluation_result)};
+      if (branching_point < 0) {
+        DREAL_LOG_DEBUG(
+            "IcpParallel::CheckSat() Worker {} Found that the current box is "
+            "not satisfying delta-condition but it's not bisectable.:\n{}",
+            id, current_box);
+        ReportSolution(current_box, state);
+        return;
+      }
+      const pair<Box, Box> bisected_boxes{current_box.bisect(branching_point)};
+      // We account for the two sub-boxes (+2) and the current box (-1)
+      // before we publish the sub-boxes. Otherwise, another worker could
+      // see zero pending boxes while there are boxes to explore.
+      state->num_pending_boxes++;
+      if (stack_left_box_first) {
+        own_queue.Push(bisected_boxes.first, branching_point);
+        own_queue.Push(bisected_boxes.second, branching_point);
+      } else {
+        own_queue.Push(bisected_boxes.second, branching_point);
+        own_queue.Push(bisected_boxes.first, branching_point);
+      }
+      NotifyWorkers(state);
+      stack_left_box_first = !stack_left_box_first;
+      stat->num_branch_++;
+      resource_monitor->AddBranching();
+    }
+  } catch (...) {
+    {
+      lock_guard<mutex> lock{state->result_mutex};
+      if (!state->exception) {
+        state->exception = std::current_exception();
+      }
+      state->done = true;
+    }
+    NotifyWorkers(state);
+  }
+}
+}  // namespace
+
+IcpParallel::IcpParallel(vector<Contractor> contractors,
+                         vector<FormulaEvaluator> formula_evaluators,
+                         const double precision,
+                         unique_ptr<BranchingStrategy> branching_strategy,
+                         CancellationToken cancellation_token,
+                         ResourceMonitor* const resource_monitor)
+    : contractors_{move(contractors)},
+      formula_evaluators_{move(formula_evaluators)},
+      precision_{precision},
+      branching_strategy_{move(branching_strategy)},
+      cancellation_token_{move(cancellation_token)},
+      resource_monitor_{resource_monitor} {
+  DREAL_ASSERT(!contractors_.empty());
+  DREAL_ASSERT(branching_strategy_);
+  DREAL_ASSERT(resource_monitor_);
+}
+
+bool IcpParallel::CheckSat(ContractorStatus* const cs) {
+  static IcpParallelStat stat;
+  const int num_workers = contractors_.size();
+  DREAL_LOG_DEBUG("IcpParallel::CheckSat() # of workers = {}", num_workers);
+
+  SharedState state{num_workers};
+  state.queues[0].Push(cs->box(), cs->branching_point());
+  state.num_pending_boxes = 1;
+
+  // Each worker has its own contractor status so that it does not need to
+  // synchronize while pruning.
+  vector<ContractorStatus> worker_statuses(num_workers,
+                                           ContractorStatus{cs->box()});
+  vector<thread> workers;
+  workers.reserve(num_workers);
+  for (int i = 0; i < num_workers; ++i) {
+    workers.emplace_back(RunWorker, i, cref(contractors_[i]),
+                         cref(formula_evaluators_), precision_,
+                         cref(*branching_strategy_), cref(cancellation_token_),
+                         resource_monitor_, &state, &worker_statuses[i],
+                         &stat);
+  }
+  for (thread& worker : workers) {
+    worker.join();
+  }
+  if (state.exception) {
+    std::rethrow_exception(state.exception);
+  }
+  if (state.solution) {
+    cs->mutable_box() = *state.solution;
+    return true;
+  }
+  // UNSAT. The workers refuted disjoint parts of the search space. An
+  // explanation of the UNSAT result is the union of theirs.
+  DREAL_LOG_DEBUG("IcpParallel::CheckSat() No solution");
+  for (const ContractorStatus& worker_status : worker_statuses) {
+    cs->InplaceMergeExplanation(worker_status);
+  }
+  cs->mutable_box().set_empty();
+  return false;
+}
+
+}  // namespace dreal
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "dreal/contractor/contractor.h"
+#include "dreal/solver/branching_strategy.h"
+#include "dreal/solver/formula_evaluator.h"
+#include "dreal/solver/resource_monitor.h"
+#include "dreal/util/box.h"
+#include "dreal/util/cancellation_token.h"
+
+namespace dreal {
+
+/// Class for a parallel ICP (Interval Constraint Propagation) algorithm.
+///
+/// It runs one worker thread per contractor given to the constructor. Each
+/// worker owns a double-ended queue of boxes. A worker pushes and pops boxes
+/// at the back of its own queue (depth-first search) and, when its queue is
+/// empty, steals a box from the front of another worker's queue. The first
+/// worker which finds a delta-SAT box cancels the others. If all the boxes
+/// are refuted, the explanations collected by the workers are merged.
+class IcpParallel {
+ public:
+  /// Constructs a parallel ICP.
+  ///
+  /// @param contractors        Contractors, one for each worker. They should
+  ///                           not share any mutable state.
+  /// @param formula_evaluators Formula evaluators shared by the workers. They
+  ///                           should be safe to use concurrently.
+  /// @param precision          Precision (δ) of the problem.
+  /// @param branching_strategy Strategy to select a branching dimension.
+  ///                           Each worker uses its own clone.
+  /// @param cancellation_token Token to stop the workers.
+  /// @param resource_monitor   Monitor to record branching and pruning
+  ///                           operations.
+  ///
+  /// @pre `contractors` is not empty.
+  IcpParallel(std::vector<Contractor> contractors,
+              std::vector<FormulaEvaluator> formula_evaluators,
+              double precision,
+              std::unique_ptr<BranchingStrategy> branching_strategy,
+              CancellationToken cancellation_token,
+              ResourceMonitor* resource_monitor);
+
+  /// Checks the delta-satisfiability of the current assertions.
+  /// Returns true  if it's delta-SAT.
+  /// Returns false if it's UNSAT.
+  ///
+  /// @note It also returns false when the cancellation token is
+  /// cancelled. The caller should check the token before using the result.
+  bool CheckSat(ContractorStatus* cs);
+
+ private:
+  const std::vector<Contractor> contractors_;
+  std::vector<FormulaEvaluator> formula_evaluators_;
+  const double precision_{};
+  const std::unique_ptr<BranchingStrategy> branching_strategy_;
+  const CancellationToken cancellation_token_;
+  ResourceMonitor* const resource_monitor_{};
+};
+
+}  // namespace dreal
@@ -1,6 +1,7 @@
 #include "dreal/solver/relational_formula_evaluator.h"
 
 #include <utility>
+#include <vector>
 
 #include "dreal/util/assert.h"
 #include "dreal/util/exception.h"
@@ -10,6 +11,7 @@ namespace dreal {
 using std::move;
 using std::ostream;
 using std::pair;
+using std::vector;
 
 namespace {
 
@@ -75,7 +77,21 @@ RelationalFormulaEvaluator::~RelationalFormulaEvaluator() {
 
 FormulaEvaluationResult RelationalFormulaEvaluator::operator()(
     const Box& box) const {
-  const Box::Interval evaluation{expression_evaluator_(box)};
+  return Evaluate(expression_evaluator_(box));
+}
+
+vector<FormulaEvaluationResult> RelationalFormulaEvaluator::operator()(
+    const BoxBatch& batch) const {
+  vector<FormulaEvaluationResult> results;
+  results.reserve(batch.size());
+  for (const Box::Interval& evaluation : expression_evaluator_(batch)) {
+    results.push_back(Evaluate(evaluation));
+  }
+  return results;
+}
+
+FormulaEvaluationResult RelationalFormulaEvaluator::Evaluate(
+    const Box::Interval& evaluation) const {
   switch (op_) {
     case RelationalOperator::EQ: {
       // e₁ - e₂ = 0
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ostream>
+#include <vector>
 
 #include "./ibex.h"
 
@@ -21,6 +22,9 @@ class RelationalFormulaEvaluator : public FormulaEvaluatorCell {
 
   FormulaEvaluationResult operator()(const Box& box) const override;
 
+  std::vector<FormulaEvaluationResult> operator()(
+      const BoxBatch& batch) const override;
+
   std::ostream& Display(std::ostream& os) const override;
 
   Variables variables() const override {
@@ -28,6 +32,9 @@ class RelationalFormulaEvaluator : public FormulaEvaluatorCell {
   }
 
  private:
+  // Returns the result of the formula given the @p evaluation of e₁ - e₂.
+  FormulaEvaluationResult Evaluate(const Box::Interval& evaluation) const;
+
   const RelationalOperator op_{};
   const ExpressionEvaluator expression_evaluator_;
 };
@@ -0,0 +1,52 @@
+#include "dreal/solver/resource_monitor.h"
+
+#include <utility>
+
+#include "dreal/util/logging.h"
+
+namespace dreal {
+
+using std::atomic;
+using std::move;
+
+namespace {
+// Increments @p counter and returns true if it exceeds @p limit. A
+// non-positive @p limit means no limit.
+bool IncrementAndCheck(atomic<int>* const counter, const int limit) {
+  const int count{++(*counter)};
+  return limit > 0 && count > limit;
+}
+}  // namespace
+
+ResourceMonitor::ResourceMonitor(const Config& config,
+                                 CancellationToken cancellation_token)
+    : max_branchings_{config.max_branchings()},
+      max_prunings_{config.max_prunings()},
+      max_sat_calls_{config.max_sat_calls()},
+      cancellation_token_{move(cancellation_token)} {}
+
+void ResourceMonitor::AddBranching() {
+  if (IncrementAndCheck(&num_branchings_, max_branchings_)) {
+    DREAL_LOG_DEBUG("ResourceMonitor: # of branchings exceeds the limit {}",
+                    max_branchings_);
+    cancellation_token_.Cancel();
+  }
+}
+
+void ResourceMonitor::AddPruning() {
+  if (IncrementAndCheck(&num_prunings_, max_prunings_)) {
+    DREAL_LOG_DEBUG("ResourceMonitor: # of prunings exceeds the limit {}",
+                    max_prunings_);
+    cancellation_token_.Cancel();
+  }
+}
+
+void ResourceMonitor::AddSatCall() {
+  if (IncrementAndCheck(&num_sat_calls_, max_sat_calls_)) {
+    DREAL_LOG_DEBUG("ResourceMonitor: # of SAT calls exceeds the limit {}",
+                    max_sat_calls_);
+    cancellation_token_.Cancel();
+  }
+}
+
+}  // namespace dreal
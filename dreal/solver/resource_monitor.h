@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+
+#include "dreal/solver/config.h"
+#include "dreal/util/cancellation_token.h"
+
+namespace dreal {
+
+/// Keeps track of the resources used by a CheckSat call, the numbers of
+/// branching operations, pruning operations, and SAT-solver calls. When
+/// one of them exceeds its limit in the config, it cancels the
+/// cancellation token of the call.
+///
+/// It is safe to use a monitor from multiple threads.
+class ResourceMonitor {
+ public:
+  /// Constructs a resource monitor which takes the limits from @p config
+  /// and cancels @p cancellation_token when a limit is exceeded.
+  ResourceMonitor(const Config& config, CancellationToken cancellation_token);
+
+  /// Records a branching operation.
+  void AddBranching();
+
+  /// Records a pruning operation.
+  void AddPruning();
+
+  /// Records a SAT-solver call.
+  void AddSatCall();
+
+  /// Returns the number of branching operations so far.
+  int num_branchings() const { return num_branchings_; }
+
+  /// Returns the number of pruning operations so far.
+  int num_prunings() const { return num_prunings_; }
+
+  /// Returns the number of SAT-solver calls so far.
+  int num_sat_calls() const { return num_sat_calls_; }
+
+ private:
+  const int max_branchings_{};
+  const int max_prunings_{};
+  const int max_sat_calls_{};
+  const CancellationToken cancellation_token_;
+
+  std::atomic<int> num_branchings_{0};
+  std::atomic<int> num_prunings_{0};
+  std::atomic<int> num_sat_calls_{0};
+};
+
+}  // namespace dreal
@@ -0,0 +1,77 @@
+#include "dreal/solver/sat_backend.h"
+
+#include <cstdlib>
+
+#include "./picosat.h"
+
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
+#include "dreal/util/logging.h"
+
+namespace dreal {
+
+using std::unique_ptr;
+using std::vector;
+
+namespace {
+
+class PicosatBackend : public SatBackend {
+ public:
+  PicosatBackend() : sat_{picosat_init()} {}
+  ~PicosatBackend() override { picosat_reset(sat_); }
+
+  int NewVar() override { return picosat_inc_max_var(sat_); }
+
+  void AddClause(const vector<int>& clause) override {
+    for (const int l : clause) {
+      picosat_add(sat_, l);
+    }
+    picosat_add(sat_, 0);
+  }
+
+  // PicoSAT recycles the context variable of a popped scope and collects
+  // the clauses of the scope. A clause learned from them has the negation
+  // of the context variable, so it is collected as well.
+  void Push() override { picosat_push(sat_); }
+
+  void Pop() override { picosat_pop(sat_); }
+
+  bool Solve(const vector<int>& assumptions) override {
+    for (const int l : assumptions) {
+      picosat_assume(sat_, l);
+    }
+    const int ret{picosat_sat(sat_, -1)};
+    if (ret == PICOSAT_SATISFIABLE) {
+      return true;
+    } else if (ret == PICOSAT_UNSATISFIABLE) {
+      return false;
+    }
+    DREAL_ASSERT(ret == PICOSAT_UNKNOWN);
+    DREAL_LOG_CRITICAL("PICOSAT returns PICOSAT_UNKNOWN.");
+    throw DREAL_RUNTIME_ERROR("PICOSAT returns PICOSAT_UNKNOWN.");
+  }
+
+  int Value(const int var) const override { return picosat_deref(sat_, var); }
+
+  int num_vars() const override { return picosat_variables(sat_); }
+
+  int num_clauses() const override {
+    return picosat_added_original_clauses(sat_);
+  }
+
+ private:
+  // Pointer to the PicoSat solver.
+  PicoSAT* const sat_{};
+};
+
+}  // namespace
+
+unique_ptr<SatBackend> MakeSatBackend(const Config::SatSolverBackend type) {
+  switch (type) {
+    case Config::SatSolverBackend::PICOSAT:
+      return unique_ptr<SatBackend>{new PicosatBackend{}};
+  }
+  DREAL_UNREACHABLE();
+}
+
+}  // namespace dreal
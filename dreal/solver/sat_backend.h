@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "dreal/solver/config.h"
+
+namespace dreal {
+
+/// Interface of the SAT solvers used by SatSolver. It follows the DIMACS
+/// convention: a variable is a positive integer and a literal is either v
+/// or -v for a variable v.
+///
+/// A backend supports incremental clause addition. Clauses can be added
+/// after a Solve() call and the next call takes them into account. It also
+/// supports scopes. The clauses added after a Push() call are removed by
+/// the matching Pop() call.
+class SatBackend {
+ public:
+  SatBackend() = default;
+  SatBackend(const SatBackend&) = delete;
+  SatBackend(SatBackend&&) = delete;
+  SatBackend& operator=(const SatBackend&) = delete;
+  SatBackend& operator=(SatBackend&&) = delete;
+  virtual ~SatBackend() = default;
+
+  /// Makes a new variable and returns it.
+  virtual int NewVar() = 0;
+
+  /// Adds a clause, the disjunction of the literals in @p clause.
+  virtual void AddClause(const std::vector<int>& clause) = 0;
+
+  /// Opens a scope.
+  virtual void Push() = 0;
+
+  /// Closes the innermost scope and removes the clauses added in it. The
+  /// variables made in the scope are not constrained after this call, so
+  /// the caller may reuse them as new variables.
+  virtual void Pop() = 0;
+
+  /// Checks the satisfiability of the clauses under @p assumptions. The
+  /// assumptions are literals which hold only in this call.
+  ///
+  /// @returns true if it is satisfiable, false if it is unsatisfiable.
+  /// @throws std::runtime_error if the backend fails to decide it.
+  virtual bool Solve(const std::vector<int>& assumptions) = 0;
+
+  /// Returns the value of a variable @p var in the model found by the last
+  /// Solve() call: 1 if true, -1 if false, and 0 if it is unassigned.
+  ///
+  /// @pre The last Solve() call returned true.
+  virtual int Value(int var) const = 0;
+
+  /// Returns the number of variables.
+  virtual int num_vars() const = 0;
+
+  /// Returns the number of clauses added by AddClause().
+  virtual int num_clauses() const = 0;
+};
+
+/// Makes a SAT backend of type @p type.
+std::unique_ptr<SatBackend> MakeSatBackend(Config::SatSolverBackend type);
+
+}  // namespace dreal
@@ -1,5 +1,6 @@
 #include "dreal/solver/sat_solver.h"
 
+#include <atomic>
 #include <ostream>
 
 #include "dreal/util/assert.h"
@@ -8,27 +9,29 @@
 
 namespace dreal {
 
+using std::atomic;
 using std::cout;
 using std::experimental::make_optional;
 using std::experimental::optional;
 using std::unordered_set;
 using std::vector;
 
-SatSolver::SatSolver() : sat_{picosat_init()} {}
+SatSolver::SatSolver() : SatSolver{Config{}} {}
+
+SatSolver::SatSolver(const Config& config)
+    : backend_{MakeSatBackend(config.sat_solver_backend())} {}
 
 SatSolver::SatSolver(const vector<Formula>& clauses) : SatSolver{} {
   AddClauses(clauses);
 }
 
-SatSolver::~SatSolver() { picosat_reset(sat_); }
+SatSolver::~SatSolver() = default;
 
 void SatSolver::AddFormula(const Formula& f) {
   DREAL_LOG_DEBUG("SatSolver::AddFormula({})", f);
+  // The Tseitin variables of `f` are in `cnfizer_.map()` until the next
+  // conversion. MakeSatVar() looks them up there.
   vector<Formula> clauses{cnfizer_.Convert(f)};
-  // Collect Tseitin variables.
-  for (const auto& p : cnfizer_.map()) {
-    tseitin_variables_.insert(p.first);
-  }
   for (Formula& clause : clauses) {
     clause = predicate_abstractor_.Convert(clause);
   }
@@ -43,10 +46,34 @@ void SatSolver::AddFormulas(const vector<Formula>& formulas) {
 
 void SatSolver::AddLearnedClause(
     const unordered_set<Formula, hash_value<Formula>>& formulas) {
+  vector<int> clause;
+  clause.reserve(formulas.size());
   for (const Formula& f : formulas) {
-    AddLiteral(!predicate_abstractor_.Convert(f));
+    AddLiteral(!predicate_abstractor_.Convert(f), &clause);
+  }
+  backend_->AddClause(clause);
+}
+
+void SatSolver::AddTheoryPropagation(
+    const unordered_set<Formula, hash_value<Formula>>& reason,
+    const Formula& literal) {
+  DREAL_LOG_DEBUG("SatSolver::AddTheoryPropagation({})", literal);
+  vector<int> clause;
+  clause.reserve(reason.size() + 1);
+  for (const Formula& f : reason) {
+    AddLiteral(!predicate_abstractor_.Convert(f), &clause);
   }
-  picosat_add(sat_, 0);
+  AddLiteral(predicate_abstractor_.Convert(literal), &clause);
+  backend_->AddClause(clause);
+}
+
+vector<Formula> SatSolver::theory_predicates() const {
+  vector<Formula> predicates;
+  predicates.reserve(predicate_abstractor_.var_to_formula_map().size());
+  for (const auto& p : predicate_abstractor_.var_to_formula_map()) {
+    predicates.push_back(p.second);
+  }
+  return predicates;
 }
 
 void SatSolver::AddClauses(const vector<Formula>& formulas) {
@@ -62,7 +89,17 @@ void SatSolver::AddClause(const Formula& f) {
     MakeSatVar(var);
   }
   // Add clauses to SAT solver.
-  DoAddClause(f);
+  vector<int> clause;
+  if (is_disjunction(f)) {
+    // f = l₁ ∨ ... ∨ lₙ
+    for (const Formula& l : get_operands(f)) {
+      AddLiteral(l, &clause);
+    }
+  } else {
+    // f = b or f = ¬b.
+    AddLiteral(f, &clause);
+  }
+  backend_->AddClause(clause);
 }
 
 namespace {
@@ -73,74 +110,83 @@ class SatSolverStat {
     if (DREAL_LOG_INFO_ENABLED) {
       using fmt::print;
       print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of CheckSat",
-            "SAT level", num_check_sat_);
+            "SAT level", num_check_sat_.load());
     }
   }
 
-  int num_check_sat_{0};
+  atomic<int> num_check_sat_{0};
 };
 }  // namespace
 
 std::experimental::optional<SatSolver::Model> SatSolver::CheckSat() {
   static SatSolverStat stat;
   DREAL_LOG_DEBUG("SatSolver::CheckSat(#vars = {}, #clauses = {})",
-                  picosat_variables(sat_),
-                  picosat_added_original_clauses(sat_));
+                  backend_->num_vars(), backend_->num_clauses());
   stat.num_check_sat_++;
   // Call SAT solver.
-  const int ret{picosat_sat(sat_, -1)};
+  if (!backend_->Solve({})) {
+    DREAL_LOG_DEBUG("SatSolver::CheckSat() No solution.");
+    // UNSAT Case.
+    return {};
+  }
+  // SAT Case.
   Model model;
   auto& boolean_model = model.first;
   auto& theory_model = model.second;
-  if (ret == PICOSAT_SATISFIABLE) {
-    // SAT Case.
-    const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
-    for (int i = 1; i <= picosat_variables(sat_); ++i) {
-      const int model_i{picosat_deref(sat_, i)};
-      if (model_i == 0) {
-        continue;
-      }
-      const Variable& var{to_sym_var_[i]};
-      const auto it = var_to_formula_map.find(var);
-      if (it != var_to_formula_map.end()) {
-        DREAL_LOG_TRACE("SatSolver::CheckSat: Add theory literal {}{} to Model",
-                        model_i ? "" : "¬", var);
-        theory_model.emplace_back(var, model_i == 1);
-      } else if (tseitin_variables_.find(var) == tseitin_variables_.end()) {
-        DREAL_LOG_TRACE(
-            "SatSolver::CheckSat: Add Boolean literal {}{} to Model ",
-            model_i ? "" : "¬", var);
-        boolean_model.emplace_back(var, model_i == 1);
-      } else {
-        DREAL_LOG_TRACE(
-            "SatSolver::CheckSat: Skip {}{} which is a temporary variable.",
-            model_i ? "" : "¬", var);
-      }
+  boolean_model.reserve(boolean_sat_vars_.size());
+  for (const int i : boolean_sat_vars_) {
+    const int model_i{backend_->Value(i)};
+    if (model_i == 0) {
+      continue;
     }
-    DREAL_LOG_DEBUG("SatSolver::CheckSat() Found a model.");
-    return model;
-  } else if (ret == PICOSAT_UNSATISFIABLE) {
-    DREAL_LOG_DEBUG("SatSolver::CheckSat() No solution.");
-    // UNSAT Case.
-    return {};
-  } else {
-    DREAL_ASSERT(ret == PICOSAT_UNKNOWN);
-    DREAL_LOG_CRITICAL("PICOSAT returns PICOSAT_UNKNOWN.");
-    throw DREAL_RUNTIME_ERROR("PICOSAT returns PICOSAT_UNKNOWN.");
+    const Variable& var{sat_vars_[i].var};
+    DREAL_LOG_TRACE("SatSolver::CheckSat: Add Boolean literal {}{} to Model ",
+                    model_i == 1 ? "" : "¬", var);
+    boolean_model.emplace_back(var, model_i == 1);
+  }
+  theory_model.reserve(theory_sat_vars_.size());
+  for (const int i : theory_sat_vars_) {
+    const int model_i{backend_->Value(i)};
+    if (model_i == 0) {
+      continue;
+    }
+    const Variable& var{sat_vars_[i].var};
+    DREAL_LOG_TRACE("SatSolver::CheckSat: Add theory literal {}{} to Model",
+                    model_i == 1 ? "" : "¬", var);
+    theory_model.emplace_back(var, model_i == 1);
   }
+  DREAL_LOG_DEBUG("SatSolver::CheckSat() Found a model.");
+  return model;
 }
 
 void SatSolver::Pop() {
   DREAL_LOG_DEBUG("SatSolver::Pop()");
-  picosat_pop(sat_);
+  backend_->Pop();
+  predicate_abstractor_.Pop();
+  to_sat_var_.pop();
+  sat_vars_.pop();
+  boolean_sat_vars_.pop();
+  theory_sat_vars_.pop();
+  if (!scoped_sat_vars_.empty()) {
+    const vector<int>& released{scoped_sat_vars_.back()};
+    free_sat_vars_.insert(free_sat_vars_.end(), released.begin(),
+                          released.end());
+    scoped_sat_vars_.pop_back();
+  }
 }
 
 void SatSolver::Push() {
   DREAL_LOG_DEBUG("SatSolver::Push()");
-  picosat_push(sat_);
+  backend_->Push();
+  predicate_abstractor_.Push();
+  to_sat_var_.push();
+  sat_vars_.push();
+  boolean_sat_vars_.push();
+  theory_sat_vars_.push();
+  scoped_sat_vars_.emplace_back();
 }
 
-void SatSolver::AddLiteral(const Formula& f) {
+void SatSolver::AddLiteral(const Formula& f, vector<int>* const clause) {
   DREAL_ASSERT(is_variable(f) ||
                (is_negation(f) && is_variable(get_operand(f))));
   if (is_variable(f)) {
@@ -148,40 +194,48 @@ void SatSolver::AddLiteral(const Formula& f) {
     const Variable& var{get_variable(f)};
     DREAL_ASSERT(var.get_type() == Variable::Type::BOOLEAN);
     // Add l = b
-    picosat_add(sat_, to_sat_var_[var]);
+    clause->push_back(to_sat_var_[var]);
   } else {
     // f = ¬b
     DREAL_ASSERT(is_negation(f) && is_variable(get_operand(f)));
     const Variable& var{get_variable(get_operand(f))};
     DREAL_ASSERT(var.get_type() == Variable::Type::BOOLEAN);
     // Add l = ¬b
-    picosat_add(sat_, -to_sat_var_[var]);
-  }
-}
-
-void SatSolver::DoAddClause(const Formula& f) {
-  if (is_disjunction(f)) {
-    // f = l₁ ∨ ... ∨ lₙ
-    for (const Formula& l : get_operands(f)) {
-      AddLiteral(l);
-    }
-  } else {
-    // f = b or f = ¬b.
-    AddLiteral(f);
+    clause->push_back(-to_sat_var_[var]);
   }
-  picosat_add(sat_, 0);
 }
 
 void SatSolver::MakeSatVar(const Variable& var) {
-  auto it = to_sat_var_.find(var);
-  if (it != to_sat_var_.end()) {
+  if (to_sat_var_.count(var) > 0) {
     // Found.
     return;
   }
-  // It's not in the maps, let's make one and add it.
-  const int sat_var{picosat_inc_max_var(sat_)};
-  to_sat_var_.emplace_hint(it, var, sat_var);
-  to_sym_var_.emplace(sat_var, var);
+  // It's not in the maps, let's make one and add it. A variable released
+  // by Pop() is reused first, so that the number of variables in the
+  // backend does not grow with the number of scopes.
+  int sat_var{0};
+  if (free_sat_vars_.empty()) {
+    sat_var = backend_->NewVar();
+  } else {
+    sat_var = free_sat_vars_.back();
+    free_sat_vars_.pop_back();
+  }
+  if (!scoped_sat_vars_.empty()) {
+    scoped_sat_vars_.back().push_back(sat_var);
+  }
+  to_sat_var_.insert(var, sat_var);
+  const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
+  if (var_to_formula_map.find(var) != var_to_formula_map.end()) {
+    sat_vars_.insert(sat_var, SatVarInfo{var, SatVarKind::THEORY});
+    theory_sat_vars_.push_back(sat_var);
+  } else if (cnfizer_.map().count(var) == 0) {
+    sat_vars_.insert(sat_var, SatVarInfo{var, SatVarKind::BOOLEAN});
+    boolean_sat_vars_.push_back(sat_var);
+  } else {
+    // A temporary variable introduced by Tseitin transformation. It is not
+    // a part of the model.
+    sat_vars_.insert(sat_var, SatVarInfo{var, SatVarKind::TSEITIN});
+  }
   DREAL_LOG_DEBUG("SatSolver::MakeSatVar({} ↦ {})", var, sat_var);
   return;
 }
@@ -7,10 +7,12 @@
 #include <vector>
 #include <experimental/optional>
 
-#include "./picosat.h"
-
+#include "dreal/solver/config.h"
+#include "dreal/solver/sat_backend.h"
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/predicate_abstractor.h"
+#include "dreal/util/scoped_unordered_map.h"
+#include "dreal/util/scoped_vector.h"
 #include "dreal/util/tseitin_cnfizer.h"
 
 namespace dreal {
@@ -22,9 +24,12 @@ class SatSolver {
   // Boolean model + Theory model.
   using Model = std::pair<std::vector<Literal>, std::vector<Literal>>;
 
-  /// Constructs a SatSolver.
+  /// Constructs a SatSolver with the default backend.
   SatSolver();
 
+  /// Constructs a SatSolver with the backend specified in @p config.
+  explicit SatSolver(const Config& config);
+
   /// Constructs a SatSolver while asserting @p clauses.
   explicit SatSolver(const std::vector<Formula>& clauses);
 
@@ -45,21 +50,42 @@ class SatSolver {
   void AddLearnedClause(
       const std::unordered_set<Formula, hash_value<Formula>>& formulas);
 
+  /// Given a @p reason = {f₁, ..., fₙ} and a theory literal @p literal
+  /// implied by the reason, adds a clause (¬f₁ ∨ ... ∨ ¬fₙ ∨ literal) to
+  /// the solver.
+  ///
+  /// @pre @p literal is either p or ¬p where p is one of theory_predicates().
+  void AddTheoryPropagation(
+      const std::unordered_set<Formula, hash_value<Formula>>& reason,
+      const Formula& literal);
+
   /// Checks the satisfiability of the current configuration.
   ///
   /// @returns a witness, satisfying model if the problem is satisfiable.
   /// @returns nullopt if UNSAT.
   std::experimental::optional<Model> CheckSat();
 
-  // TODO(soonho): Push/Pop cnfizer and predicate_abstractor?
+  /// Pops the clauses added since the last Push() call. The backend
+  /// removes them. It also removes the predicate abstractions and the SAT
+  /// variables made in the scope, so that a CheckSat() call only visits the
+  /// live variables. The SAT variables are reused for the variables made
+  /// later.
   void Pop();
 
+  /// Opens a scope in the solver and in the backend.
   void Push();
 
+  /// Returns the number of variables in the backend.
+  int num_sat_vars() const { return backend_->num_vars(); }
+
   Formula theory_literal(const Variable& var) const {
     return predicate_abstractor_[var];
   }
 
+  /// Returns the theory predicates, the formulas abstracted by Boolean
+  /// variables.
+  std::vector<Formula> theory_predicates() const;
+
  private:
   // Adds a formula @p f to the solver.
   //
@@ -72,8 +98,8 @@ class SatSolver {
   // @pre Each formula fᵢ ∈ formulas is a clause.
   void AddClauses(const std::vector<Formula>& formulas);
 
-  // Returns a corresponding literal ID of @p var. It maintains two
-  // maps `lit_to_var_` and `var_to_lit_` to keep track of the
+  // Makes a SAT variable for @p var if there is none. It maintains two
+  // maps `to_sat_var_` and `sat_vars_` to keep track of the
   // relationship between Variable ⇔ Literal (in SAT).
   void MakeSatVar(const Variable& var);
 
@@ -81,27 +107,49 @@ class SatSolver {
   //
   // @pre @p f is either a Boolean variable or a negation of Boolean
   // variable.
-  void AddLiteral(const Formula& f);
+  void AddLiteral(const Formula& f, std::vector<int>* clause);
+
+  // Kinds of SAT variables.
+  enum class SatVarKind {
+    BOOLEAN,  // Boolean variable in the input.
+    THEORY,   // Predicate abstraction of a theory literal.
+    TSEITIN,  // Temporary variable from Tseitin transformation.
+  };
 
-  // Add a clause @p f to sat solver.
-  void DoAddClause(const Formula& f);
+  struct SatVarInfo {
+    Variable var;
+    SatVarKind kind;
+  };
 
   // Member variables
   // ----------------
-  // Pointer to the PicoSat solver.
-  PicoSAT* const sat_{};
+  const std::unique_ptr<SatBackend> backend_;
   TseitinCnfizer cnfizer_;
   PredicateAbstractor predicate_abstractor_;
 
-  // Map symbolic::Variable → int (Variable type in PicoSat).
-  std::unordered_map<Variable, int, hash_value<Variable>> to_sat_var_;
+  // The following maps are scoped by Push() and Pop(). A SAT variable made
+  // in a popped scope is put in `free_sat_vars_` and reused for a new
+  // variable.
+
+  // Map symbolic::Variable → int (Variable type in the SAT backend).
+  ScopedUnorderedMap<Variable, int, hash_value<Variable>> to_sat_var_;
+
+  // Map int (Variable type in the SAT backend) → symbolic::Variable and its
+  // kind.
+  ScopedUnorderedMap<int, SatVarInfo> sat_vars_;
+
+  // SAT variables of the Boolean variables and the theory literals. They
+  // are the variables reported in a model.
+  ScopedVector<int> boolean_sat_vars_;
+  ScopedVector<int> theory_sat_vars_;
 
-  // Map int (Variable type in PicoSat) → symbolic::Variable.
-  std::unordered_map<int, Variable> to_sym_var_;
+  // The SAT variables made in each open scope, from the outermost to the
+  // innermost. The ones made before the first Push() are not recorded as
+  // they are never released.
+  std::vector<std::vector<int>> scoped_sat_vars_;
 
-  /// Set of temporary Boolean variables introduced by Tseitin
-  /// transformations.
-  std::unordered_set<Variable, hash_value<Variable>> tseitin_variables_;
+  // SAT variables released by Pop(). No clause constrains them.
+  std::vector<int> free_sat_vars_;
 };
 
 }  // namespace dreal
@@ -0,0 +1,133 @@
+#include "dreal/solver/branching_strategy.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/solver/context.h"
+
+namespace dreal {
+namespace {
+
+using std::unique_ptr;
+using std::vector;
+
+class BranchingStrategyTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_.Add(x_, 0, 1);
+    box_.Add(y_, 0, 2);
+    box_.Add(z_, 0, 3);
+    for (int i = 0; i < box_.size(); ++i) {
+      all_.add(i);
+    }
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Variable z_{"z"};
+  Box box_;
+  ibex::BitSet all_{3};
+  const double precision_{0.001};
+};
+
+TEST_F(BranchingStrategyTest, MaxDiam) {
+  unique_ptr<BranchingStrategy> strategy{MakeBranchingStrategy(
+      Config::BranchingHeuristic::MAX_DIAM, {}, precision_)};
+  EXPECT_EQ(strategy->Select(box_, all_), box_.index(z_));
+
+  ibex::BitSet xy{3};
+  xy.add(box_.index(x_));
+  xy.add(box_.index(y_));
+  EXPECT_EQ(strategy->Select(box_, xy), box_.index(y_));
+}
+
+TEST_F(BranchingStrategyTest, RoundRobin) {
+  unique_ptr<BranchingStrategy> strategy{MakeBranchingStrategy(
+      Config::BranchingHeuristic::ROUND_ROBIN, {}, precision_)};
+  EXPECT_EQ(strategy->Select(box_, all_), 0);
+  EXPECT_EQ(strategy->Select(box_, all_), 1);
+
+  // A clone continues from the state of the original.
+  unique_ptr<BranchingStrategy> clone{strategy->Clone()};
+  EXPECT_EQ(clone->Select(box_, all_), 2);
+  EXPECT_EQ(clone->Select(box_, all_), 0);
+  EXPECT_EQ(strategy->Select(box_, all_), 2);
+
+  // Skips non-bisectable dimensions.
+  box_[0] = 0.5;
+  EXPECT_EQ(strategy->Select(box_, all_), 1);
+}
+
+TEST_F(BranchingStrategyTest, Smear) {
+  // |∂f/∂x| · diam(x) = 100 · 1 is larger than |∂f/∂y| · diam(y) = 1 · 2
+  // and |∂f/∂z| · diam(z) = 0 · 3.
+  const vector<FormulaEvaluator> formula_evaluators{
+      make_relational_formula_evaluator(100 * x_ + y_ == 0)};
+  unique_ptr<BranchingStrategy> strategy{MakeBranchingStrategy(
+      Config::BranchingHeuristic::SMEAR, formula_evaluators, precision_)};
+  EXPECT_EQ(strategy->Select(box_, all_), box_.index(x_));
+
+  ibex::BitSet yz{3};
+  yz.add(box_.index(y_));
+  yz.add(box_.index(z_));
+  EXPECT_EQ(strategy->Select(box_, yz), box_.index(y_));
+}
+
+TEST_F(BranchingStrategyTest, SmearFallBackToMaxDiam) {
+  // The constraint is satisfied within the precision, so all the smear
+  // values are zero.
+  box_[x_] = 0.0;
+  const vector<FormulaEvaluator> formula_evaluators{
+      make_relational_formula_evaluator(x_ == 0)};
+  unique_ptr<BranchingStrategy> strategy{MakeBranchingStrategy(
+      Config::BranchingHeuristic::SMEAR, formula_evaluators, precision_)};
+  EXPECT_EQ(strategy->Select(box_, all_), box_.index(z_));
+}
+
+class BranchingStrategyContextTest
+    : public ::testing::TestWithParam<Config::BranchingHeuristic> {
+ protected:
+  void SetUp() override {
+    config_.mutable_precision() = 0.001;
+    config_.mutable_branching_heuristic() = GetParam();
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  Config config_;
+};
+
+TEST_P(BranchingStrategyContextTest, DeltaSat) {
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  context.Assert(sin(x_) == y_);
+  const auto result = context.CheckSat();
+  ASSERT_TRUE(result);
+  const double x{(*result)[x_].mid()};
+  const double y{(*result)[y_].mid()};
+  EXPECT_NEAR(x * x + y * y, 1.0, 0.01);
+  EXPECT_NEAR(std::sin(x), y, 0.01);
+}
+
+TEST_P(BranchingStrategyContextTest, Unsat) {
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  context.Assert(x_ * x_ + y_ * y_ == 4.0);
+  EXPECT_FALSE(context.CheckSat());
+}
+
+INSTANTIATE_TEST_CASE_P(
+    BranchingHeuristics, BranchingStrategyContextTest,
+    ::testing::Values(Config::BranchingHeuristic::MAX_DIAM,
+                      Config::BranchingHeuristic::ROUND_ROBIN,
+                      Config::BranchingHeuristic::SMEAR));
+
+}  // namespace
+}  // namespace dreal
@@ -0,0 +1,80 @@
+#include "dreal/solver/context.h"
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+class ContextPortfolioTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    config_.mutable_use_portfolio() = true;
+    config_.mutable_precision() = 0.001;
+  }
+
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  Config config_;
+};
+
+TEST_F(ContextPortfolioTest, DeltaSat) {
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  context.Assert(x_ == 2 * y_);
+  const auto result = context.CheckSat();
+  ASSERT_TRUE(result);
+  const double x{(*result)[x_].mid()};
+  const double y{(*result)[y_].mid()};
+  EXPECT_NEAR(x * x + y * y, 1.0, 0.01);
+  EXPECT_NEAR(x, 2 * y, 0.01);
+}
+
+TEST_F(ContextPortfolioTest, DeltaSatDisjunction) {
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  context.Assert(x_ >= 5 || y_ >= 0.5);
+  const auto result = context.CheckSat();
+  ASSERT_TRUE(result);
+  EXPECT_GE((*result)[y_].ub(), 0.5);
+}
+
+TEST_F(ContextPortfolioTest, Unsat) {
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  context.Assert(x_ * x_ + y_ * y_ == 4.0);
+  EXPECT_FALSE(context.CheckSat());
+}
+
+TEST_F(ContextPortfolioTest, WarmStart) {
+  // The model of the first check warm-starts the solvers of the second one.
+  config_.mutable_use_warm_start() = true;
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  ASSERT_TRUE(context.CheckSat());
+  context.Assert(x_ >= 0.5);
+  const auto result = context.CheckSat();
+  ASSERT_TRUE(result);
+  EXPECT_GE((*result)[x_].ub(), 0.5);
+}
+
+TEST_F(ContextPortfolioTest, PushPop) {
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.Assert(x_ * x_ == 4.0);
+  context.Push(1);
+  context.Assert(x_ >= 3);
+  EXPECT_FALSE(context.CheckSat());
+  context.Pop(1);
+  EXPECT_TRUE(context.CheckSat());
+}
+
+}  // namespace
+}  // namespace dreal
@@ -0,0 +1,81 @@
+#include "dreal/solver/context.h"
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+class ContextTest : public ::testing::Test {
+ protected:
+  void SetUp() override { config_.mutable_precision() = 0.001; }
+
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  Config config_;
+};
+
+// Asserts and checks repeatedly. Each CheckSat only adds the new
+// assertions to the SAT solver.
+TEST_F(ContextTest, IncrementalAssert) {
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  EXPECT_TRUE(context.CheckSat());
+  context.Assert(x_ >= 0.5 || y_ >= 0.5);
+  EXPECT_TRUE(context.CheckSat());
+  context.Assert(x_ <= 0.0);
+  const auto result = context.CheckSat();
+  ASSERT_TRUE(result);
+  EXPECT_GE((*result)[y_].ub(), 0.5);
+  context.Assert(y_ <= 0.0);
+  EXPECT_FALSE(context.CheckSat());
+}
+
+TEST_F(ContextTest, PushPop) {
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  // The assertion above is not checked before the push. It should still
+  // be active after the pop.
+  context.Push(1);
+  context.Assert(x_ >= 0.9 || y_ >= 0.9);
+  EXPECT_TRUE(context.CheckSat());
+  context.Push(1);
+  context.Assert(x_ <= 0.5);
+  context.Assert(y_ <= 0.5);
+  EXPECT_FALSE(context.CheckSat());
+  context.Pop(1);
+  EXPECT_TRUE(context.CheckSat());
+  context.Pop(1);
+  context.Assert(x_ >= 2 || y_ >= 2);
+  EXPECT_FALSE(context.CheckSat());
+  context.Push(1);
+  context.Assert(Formula::False());
+  EXPECT_FALSE(context.CheckSat());
+  context.Pop(1);
+}
+
+TEST_F(ContextTest, WarmStart) {
+  config_.mutable_use_warm_start() = true;
+  for (const double sign : {1.0, -1.0}) {
+    Context context{config_};
+    context.DeclareVariable(x_, -10, 10);
+    context.Assert(x_ * x_ == 1.0);
+    context.Push(1);
+    context.Assert(sign * x_ >= 0.5);
+    const auto result1 = context.CheckSat();
+    ASSERT_TRUE(result1);
+    EXPECT_NEAR((*result1)[x_].mid(), sign, 0.01);
+    context.Pop(1);
+    // Both x = 1 and x = -1 are solutions. The search starts from the
+    // previous model.
+    const auto result2 = context.CheckSat();
+    ASSERT_TRUE(result2);
+    EXPECT_NEAR((*result2)[x_].mid(), sign, 0.01);
+  }
+}
+
+}  // namespace
+}  // namespace dreal
@@ -2,6 +2,8 @@
 
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -11,6 +13,7 @@ namespace {
 using std::cerr;
 using std::endl;
 using std::ostringstream;
+using std::vector;
 
 class ExpressionEvaluatorTest : public ::testing::Test {
  protected:
@@ -40,6 +43,116 @@ TEST_F(ExpressionEvaluatorTest, Arithmetic1) {
   EXPECT_EQ(oss.str(), "ExpressionEvaluator((x + y + z))");
 }
 
+TEST_F(ExpressionEvaluatorTest, CommonSubexpression) {
+  const Expression e1{sin(x_ * y_) + cos(x_ * y_)};
+  const Expression e2{sin(x_ * z_) + cos(y_ * z_)};
+  const ExpressionEvaluator evaluator1{e1};
+  const ExpressionEvaluator evaluator2{e2};
+
+  // `x * y` is computed once in e1 while `x * z` and `y * z` are two
+  // different subexpressions in e2.
+  EXPECT_LT(evaluator1.tape_size(), evaluator2.tape_size());
+
+  box_[x_] = Box::Interval{1, 2};
+  box_[y_] = Box::Interval{2, 3};
+  const Box::Interval xy{Box::Interval{1, 2} * Box::Interval{2, 3}};
+  EXPECT_EQ(evaluator1(box_), sin(xy) + cos(xy));
+}
+
+TEST_F(ExpressionEvaluatorTest, BoxesOfDifferentLayouts) {
+  const ExpressionEvaluator evaluator{x_ - z_};
+  box_[x_] = Box::Interval{1, 2};
+  box_[z_] = Box::Interval{3, 4};
+  EXPECT_EQ(evaluator(box_), Box::Interval(-3, -1));
+
+  // The variables are at different indices in box2.
+  Box box2;
+  box2.Add(z_, 0, 1);
+  box2.Add(x_, 5, 6);
+  EXPECT_EQ(evaluator(box2), Box::Interval(4, 6));
+
+  // A copy of the evaluator and a box with an extra variable.
+  const ExpressionEvaluator copy{evaluator};
+  box_.Add(Variable{"w"});
+  EXPECT_EQ(copy(box_), Box::Interval(-3, -1));
+  EXPECT_EQ(copy(box2), Box::Interval(4, 6));
+}
+
+TEST_F(ExpressionEvaluatorTest, Pow) {
+  box_[x_] = Box::Interval{-1, 2};
+  box_[y_] = Box::Interval{2, 2};
+  box_[z_] = Box::Interval{1, 3};
+  const Box::Interval x{-1, 2};
+
+  EXPECT_EQ(ExpressionEvaluator{pow(x_, 2)}(box_), sqr(x));
+  EXPECT_EQ(ExpressionEvaluator{pow(x_, 3)}(box_), pow(x, 3));
+  EXPECT_EQ(ExpressionEvaluator{pow(z_, 0.5)}(box_),
+            pow(Box::Interval{1, 3}, 0.5));
+  // The exponent `y` is a point at evaluation time.
+  EXPECT_EQ(ExpressionEvaluator{pow(x_, y_)}(box_), sqr(x));
+}
+
+TEST_F(ExpressionEvaluatorTest, IfThenElse) {
+  const ExpressionEvaluator evaluator{if_then_else(x_ > y_, x_, y_)};
+  EXPECT_THROW(evaluator(box_), std::runtime_error);
+}
+
+// Checks that the evaluations of @p evaluator with the boxes in @p boxes
+// are the same as a batch and one by one. The kernels may round the
+// results differently within a few ulps.
+void CheckBatch(const ExpressionEvaluator& evaluator,
+                const vector<Box>& boxes) {
+  const vector<Box::Interval> results{evaluator(BoxBatch{boxes})};
+  ASSERT_EQ(results.size(), boxes.size());
+  for (size_t k = 0; k < boxes.size(); ++k) {
+    const Box::Interval expected{evaluator(boxes[k])};
+    ASSERT_EQ(results[k].is_empty(), expected.is_empty());
+    if (!expected.is_empty()) {
+      EXPECT_DOUBLE_EQ(results[k].lb(), expected.lb());
+      EXPECT_DOUBLE_EQ(results[k].ub(), expected.ub());
+    }
+  }
+}
+
+TEST_F(ExpressionEvaluatorTest, Batch) {
+  // Additions, multiplications, and squares use the kernels. The other
+  // operations fall back to the scalar ones.
+  const ExpressionEvaluator evaluator1{3 * x_ * y_ - 2 * pow(z_, 2) + x_};
+  const ExpressionEvaluator evaluator2{x_ * sin(y_) +
+                                       pow(z_, 2) / (1 + abs(x_))};
+
+  vector<Box> boxes;
+  for (int i = 0; i < 9; ++i) {
+    box_[x_] = Box::Interval{-i, i + 1};
+    box_[y_] = Box::Interval{i - 4, 2 * i + 0.1};
+    box_[z_] = Box::Interval{-3, i * 0.3};
+    boxes.push_back(box_);
+  }
+  // An unbounded box.
+  box_[x_] = Box::Interval{0, 1};
+  box_[y_] = Box::Interval::ALL_REALS;
+  boxes.push_back(box_);
+  // An empty box.
+  boxes.push_back(box_);
+  boxes.back().set_empty();
+
+  CheckBatch(evaluator1, boxes);
+  CheckBatch(evaluator2, boxes);
+  EXPECT_TRUE(evaluator1(BoxBatch{boxes}).back().is_empty());
+}
+
+TEST_F(ExpressionEvaluatorTest, BatchOfHalves) {
+  const ExpressionEvaluator evaluator{x_ * x_ - y_};
+  box_[x_] = Box::Interval{-1, 3};
+  box_[y_] = Box::Interval{1, 2};
+  // The halves of the box bisected on x.
+  const BoxBatch batch{box_, 0, {Box::Interval{-1, 1}, Box::Interval{1, 3}}};
+  const vector<Box::Interval> results{evaluator(batch)};
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_EQ(results[0], Box::Interval(-2, 0));
+  EXPECT_EQ(results[1], Box::Interval(-1, 8));
+}
+
 // TODO(soonho): Add more tests.
 
 }  // namespace
@@ -0,0 +1,46 @@
+#include "dreal/solver/icp_parallel.h"
+
+#include <gtest/gtest.h>
+
+#include "dreal/solver/context.h"
+
+namespace dreal {
+namespace {
+
+class IcpParallelTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    config_.mutable_number_of_jobs() = 4;
+    config_.mutable_precision() = 0.001;
+  }
+
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  Config config_;
+};
+
+TEST_F(IcpParallelTest, DeltaSat) {
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  context.Assert(x_ == 2 * y_);
+  const auto result = context.CheckSat();
+  ASSERT_TRUE(result);
+  const double x{(*result)[x_].mid()};
+  const double y{(*result)[y_].mid()};
+  EXPECT_NEAR(x * x + y * y, 1.0, 0.01);
+  EXPECT_NEAR(x, 2 * y, 0.01);
+}
+
+TEST_F(IcpParallelTest, Unsat) {
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  context.Assert(x_ * x_ + y_ * y_ == 4.0);
+  EXPECT_FALSE(context.CheckSat());
+}
+
+}  // namespace
+}  // namespace dreal
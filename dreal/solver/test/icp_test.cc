@@ -1,12 +1,240 @@
 #include "dreal/solver/icp.h"
 
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "dreal/solver/context.h"
+
 namespace dreal {
 namespace {
 
-GTEST_TEST(ICP, Test) {
-  // Add
+using std::experimental::optional;
+using std::move;
+using std::unique_ptr;
+using std::vector;
+
+class IcpTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    config_.mutable_precision() = 0.001;
+    config_.mutable_exploration_order() = Config::ExplorationOrder::BEST_FIRST;
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  Config config_;
+};
+
+TEST_F(IcpTest, EvaluateBoxScore) {
+  Box box;
+  box.Add(x_, 0, 1);
+  box.Add(y_, 0, 2);
+  const vector<FormulaEvaluator> formula_evaluators{
+      make_relational_formula_evaluator(x_ == 0.5),
+      make_relational_formula_evaluator(y_ == 1.0)};
+  ContractorStatus cs{box};
+  double score{-1.0};
+  const optional<ibex::BitSet> result{
+      EvaluateBox(formula_evaluators, box, 0.001, &cs, &score)};
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result->size(), 2);
+  // diam(x - 0.5) + diam(y - 1.0) = 1 + 2.
+  EXPECT_DOUBLE_EQ(score, 3.0);
+}
+
+TEST_F(IcpTest, EvaluateBoxEntailment) {
+  Box box;
+  box.Add(x_, 0, 1);
+  box.Add(y_, 0, 2);
+  const vector<FormulaEvaluator> formula_evaluators{
+      make_relational_formula_evaluator(x_ >= -1),
+      make_relational_formula_evaluator(y_ == 1.0)};
+  ContractorStatus cs{box};
+  cs.mutable_entailed().assign(formula_evaluators.size(), false);
+  ASSERT_TRUE(EvaluateBox(formula_evaluators, box, 0.001, &cs, nullptr));
+  // `x >= -1` is valid in the box while `y == 1.0` is not.
+  EXPECT_TRUE(cs.is_entailed(0));
+  EXPECT_FALSE(cs.is_entailed(1));
+
+  // An entailed formula is not evaluated again. Note that `x >= -1` does
+  // not hold in the following box, which is not a sub-box of `box`.
+  Box box2{box};
+  box2[x_] = Box::Interval{-3, -2};
+  EXPECT_TRUE(EvaluateBox(formula_evaluators, box2, 0.001, &cs, nullptr));
+}
+
+TEST_F(IcpTest, BestFirstDeltaSat) {
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  context.Assert(x_ == 2 * y_);
+  const auto result = context.CheckSat();
+  ASSERT_TRUE(result);
+  const double x{(*result)[x_].mid()};
+  const double y{(*result)[y_].mid()};
+  EXPECT_NEAR(x * x + y * y, 1.0, 0.01);
+  EXPECT_NEAR(x, 2 * y, 0.01);
+}
+
+TEST_F(IcpTest, BestFirstUnsat) {
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  context.Assert(x_ * x_ + y_ * y_ == 4.0);
+  EXPECT_FALSE(context.CheckSat());
+}
+
+TEST_F(IcpTest, BestFirstFallBackToDepthFirst) {
+  // With a tiny queue, most of the boxes are explored in depth-first order.
+  config_.mutable_best_first_max_queue_size() = 1;
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  context.Assert(sin(x_) == y_);
+  const auto result = context.CheckSat();
+  ASSERT_TRUE(result);
+  const double x{(*result)[x_].mid()};
+  const double y{(*result)[y_].mid()};
+  EXPECT_NEAR(x * x + y * y, 1.0, 0.01);
+  EXPECT_NEAR(std::sin(x), y, 0.01);
+}
+
+TEST_F(IcpTest, TrailDeltaSat) {
+  config_.mutable_exploration_order() = Config::ExplorationOrder::DEPTH_FIRST;
+  optional<Box> results[2];
+  for (const bool use_trail : {false, true}) {
+    config_.mutable_use_trail_icp() = use_trail;
+    Context context{config_};
+    context.DeclareVariable(x_, -10, 10);
+    context.DeclareVariable(y_, -10, 10);
+    context.Assert(x_ * x_ + y_ * y_ == 1.0);
+    context.Assert(sin(x_) == y_);
+    results[use_trail] = context.CheckSat();
+    ASSERT_TRUE(results[use_trail]);
+  }
+  // Both explore the boxes in the same order.
+  EXPECT_EQ(*results[0], *results[1]);
+}
+
+TEST_F(IcpTest, TrailUnsat) {
+  config_.mutable_exploration_order() = Config::ExplorationOrder::DEPTH_FIRST;
+  config_.mutable_use_trail_icp() = true;
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  context.Assert(x_ * x_ + y_ * y_ == 4.0);
+  EXPECT_FALSE(context.CheckSat());
+}
+
+TEST_F(IcpTest, BackjumpingSkipsIrrelevantSibling) {
+  // `x * x - x >= 0.1` has no solution in x ∈ [0, 1], but neither a single
+  // pruning nor the evaluation shows it in the initial box. The ICP first
+  // branches on y, whose interval is wider. The refutation of the first
+  // half only depends on x, so the backjumping skips the second half.
+  config_.mutable_exploration_order() = Config::ExplorationOrder::DEPTH_FIRST;
+  Box box;
+  box.Add(x_, 0, 1);
+  box.Add(y_, -100, 100);
+  const Formula f1{x_ * x_ - x_ >= 0.1};
+  const Formula f2{y_ * y_ >= 1};
+  int num_prunings[2];
+  for (const bool use_backjumping : {false, true}) {
+    config_.mutable_use_trail_icp() = true;
+    config_.mutable_use_icp_backjumping() = use_backjumping;
+    ResourceMonitor resource_monitor{config_, config_.cancellation_token()};
+    const vector<FormulaEvaluator> formula_evaluators{
+        make_relational_formula_evaluator(f1),
+        make_relational_formula_evaluator(f2)};
+    unique_ptr<BranchingStrategy> branching_strategy{MakeBranchingStrategy(
+        config_.branching_heuristic(), formula_evaluators,
+        config_.precision())};
+    // Only f1 is used in pruning steps.
+    Icp icp{make_contractor_ibex_fwdbwd(f1, box), formula_evaluators,
+            move(branching_strategy), config_, &resource_monitor};
+    ContractorStatus cs{box};
+    EXPECT_FALSE(icp.CheckSat(&cs));
+    EXPECT_TRUE(cs.box().empty());
+    EXPECT_EQ(cs.Explanation().count(f1), 1u);
+    num_prunings[use_backjumping] = resource_monitor.num_prunings();
+  }
+  EXPECT_LT(num_prunings[1], num_prunings[0]);
+}
+
+TEST_F(IcpTest, BatchedEvaluationDropsRefutedHalves) {
+  // The contractor does not prune, so the boxes are only refuted by the
+  // evaluation. With the batched evaluation, the refuted halves of a
+  // bisected box are not pushed to the frontier, and they are not pruned.
+  config_.mutable_exploration_order() = Config::ExplorationOrder::DEPTH_FIRST;
+  Box box;
+  box.Add(x_, 0, 1);
+  const Formula f{x_ * x_ - x_ >= 0.1};
+  int num_prunings[2];
+  for (const bool use_batched_evaluation : {false, true}) {
+    config_.mutable_use_batched_evaluation() = use_batched_evaluation;
+    ResourceMonitor resource_monitor{config_, config_.cancellation_token()};
+    const vector<FormulaEvaluator> formula_evaluators{
+        make_relational_formula_evaluator(f)};
+    unique_ptr<BranchingStrategy> branching_strategy{MakeBranchingStrategy(
+        config_.branching_heuristic(), formula_evaluators,
+        config_.precision())};
+    Icp icp{make_contractor_id(), formula_evaluators,
+            move(branching_strategy), config_, &resource_monitor};
+    ContractorStatus cs{box};
+    EXPECT_FALSE(icp.CheckSat(&cs));
+    EXPECT_EQ(cs.Explanation().count(f), 1u);
+    num_prunings[use_batched_evaluation] = resource_monitor.num_prunings();
+  }
+  EXPECT_LT(num_prunings[1], num_prunings[0]);
+}
+
+TEST_F(IcpTest, BatchedEvaluationDeltaSat) {
+  config_.mutable_use_batched_evaluation() = true;
+  Context context{config_};
+  context.DeclareVariable(x_, -10, 10);
+  context.DeclareVariable(y_, -10, 10);
+  context.Assert(x_ * x_ + y_ * y_ == 1.0);
+  context.Assert(sin(x_) == y_);
+  const auto result = context.CheckSat();
+  ASSERT_TRUE(result);
+  const double x{(*result)[x_].mid()};
+  const double y{(*result)[y_].mid()};
+  EXPECT_NEAR(x * x + y * y, 1.0, 0.01);
+  EXPECT_NEAR(std::sin(x), y, 0.01);
+}
+
+TEST_F(IcpTest, BackjumpingWithNogoods) {
+  config_.mutable_exploration_order() = Config::ExplorationOrder::DEPTH_FIRST;
+  config_.mutable_use_icp_backjumping() = true;
+  config_.mutable_icp_nogood_capacity() = 16;
+  {
+    Context context{config_};
+    context.DeclareVariable(x_, -10, 10);
+    context.DeclareVariable(y_, -10, 10);
+    context.Assert(x_ * x_ + y_ * y_ == 1.0);
+    context.Assert(sin(x_) == y_);
+    const auto result = context.CheckSat();
+    ASSERT_TRUE(result);
+    const double x{(*result)[x_].mid()};
+    const double y{(*result)[y_].mid()};
+    EXPECT_NEAR(x * x + y * y, 1.0, 0.01);
+    EXPECT_NEAR(std::sin(x), y, 0.01);
+  }
+  {
+    Context context{config_};
+    context.DeclareVariable(x_, -10, 10);
+    context.DeclareVariable(y_, -10, 10);
+    context.Assert(x_ * x_ + y_ * y_ <= 1.0);
+    context.Assert(sin(10 * x_) * y_ >= 2.0);
+    EXPECT_FALSE(context.CheckSat());
+  }
 }
 
 }  // namespace
@@ -41,5 +41,117 @@ namespace {
 //   }
 // }
 
+GTEST_TEST(SatSolver, AddTheoryPropagation) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  const Formula f1{x > 1};
+  const Formula f2{x < 0};
+  const Formula f3{y == x};
+  SatSolver sat_solver;
+  sat_solver.AddFormula((f1 || f2) && f3);
+  EXPECT_EQ(sat_solver.theory_predicates().size(), 3u);
+
+  // f3 → ¬f1.
+  sat_solver.AddTheoryPropagation({f3}, !f1);
+  const auto model = sat_solver.CheckSat();
+  ASSERT_TRUE(model);
+  for (const SatSolver::Literal& l : model->second) {
+    const Formula& predicate{sat_solver.theory_literal(l.first)};
+    if (predicate.EqualTo(f1)) {
+      EXPECT_FALSE(l.second);
+    } else {
+      EXPECT_TRUE(l.second);
+    }
+  }
+}
+
+GTEST_TEST(SatSolver, PushPop) {
+  const Variable b1{"b1", Variable::Type::BOOLEAN};
+  const Variable b2{"b2", Variable::Type::BOOLEAN};
+  vector<Config::SatSolverBackend> backends{Config::SatSolverBackend::PICOSAT};
+  for (const Config::SatSolverBackend backend : backends) {
+    Config config;
+    config.mutable_sat_solver_backend() = backend;
+    SatSolver sat_solver{config};
+    sat_solver.AddFormula(Formula{b1} || Formula{b2});
+    ASSERT_TRUE(sat_solver.CheckSat());
+
+    sat_solver.Push();
+    sat_solver.AddFormula(!b1);
+    sat_solver.AddFormula(!b2);
+    EXPECT_FALSE(sat_solver.CheckSat()) << backend;
+    sat_solver.Pop();
+
+    // The clauses added in the popped scope are disabled.
+    sat_solver.Push();
+    sat_solver.AddFormula(!b1);
+    const auto model = sat_solver.CheckSat();
+    ASSERT_TRUE(model) << backend;
+    for (const SatSolver::Literal& l : model->first) {
+      EXPECT_EQ(l.second, l.first.equal_to(b2)) << backend;
+    }
+    sat_solver.Pop();
+  }
+}
+
+GTEST_TEST(SatSolver, RepeatedPushPop) {
+  // The variables of a popped scope are reused in the following scopes.
+  // The clauses of a popped scope do not affect them.
+  const Variable b1{"b1", Variable::Type::BOOLEAN};
+  vector<Config::SatSolverBackend> backends{Config::SatSolverBackend::PICOSAT};
+  for (const Config::SatSolverBackend backend : backends) {
+    Config config;
+    config.mutable_sat_solver_backend() = backend;
+    SatSolver sat_solver{config};
+    sat_solver.AddFormula(b1);
+    int num_sat_vars{0};
+    for (int i = 0; i < 100; ++i) {
+      const Variable b2{"b2", Variable::Type::BOOLEAN};
+      const Variable b3{"b3", Variable::Type::BOOLEAN};
+      sat_solver.Push();
+      sat_solver.AddFormula(!b1 || (i % 2 == 0 ? Formula{b2} : !b2));
+      sat_solver.AddFormula(!b2 || b3);
+      const auto model = sat_solver.CheckSat();
+      ASSERT_TRUE(model) << backend;
+      for (const SatSolver::Literal& l : model->first) {
+        if (l.first.equal_to(b2)) {
+          EXPECT_EQ(l.second, i % 2 == 0) << backend;
+        }
+      }
+      sat_solver.Pop();
+      if (i == 0) {
+        num_sat_vars = sat_solver.num_sat_vars();
+      }
+      EXPECT_EQ(sat_solver.num_sat_vars(), num_sat_vars) << backend;
+    }
+    EXPECT_TRUE(sat_solver.CheckSat()) << backend;
+  }
+}
+
+GTEST_TEST(SatSolver, PushPopTheoryPredicates) {
+  const Variable x{"x"};
+  const Formula f1{x >= 0};
+  const Formula f2{x <= 5};
+  SatSolver sat_solver;
+  sat_solver.AddFormula(f1);
+  sat_solver.Push();
+  sat_solver.AddFormula(f1 || f2);
+  EXPECT_EQ(sat_solver.theory_predicates().size(), 2u);
+  const auto model = sat_solver.CheckSat();
+  ASSERT_TRUE(model);
+  EXPECT_EQ(model->second.size(), 2u);
+  sat_solver.Pop();
+
+  // The abstraction of f2 and its SAT variable are removed.
+  const vector<Formula> predicates{sat_solver.theory_predicates()};
+  ASSERT_EQ(predicates.size(), 1u);
+  EXPECT_TRUE(predicates[0].EqualTo(f1));
+  const auto model_after_pop = sat_solver.CheckSat();
+  ASSERT_TRUE(model_after_pop);
+  ASSERT_EQ(model_after_pop->second.size(), 1u);
+  EXPECT_TRUE(
+      sat_solver.theory_literal(model_after_pop->second[0].first).EqualTo(f1));
+}
+
 }  // namespace
 }  // namespace dreal
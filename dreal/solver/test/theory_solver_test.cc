@@ -1,16 +1,255 @@
 #include "dreal/solver/theory_solver.h"
 
+#include <cmath>
 #include <iostream>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "dreal/util/ibex_constraint_cache.h"
+
 namespace dreal {
 namespace {
 
+using std::vector;
+
 GTEST_TEST(TheorySolver, Test) {
   // TODO(soonho): Add more tests.
 }
 
+class TheorySolverIncrementalTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    config_.mutable_precision() = 0.001;
+    config_.mutable_use_incremental_icp() = true;
+    box_.Add(x_, -10, 10);
+    box_.Add(y_, -10, 10);
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  Config config_;
+  Box box_;
+};
+
+TEST_F(TheorySolverIncrementalTest, ReuseSharedLiterals) {
+  ResourceMonitor resource_monitor{config_, config_.cancellation_token()};
+  TheorySolver theory_solver{config_, box_, &resource_monitor};
+  const Formula f1{x_ * x_ + y_ * y_ == 1.0};
+  const Formula f2{x_ >= 2};
+  const Formula f3{x_ >= 0.5};
+
+  // {f1, f2} is UNSAT.
+  EXPECT_FALSE(theory_solver.CheckSat(box_, {f1, f2}));
+  const auto explanation = theory_solver.GetExplanation();
+  EXPECT_TRUE(explanation.count(f1) > 0);
+  EXPECT_TRUE(explanation.count(f2) > 0);
+
+  // {f1, f3} shares f1 with the previous check.
+  EXPECT_TRUE(theory_solver.CheckSat(box_, {f1, f3}));
+  const Box model{theory_solver.GetModel()};
+  EXPECT_GE(model[x_].ub(), 0.5);
+  const double x{model[x_].mid()};
+  const double y{model[y_].mid()};
+  EXPECT_NEAR(x * x + y * y, 1.0, 0.01);
+
+  // The trail should not leak the pruning by f2 and f3 into {f1}.
+  EXPECT_TRUE(theory_solver.CheckSat(box_, {f1, x_ <= -0.5}));
+  EXPECT_LE(theory_solver.GetModel()[x_].lb(), -0.5);
+}
+
+TEST_F(TheorySolverIncrementalTest, NewRoot) {
+  ResourceMonitor resource_monitor{config_, config_.cancellation_token()};
+  TheorySolver theory_solver{config_, box_, &resource_monitor};
+  const Formula f{x_ * x_ + y_ * y_ == 1.0};
+  EXPECT_TRUE(theory_solver.CheckSat(box_, {f}));
+
+  // The trail is not valid for a different root box.
+  Box box{box_};
+  box[x_] = Box::Interval(2, 3);
+  EXPECT_FALSE(theory_solver.CheckSat(box, {f}));
+}
+
+TEST_F(TheorySolverIncrementalTest, Propagate) {
+  config_.mutable_use_incremental_icp() = false;
+  config_.mutable_use_theory_propagation() = true;
+  ResourceMonitor resource_monitor{config_, config_.cancellation_token()};
+  TheorySolver theory_solver{config_, box_, &resource_monitor};
+  const Formula f1{x_ >= 2};
+  const Formula f2{y_ == x_};
+  const Formula f3{y_ <= 1};
+  EXPECT_FALSE(theory_solver.CheckSat(box_, {f1, f2, f3}));
+
+  // {f1, f2} prunes the box into x, y ∈ [2, 10].
+  const Formula p1{y_ > 0};  // Implied.
+  const Formula p2{x_ < 5};  // Not decided.
+  const TheorySolver::Propagation propagation{
+      theory_solver.Propagate({f1, f3, p1, p2})};
+  ASSERT_EQ(propagation.literals.size(), 2u);
+  EXPECT_TRUE(propagation.literals[0].EqualTo(!f3));
+  EXPECT_TRUE(propagation.literals[1].EqualTo(p1));
+  EXPECT_TRUE(propagation.reason.count(f1) > 0);
+  EXPECT_TRUE(propagation.reason.count(f2) > 0);
+  EXPECT_EQ(propagation.reason.count(f3), 0u);
+}
+
+GTEST_TEST(TheorySolver, MinimizeExplanation) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  Config config;
+  config.mutable_use_explanation_minimizer() = true;
+  Box box;
+  box.Add(x, -10, 10);
+  box.Add(y, -10, 10);
+  ResourceMonitor resource_monitor{config, config.cancellation_token()};
+  TheorySolver theory_solver{config, box, &resource_monitor};
+
+  const Formula f1{x * x + y * y == 1.0};
+  const Formula f2{x >= 2};
+  // f3 and f4 share the variable y with f1 but they are not needed to
+  // refute f1 ∧ f2.
+  const Formula f3{y >= 0};
+  const Formula f4{y <= 5};
+  EXPECT_FALSE(theory_solver.CheckSat(box, {f3, f1, f4, f2}));
+  const auto explanation = theory_solver.GetExplanation();
+  EXPECT_EQ(explanation.size(), 2u);
+  EXPECT_TRUE(explanation.count(f1) > 0);
+  EXPECT_TRUE(explanation.count(f2) > 0);
+}
+
+GTEST_TEST(TheorySolver, SharedFwdbwd) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  const Variable z{"z"};
+  Config config;
+  config.mutable_use_shared_fwdbwd() = true;
+  Box box;
+  box.Add(x, -10, 10);
+  box.Add(y, -10, 10);
+  box.Add(z, -10, 10);
+  ResourceMonitor resource_monitor{config, config.cancellation_token()};
+  TheorySolver theory_solver{config, box, &resource_monitor};
+
+  // f1 and f2 share x² + y². f3 does not share a variable with them.
+  const Expression r{x * x + y * y};
+  const Formula f1{r <= 4};
+  const Formula f2{r >= 1};
+  const Formula f3{sin(z) == 0.5};
+  EXPECT_TRUE(theory_solver.CheckSat(box, {f1, f2, f3}));
+  const Box model{theory_solver.GetModel()};
+  const double x_mid{model[x].mid()};
+  const double y_mid{model[y].mid()};
+  EXPECT_GE(x_mid * x_mid + y_mid * y_mid, 1.0 - 0.01);
+  EXPECT_LE(x_mid * x_mid + y_mid * y_mid, 4.0 + 0.01);
+  EXPECT_NEAR(std::sin(model[z].mid()), 0.5, 0.01);
+
+  // The explanation does not include f3, which is pruned by a separate
+  // contractor.
+  const Formula f4{r >= 5};
+  EXPECT_FALSE(theory_solver.CheckSat(box, {f1, f4, f3}));
+  const auto explanation = theory_solver.GetExplanation();
+  EXPECT_TRUE(explanation.count(f1) > 0);
+  EXPECT_TRUE(explanation.count(f4) > 0);
+  EXPECT_EQ(explanation.count(f3), 0u);
+}
+
+GTEST_TEST(TheorySolver, SharedFwdbwdWithTheoryPredicates) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  Config config;
+  config.mutable_use_shared_fwdbwd() = true;
+  Box box;
+  box.Add(x, -10, 10);
+  box.Add(y, -10, 10);
+  ResourceMonitor resource_monitor{config, config.cancellation_token()};
+  TheorySolver theory_solver{config, box, &resource_monitor};
+
+  const Expression r{x * x + y * y};
+  const Formula f1{r <= 4};
+  const Formula f2{r >= 1};
+  const Formula f3{r >= 5};
+  // log(x) is not defined for x ≤ 0, so f4 is not merged into the group.
+  const Formula f4{log(x) + y >= 0};
+  theory_solver.set_theory_predicates({f1, f2, f3, f4});
+
+  // f3 is in the group of f1 and f2 but it is not asserted.
+  EXPECT_TRUE(theory_solver.CheckSat(box, {f1, f2}));
+  const int num_misses{IbexConstraintCache::Global().num_misses()};
+
+  // The function of the group is compiled once for the checks.
+  EXPECT_TRUE(theory_solver.CheckSat(box, {f1, !f3, f2}));
+  EXPECT_FALSE(theory_solver.CheckSat(box, {f1, f3}));
+  EXPECT_EQ(IbexConstraintCache::Global().num_misses(), num_misses);
+  const auto explanation = theory_solver.GetExplanation();
+  EXPECT_EQ(explanation.size(), 2u);
+
+  // A check without f4 has a solution with x < 0.
+  Box box2{box};
+  box2[x] = Box::Interval(-1, -0.1);
+  EXPECT_TRUE(theory_solver.CheckSat(box2, {f1, f2}));
+}
+
+GTEST_TEST(TheorySolver, SharedCache) {
+  const Variable x{"x"};
+  Config config;
+  Box box;
+  box.Add(x, -10, 10);
+  ResourceMonitor resource_monitor{config, config.cancellation_token()};
+  TheorySolver::Cache cache;
+  const Formula f1{x * x == 4.0};
+  // Note that a bound constraint such as `x >= 0` does not need a
+  // contractor.
+  const Formula f2{x * x <= 0.5};
+  {
+    TheorySolver theory_solver{config, box, &resource_monitor, &cache};
+    EXPECT_TRUE(theory_solver.CheckSat(box, {f1}));
+  }
+  EXPECT_EQ(cache.contractors.size(), 1u);
+  EXPECT_EQ(cache.formula_evaluators.size(), 1u);
+
+  // A new theory solver reuses the contractor of f1 with different bounds.
+  cache.contractors.push();
+  cache.formula_evaluators.push();
+  box[x] = Box::Interval(-1, 1);
+  {
+    TheorySolver theory_solver{config, box, &resource_monitor, &cache};
+    EXPECT_FALSE(theory_solver.CheckSat(box, {f1, f2}));
+  }
+  EXPECT_EQ(cache.contractors.size(), 2u);
+
+  // Popping the cache removes the contractor of f2.
+  cache.contractors.pop();
+  cache.formula_evaluators.pop();
+  EXPECT_EQ(cache.contractors.size(), 1u);
+  EXPECT_EQ(cache.contractors.count(f1), 1u);
+}
+
+GTEST_TEST(TheorySolver, SmearConstraintCache) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  Config config;
+  config.mutable_branching_heuristic() = Config::BranchingHeuristic::SMEAR;
+  Box box;
+  box.Add(x, -10, 10);
+  box.Add(y, -10, 10);
+  ResourceMonitor resource_monitor{config, config.cancellation_token()};
+  TheorySolver::Cache cache;
+  const Formula f1{x * x + y * y == 4.0};
+  const Formula f2{x * y >= 1.0};
+  TheorySolver theory_solver{config, box, &resource_monitor, &cache};
+  EXPECT_TRUE(theory_solver.CheckSat(box, {f1}));
+  EXPECT_EQ(cache.smear_constraints.size(), 1u);
+  const auto smear_constraint = cache.smear_constraints.find(f1)->second;
+
+  // The next check reuses the constraint of f1.
+  cache.smear_constraints.push();
+  EXPECT_TRUE(theory_solver.CheckSat(box, {f1, f2}));
+  EXPECT_EQ(cache.smear_constraints.size(), 2u);
+  EXPECT_EQ(cache.smear_constraints.find(f1)->second, smear_constraint);
+
+  cache.smear_constraints.pop();
+  EXPECT_EQ(cache.smear_constraints.size(), 1u);
+}
+
 }  // namespace
 }  // namespace dreal
@@ -1,35 +1,80 @@
 #include "dreal/solver/theory_solver.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 #include <utility>
 
 #include "dreal/contractor/contractor_forall.h"
 #include "dreal/solver/assertion_filter.h"
+#include "dreal/solver/branching_strategy.h"
 #include "dreal/solver/context.h"
 #include "dreal/solver/formula_evaluator.h"
 #include "dreal/solver/icp.h"
+#include "dreal/solver/icp_parallel.h"
 #include "dreal/util/assert.h"
 #include "dreal/util/logging.h"
+#include "dreal/util/math.h"
 
 namespace dreal {
 
+using std::any_of;
+using std::atomic;
+using std::cout;
 using std::experimental::optional;
+using std::lock_guard;
+using std::map;
 using std::move;
+using std::mutex;
 using std::numeric_limits;
+using std::set;
+using std::shared_ptr;
+using std::unique_ptr;
+using std::unordered_map;
 using std::unordered_set;
 using std::vector;
 
-TheorySolver::TheorySolver(const Config& config, const Box& box)
-    : config_{config}, contractor_status_{box} {}
+TheorySolver::TheorySolver(const Config& config, const Box& box,
+                           ResourceMonitor* const resource_monitor,
+                           Cache* const cache)
+    : config_{config},
+      resource_monitor_{resource_monitor},
+      contractor_status_{box},
+      cache_{cache ? cache : &own_cache_} {
+  DREAL_ASSERT(resource_monitor_);
+}
 
 TheorySolver::~TheorySolver() {
   DREAL_LOG_DEBUG(
       "TheorySolver::~TheorySolver() - # of TheorySolver::CheckSat() = {}",
       num_check_sat);
+  DREAL_LOG_DEBUG(
+      "TheorySolver::~TheorySolver() - # of reused trail entries = {}",
+      num_reused_trail_entries);
+  DREAL_LOG_DEBUG(
+      "TheorySolver::~TheorySolver() - # of propagated literals = {}",
+      num_propagated_literals);
 }
 
 namespace {
+// IBEX numbers expression nodes using a global counter which is not
+// thread-safe. Building (or cloning) contractors creates IBEX expressions,
+// so we serialize it with this mutex. It allows the solvers in the
+// portfolio mode to run theory solvers concurrently.
+mutex& ibex_mutex() {
+  static mutex m;
+  return m;
+}
+
+// The worklist fixpoint passes the intervals of the changed dimensions
+// only, not the whole boxes.
 bool DefaultTerminationCondition(const Box::IntervalVector& old_iv,
                                  const Box::IntervalVector& new_iv) {
   DREAL_ASSERT(!new_iv.is_empty());
@@ -59,6 +104,195 @@ bool DefaultTerminationCondition(const Box::IntervalVector& old_iv,
   // computation
   return true;
 }
+
+// Returns a termination condition which also stops a fixed-point
+// computation when @p cancellation_token is cancelled.
+TerminationCondition MakeTerminationCondition(
+    const CancellationToken& cancellation_token) {
+  return [cancellation_token](const Box::IntervalVector& old_iv,
+                              const Box::IntervalVector& new_iv) {
+    return cancellation_token.is_cancelled() ||
+           DefaultTerminationCondition(old_iv, new_iv);
+  };
+}
+
+// A class to show statistics information at destruction. We have a
+// static instance in TheorySolver::SetUnsat() to keep track of the
+// explanation sizes before and after minimization.
+class ExplanationMinimizerStat {
+ public:
+  ExplanationMinimizerStat() = default;
+  ~ExplanationMinimizerStat() {
+    if (DREAL_LOG_INFO_ENABLED && num_minimization_ > 0) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Minimization",
+            "Explanation level", num_minimization_.load());
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total size of explanations (before)", "Explanation level",
+            total_size_before_.load());
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total size of explanations (after)", "Explanation level",
+            total_size_after_.load());
+    }
+  }
+  atomic<int> num_minimization_{0};
+  atomic<int64_t> total_size_before_{0};
+  atomic<int64_t> total_size_after_{0};
+};
+
+// Returns true if @p box1 and @p box2 have the same variables and the
+// non-Boolean variables have the same domains in them.
+bool HaveSameNonBooleanDomains(const Box& box1, const Box& box2) {
+  if (box1.size() != box2.size()) {
+    return false;
+  }
+  for (int i = 0; i < box1.size(); ++i) {
+    if (!box1.variable(i).equal_to(box2.variable(i))) {
+      return false;
+    }
+    if (box1.variable(i).get_type() != Variable::Type::BOOLEAN &&
+        box1[i] != box2[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the midpoints of the intervals in @p model, arranged in the order
+// of the variables in @p box. It uses NaN for a variable which is not in
+// @p model or whose interval is empty.
+vector<double> MakeWarmStartPoint(const Box& model, const Box& box) {
+  vector<double> point(box.size(), numeric_limits<double>::quiet_NaN());
+  for (int i = 0; i < box.size(); ++i) {
+    const Variable& var{box.variable(i)};
+    if (model.has_variable(var) && !model[var].is_empty()) {
+      point[i] = model[var].mid();
+    }
+  }
+  return point;
+}
+
+// Returns true if the contractor of @p f built with @p box can be shared by
+// the following CheckSat calls, which may have different domains. It is
+// false if @p f is a forall formula, or if @p box has a point domain for
+// a free variable of @p f, which IbexConverter replaces by its value.
+bool IsShareable(const Formula& f, const Box& box) {
+  if (is_forall(f)) {
+    return false;
+  }
+  for (const Variable& var : f.GetFreeVariables()) {
+    if (box[var].is_degenerated()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the root of @p i in the union-find forest @p parent.
+size_t FindRoot(vector<size_t>* const parent, size_t i) {
+  while ((*parent)[i] != i) {
+    (*parent)[i] = (*parent)[(*parent)[i]];
+    i = (*parent)[i];
+  }
+  return i;
+}
+
+// Partitions @p formulas into groups which do not share a variable with
+// each other. A group is the positions of its formulas in @p formulas.
+// The groups are in the order of their first elements.
+vector<vector<size_t>> GroupByVariables(const vector<Formula>& formulas) {
+  vector<size_t> parent(formulas.size());
+  for (size_t k = 0; k < formulas.size(); ++k) {
+    parent[k] = k;
+  }
+  // Variable → the position of the first formula including it.
+  unordered_map<Variable, size_t, hash_value<Variable>> first_occurrence;
+  for (size_t k = 0; k < formulas.size(); ++k) {
+    for (const Variable& var : formulas[k].GetFreeVariables()) {
+      const auto it = first_occurrence.find(var);
+      if (it == first_occurrence.end()) {
+        first_occurrence.emplace(var, k);
+      } else {
+        parent[FindRoot(&parent, k)] = FindRoot(&parent, it->second);
+      }
+    }
+  }
+  vector<vector<size_t>> groups;
+  // Root → the position of its group in `groups`.
+  unordered_map<size_t, size_t> group_of_root;
+  for (size_t k = 0; k < formulas.size(); ++k) {
+    const size_t root{FindRoot(&parent, k)};
+    const auto it = group_of_root.find(root);
+    if (it == group_of_root.end()) {
+      group_of_root.emplace(root, groups.size());
+      groups.push_back({k});
+    } else {
+      groups[it->second].push_back(k);
+    }
+  }
+  return groups;
+}
+
+// Returns @p f without its negations.
+const Formula& GetAtom(const Formula& f) {
+  const Formula* g{&f};
+  while (is_negation(*g)) {
+    g = &get_operand(*g);
+  }
+  return *g;
+}
+
+// Returns true if @p e is defined and finite for every finite value of
+// its variables. Its interval evaluation is never empty, so the backward
+// sweep of IBEX does not narrow its variables with the target (-∞, ∞).
+bool IsTotal(const Expression& e) {
+  if (is_constant(e) || is_variable(e)) {
+    return true;
+  }
+  // Returns true if `base^exponent` is total.
+  const auto is_total_power = [](const Expression& base,
+                                 const Expression& exponent) {
+    return is_constant(exponent) && is_integer(get_constant_value(exponent)) &&
+           get_constant_value(exponent) >= 0 && IsTotal(base);
+  };
+  if (is_addition(e)) {
+    for (const auto& p : get_expr_to_coeff_map_in_addition(e)) {
+      if (!IsTotal(p.first)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (is_multiplication(e)) {
+    for (const auto& p : get_base_to_exponent_map_in_multiplication(e)) {
+      if (!is_total_power(p.first, p.second)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (is_pow(e)) {
+    return is_total_power(get_first_argument(e), get_second_argument(e));
+  }
+  if (is_sin(e) || is_cos(e) || is_exp(e) || is_atan(e) || is_sinh(e) ||
+      is_cosh(e) || is_tanh(e) || is_abs(e)) {
+    return IsTotal(get_argument(e));
+  }
+  if (is_min(e) || is_max(e)) {
+    return IsTotal(get_first_argument(e)) && IsTotal(get_second_argument(e));
+  }
+  // Division, log, sqrt, tan, asin, acos, atan2, if-then-else, and
+  // uninterpreted functions.
+  return false;
+}
+
+// Returns true if the literals of @p atom can be merged into a shared
+// contractor. A shared contractor evaluates @p atom even when neither of
+// its literals is asserted, so it should not prune a box by itself.
+bool IsShareableAtom(const Formula& atom) {
+  return is_relational(atom) && IsTotal(get_lhs_expression(atom)) &&
+         IsTotal(get_rhs_expression(atom));
+}
 }  // namespace
 
 optional<Contractor> TheorySolver::BuildContractor(
@@ -66,8 +300,22 @@ optional<Contractor> TheorySolver::BuildContractor(
   if (assertions.empty()) {
     return make_contractor_integer(*box);
   }
+  const TerminationCondition term_cond{
+      MakeTerminationCondition(config_.cancellation_token())};
   vector<Contractor> ctcs;
-  for (const Formula& f : assertions) {
+  if (config_.use_shared_fwdbwd() && !has_theory_predicates_) {
+    // Group the atoms of the assertions of this call.
+    vector<Formula> atoms;
+    for (const Formula& f : assertions) {
+      atoms.push_back(GetAtom(f));
+    }
+    SetSharedAtoms(atoms);
+  }
+  // The position of a group in `shared_atom_groups_` → the indices of the
+  // assertions whose atoms are in the group.
+  map<size_t, vector<size_t>> shared_indices;
+  for (size_t i = 0; i < assertions.size(); ++i) {
+    const Formula& f{assertions[i]};
     switch (FilterAssertion(f, box)) {
       case FilterAssertionResult::NotFiltered:
         /* No OP */
@@ -81,26 +329,34 @@ optional<Contractor> TheorySolver::BuildContractor(
       case FilterAssertionResult::FilteredWithoutChange:
         continue;
     }
-    auto it = contractor_cache_.find(f);
-    if (it == contractor_cache_.end()) {
-      // There is no contractor for `f`, build one.
-      DREAL_LOG_DEBUG("TheorySolver::BuildContractor: {}", f);
-      if (is_forall(f)) {
-        // We should have `inner_delta < epsilon < delta`.
-        const double epsilon = config_.precision() * 0.99;
-        const double inner_delta = epsilon * 0.99;
-        const Contractor ctc{make_contractor_forall<Context>(
-            f, *box, epsilon, inner_delta, config_.use_polytope_in_forall())};
-        ctcs.emplace_back(
-            make_contractor_fixpoint(DefaultTerminationCondition, {ctc}));
-      } else {
-        ctcs.emplace_back(make_contractor_ibex_fwdbwd(f, *box));
+    if (config_.use_shared_fwdbwd()) {
+      const auto it = shared_group_of_atom_.find(GetAtom(f));
+      if (it != shared_group_of_atom_.end()) {
+        shared_indices[it->second].push_back(i);
+        continue;
       }
-      // Add it to the cache.
-      contractor_cache_.emplace_hint(it, f, ctcs.back());
+    }
+    ctcs.push_back(GetContractor(f, *box));
+    // The ICP numbers the constraints in the order of `assertions`. It
+    // skips this contractor in a box entailing the i-th assertion.
+    ctcs.back().set_constraint_id(i);
+  }
+  // Merge the assertions in the same group. The shared contractor of a
+  // group is built from the function compiled from all the atoms of the
+  // group, which is taken from IbexConstraintCache. A single assertion has
+  // nothing to share and keeps its own contractor.
+  for (const auto& p : shared_indices) {
+    const vector<size_t>& indices{p.second};
+    if (indices.size() == 1) {
+      ctcs.push_back(GetContractor(assertions[indices[0]], *box));
+      ctcs.back().set_constraint_id(indices[0]);
     } else {
-      // Cache hit!
-      ctcs.emplace_back(it->second);
+      vector<Formula> formulas;
+      for (const size_t i : indices) {
+        formulas.push_back(assertions[i]);
+      }
+      ctcs.push_back(make_contractor_ibex_shared_fwdbwd(
+          move(formulas), shared_atom_groups_[p.first], *box));
     }
   }
   // Add integer contractor.
@@ -111,11 +367,164 @@ optional<Contractor> TheorySolver::BuildContractor(
     ctcs.push_back(make_contractor_ibex_polytope(assertions, *box));
   }
   if (config_.use_worklist_fixpoint()) {
-    return make_contractor_worklist_fixpoint(DefaultTerminationCondition,
-                                             move(ctcs));
+    return make_contractor_worklist_fixpoint(
+        term_cond, move(ctcs), config_.use_adaptive_scheduling(),
+        config_.propagation_threshold());
   } else {
-    return make_contractor_fixpoint(DefaultTerminationCondition, move(ctcs));
+    return make_contractor_fixpoint(term_cond, move(ctcs),
+                                    config_.use_adaptive_scheduling());
+  }
+}
+
+Contractor TheorySolver::GetContractor(const Formula& f, const Box& box) {
+  if (IsShareable(f, box)) {
+    auto it = cache_->contractors.find(f);
+    if (it != cache_->contractors.end()) {
+      // Cache hit!
+      return it->second;
+    }
+    DREAL_LOG_DEBUG("TheorySolver::GetContractor: {}", f);
+    const Contractor ctc{make_contractor_ibex_fwdbwd(f, box)};
+    cache_->contractors.insert(f, ctc);
+    return ctc;
+  }
+  auto it = contractor_cache_.find(f);
+  if (it != contractor_cache_.end()) {
+    // Cache hit!
+    return it->second;
+  }
+  // There is no contractor for `f`, build one.
+  DREAL_LOG_DEBUG("TheorySolver::GetContractor: {}", f);
+  optional<Contractor> ctc;
+  if (is_forall(f)) {
+    // We should have `inner_delta < epsilon < delta`.
+    const double epsilon = config_.precision() * 0.99;
+    const double inner_delta = epsilon * 0.99;
+    const Contractor ctc_forall{make_contractor_forall<Context>(
+        f, box, epsilon, inner_delta, config_.use_polytope_in_forall(),
+        config_.cancellation_token())};
+    ctc = make_contractor_fixpoint(
+        MakeTerminationCondition(config_.cancellation_token()), {ctc_forall});
+  } else {
+    ctc = make_contractor_ibex_fwdbwd(f, box);
+  }
+  // Add it to the cache.
+  contractor_cache_.emplace_hint(it, f, *ctc);
+  return *ctc;
+}
+
+void TheorySolver::PruneWithLiteral(
+    const Formula& f, ContractorStatus* const contractor_status) {
+  switch (FilterAssertion(f, &contractor_status->mutable_box())) {
+    case FilterAssertionResult::NotFiltered:
+      break;
+    case FilterAssertionResult::FilteredWithChange:
+      contractor_status->AddUsedConstraint(f);
+      return;
+    case FilterAssertionResult::FilteredWithoutChange:
+      return;
+  }
+  optional<Contractor> ctc;
+  {
+    lock_guard<mutex> lock{ibex_mutex()};
+    ctc = GetContractor(f, contractor_status->box());
+  }
+  ctc->Prune(contractor_status);
+}
+
+ContractorStatus TheorySolver::PruneWithTrail(
+    const Box& box, const vector<Formula>& assertions) {
+  if (!trail_root_ || !HaveSameNonBooleanDomains(*trail_root_, box)) {
+    trail_.clear();
+    trail_root_ = box;
+  }
+
+  // Keep the longest prefix of the trail whose literals are still active.
+  const unordered_set<Formula, hash_value<Formula>> active_literals(
+      assertions.begin(), assertions.end());
+  unordered_set<Formula, hash_value<Formula>> literals_on_trail;
+  size_t n{0};
+  while (n < trail_.size() && active_literals.count(trail_[n].literal) > 0) {
+    literals_on_trail.insert(trail_[n].literal);
+    ++n;
+  }
+  trail_.erase(trail_.begin() + n, trail_.end());
+  num_reused_trail_entries += n;
+
+  // Extend the trail with the other literals. We stop as soon as the box
+  // becomes empty.
+  for (const Formula& f : assertions) {
+    if (!trail_.empty() && trail_.back().contractor_status.box().empty()) {
+      break;
+    }
+    if (!literals_on_trail.insert(f).second) {
+      continue;
+    }
+    ContractorStatus contractor_status{
+        trail_.empty() ? ContractorStatus{*trail_root_}
+                       : trail_.back().contractor_status};
+    PruneWithLiteral(f, &contractor_status);
+    trail_.push_back(TrailEntry{f, move(contractor_status)});
+  }
+
+  if (trail_.empty()) {
+    return ContractorStatus{box};
   }
+  ContractorStatus result{trail_.back().contractor_status};
+  Box& result_box{result.mutable_box()};
+  if (!result_box.empty()) {
+    // The Boolean variables are not in the theory literals. Take their
+    // values from the given box.
+    for (int i = 0; i < box.size(); ++i) {
+      if (box.variable(i).get_type() == Variable::Type::BOOLEAN) {
+        result_box[i] = box[i];
+      }
+    }
+  }
+  return result;
+}
+
+TheorySolver::Propagation TheorySolver::Propagate(
+    const vector<Formula>& predicates) {
+  DREAL_ASSERT(config_.use_theory_propagation());
+  Propagation propagation;
+  // Find the deepest non-empty entry in the trail.
+  auto it = trail_.rbegin();
+  while (it != trail_.rend() && it->contractor_status.box().empty()) {
+    ++it;
+  }
+  if (it == trail_.rend()) {
+    return propagation;
+  }
+  unordered_set<Formula, hash_value<Formula>> prefix;
+  for (auto it_prefix = it; it_prefix != trail_.rend(); ++it_prefix) {
+    prefix.insert(it_prefix->literal);
+  }
+  const ContractorStatus& contractor_status{it->contractor_status};
+  const Box& box{contractor_status.box()};
+  for (const Formula& p : predicates) {
+    if (is_forall(p) || prefix.count(p) > 0 || prefix.count(!p) > 0) {
+      continue;
+    }
+    const FormulaEvaluator formula_evaluator{BuildFormulaEvaluator({p})[0]};
+    switch (formula_evaluator(box).type()) {
+      case FormulaEvaluationResult::Type::VALID:
+        propagation.literals.push_back(p);
+        break;
+      case FormulaEvaluationResult::Type::UNSAT:
+        propagation.literals.push_back(!p);
+        break;
+      case FormulaEvaluationResult::Type::UNKNOWN:
+        break;
+    }
+  }
+  if (!propagation.literals.empty()) {
+    DREAL_LOG_DEBUG("TheorySolver::Propagate() - # of implied literals = {}",
+                    propagation.literals.size());
+    propagation.reason = contractor_status.used_constraints();
+    num_propagated_literals += propagation.literals.size();
+  }
+  return propagation;
 }
 
 vector<FormulaEvaluator> TheorySolver::BuildFormulaEvaluator(
@@ -126,16 +535,24 @@ vector<FormulaEvaluator> TheorySolver::BuildFormulaEvaluator(
   const double epsilon = 0.99 * delta;
   const double inner_delta = 0.99 * epsilon;
   for (const Formula& f : assertions) {
-    auto it = formula_evaluator_cache_.find(f);
-    if (it == formula_evaluator_cache_.end()) {
-      DREAL_LOG_DEBUG("TheorySolver::BuildFormulaEvaluator: {}", f);
-      if (is_forall(f)) {
-        formula_evaluators.push_back(
-            make_forall_formula_evaluator(f, epsilon, inner_delta));
+    if (is_forall(f)) {
+      auto it = formula_evaluator_cache_.find(f);
+      if (it == formula_evaluator_cache_.end()) {
+        DREAL_LOG_DEBUG("TheorySolver::BuildFormulaEvaluator: {}", f);
+        formula_evaluators.push_back(make_forall_formula_evaluator(
+            f, epsilon, inner_delta, config_.cancellation_token()));
+        formula_evaluator_cache_.emplace_hint(
+            it, f, formula_evaluators.back());
       } else {
-        formula_evaluators.push_back(make_relational_formula_evaluator(f));
+        formula_evaluators.push_back(it->second);
       }
-      formula_evaluator_cache_.emplace_hint(it, f, formula_evaluators.back());
+      continue;
+    }
+    auto it = cache_->formula_evaluators.find(f);
+    if (it == cache_->formula_evaluators.end()) {
+      DREAL_LOG_DEBUG("TheorySolver::BuildFormulaEvaluator: {}", f);
+      formula_evaluators.push_back(make_relational_formula_evaluator(f));
+      cache_->formula_evaluators.insert(f, formula_evaluators.back());
     } else {
       formula_evaluators.push_back(it->second);
     }
@@ -143,32 +560,211 @@ vector<FormulaEvaluator> TheorySolver::BuildFormulaEvaluator(
   return formula_evaluators;
 }
 
+unique_ptr<BranchingStrategy> TheorySolver::BuildBranchingStrategy(
+    const vector<Formula>& assertions) {
+  vector<shared_ptr<const SmearConstraint>> smear_constraints;
+  if (config_.branching_heuristic() == Config::BranchingHeuristic::SMEAR) {
+    for (const Formula& f : assertions) {
+      auto it = cache_->smear_constraints.find(f);
+      if (it == cache_->smear_constraints.end()) {
+        DREAL_LOG_DEBUG("TheorySolver::BuildBranchingStrategy: {}", f);
+        cache_->smear_constraints.insert(f, MakeSmearConstraint(f));
+        it = cache_->smear_constraints.find(f);
+      }
+      if (it->second) {
+        smear_constraints.push_back(it->second);
+      }
+    }
+  }
+  return MakeBranchingStrategy(config_.branching_heuristic(),
+                               move(smear_constraints), config_.precision());
+}
+
 bool TheorySolver::CheckSat(const Box& box, const vector<Formula>& assertions) {
   num_check_sat++;
   DREAL_LOG_DEBUG("TheorySolver::CheckSat()");
   DREAL_ASSERT(box.size() > 0);
-  contractor_status_ = ContractorStatus(box);
+  if (config_.use_incremental_icp() || config_.use_theory_propagation()) {
+    contractor_status_ = PruneWithTrail(box, assertions);
+    if (contractor_status_.box().empty()) {
+      SetUnsat(box);
+      return false;
+    }
+  } else {
+    contractor_status_ = ContractorStatus(box);
+  }
 
   // Icp Step
-  const auto contractor =
-      BuildContractor(&contractor_status_.mutable_box(), assertions);
+  optional<Contractor> contractor;
+  {
+    lock_guard<mutex> lock{ibex_mutex()};
+    contractor = BuildContractor(&contractor_status_.mutable_box(), assertions);
+  }
   if (contractor) {
-    Icp icp(*contractor, BuildFormulaEvaluator(assertions),
-            config_.precision());
-    icp.CheckSat(&contractor_status_);
+    const int number_of_jobs{config_.number_of_jobs()};
+    // Forall contractors and evaluators run nested contexts, which are not
+    // safe to use from multiple threads. We fall back to the sequential ICP
+    // in that case.
+    if (number_of_jobs > 1 &&
+        !any_of(assertions.begin(), assertions.end(),
+                [](const Formula& f) { return is_forall(f); })) {
+      // Each worker needs its own clone of the contractor because
+      // contractors keep mutable states inside.
+      vector<Contractor> contractors{*contractor};
+      contractors.reserve(number_of_jobs);
+      {
+        lock_guard<mutex> lock{ibex_mutex()};
+        for (int i = 1; i < number_of_jobs; ++i) {
+          contractors.push_back(contractor->Clone());
+        }
+      }
+      vector<FormulaEvaluator> formula_evaluators{
+          BuildFormulaEvaluator(assertions)};
+      unique_ptr<BranchingStrategy> branching_strategy{
+          BuildBranchingStrategy(assertions)};
+      IcpParallel icp(move(contractors), move(formula_evaluators),
+                      config_.precision(), move(branching_strategy),
+                      config_.cancellation_token(), resource_monitor_);
+      icp.CheckSat(&contractor_status_);
+    } else {
+      vector<FormulaEvaluator> formula_evaluators{
+          BuildFormulaEvaluator(assertions)};
+      unique_ptr<BranchingStrategy> branching_strategy{
+          BuildBranchingStrategy(assertions)};
+      Icp icp(*contractor, move(formula_evaluators), move(branching_strategy),
+              config_, resource_monitor_);
+      if (config_.use_warm_start() && warm_start_model_) {
+        icp.set_warm_start_point(
+            MakeWarmStartPoint(*warm_start_model_, contractor_status_.box()));
+      }
+      icp.CheckSat(&contractor_status_);
+    }
     if (contractor_status_.box().empty()) {
-      status_ = Status::UNSAT;
+      SetUnsat(box);
       return false;
     } else {
       status_ = Status::SAT;
       return true;
     }
   } else {
-    status_ = Status::UNSAT;
+    SetUnsat(box);
     return false;
   }
 }
 
+void TheorySolver::set_warm_start_model(const Box& model) {
+  warm_start_model_ = model;
+}
+
+void TheorySolver::set_theory_predicates(const vector<Formula>& predicates) {
+  SetSharedAtoms(predicates);
+  has_theory_predicates_ = true;
+}
+
+void TheorySolver::SetSharedAtoms(const vector<Formula>& atoms) {
+  shared_atom_groups_.clear();
+  shared_group_of_atom_.clear();
+  vector<Formula> shareable_atoms;
+  for (const Formula& atom : atoms) {
+    if (IsShareableAtom(atom)) {
+      shareable_atoms.push_back(atom);
+    }
+  }
+  for (const vector<size_t>& group : GroupByVariables(shareable_atoms)) {
+    if (group.size() == 1) {
+      // It has nothing to share.
+      continue;
+    }
+    set<Formula> group_atoms;
+    for (const size_t k : group) {
+      group_atoms.insert(shareable_atoms[k]);
+      shared_group_of_atom_.emplace(shareable_atoms[k],
+                                    shared_atom_groups_.size());
+    }
+    shared_atom_groups_.push_back(move(group_atoms));
+  }
+}
+
+void TheorySolver::SetUnsat(const Box& box) {
+  static ExplanationMinimizerStat stat;
+  status_ = Status::UNSAT;
+  explanation_ = contractor_status_.Explanation();
+  if (!config_.use_explanation_minimizer() ||
+      config_.cancellation_token().is_cancelled()) {
+    return;
+  }
+  const int size_before = explanation_.size();
+  explanation_ = MinimizeExplanation(box, explanation_);
+  const int size_after = explanation_.size();
+  DREAL_LOG_DEBUG(
+      "TheorySolver::SetUnsat() - size of explanation = {} -> {}",
+      size_before, size_after);
+  stat.num_minimization_++;
+  stat.total_size_before_ += size_before;
+  stat.total_size_after_ += size_after;
+}
+
+unordered_set<Formula, hash_value<Formula>> TheorySolver::MinimizeExplanation(
+    const Box& box,
+    const unordered_set<Formula, hash_value<Formula>>& explanation) {
+  vector<Formula> core(explanation.begin(), explanation.end());
+  int budget{config_.explanation_minimizer_budget()};
+  // The UNSAT result may come from branching. In that case, pruning alone
+  // cannot refute the explanation and we do not minimize it.
+  --budget;
+  if (!IsRefutedByPruning(box, core)) {
+    return explanation;
+  }
+  size_t i{0};
+  while (i < core.size() && budget > 0 &&
+         !config_.cancellation_token().is_cancelled()) {
+    vector<Formula> candidate;
+    candidate.reserve(core.size() - 1);
+    for (size_t j = 0; j < core.size(); ++j) {
+      if (j != i) {
+        candidate.push_back(core[j]);
+      }
+    }
+    --budget;
+    if (IsRefutedByPruning(box, candidate)) {
+      // core[i] is not needed.
+      core = move(candidate);
+    } else {
+      ++i;
+    }
+  }
+  return unordered_set<Formula, hash_value<Formula>>(core.begin(),
+                                                     core.end());
+}
+
+bool TheorySolver::IsRefutedByPruning(const Box& box,
+                                      const vector<Formula>& formulas) {
+  ContractorStatus contractor_status{box};
+  Box& current_box{contractor_status.mutable_box()};
+  vector<Contractor> ctcs;
+  for (const Formula& f : formulas) {
+    switch (FilterAssertion(f, &current_box)) {
+      case FilterAssertionResult::NotFiltered:
+        break;
+      case FilterAssertionResult::FilteredWithChange:
+        if (current_box.empty()) {
+          return true;
+        }
+        continue;
+      case FilterAssertionResult::FilteredWithoutChange:
+        continue;
+    }
+    lock_guard<mutex> lock{ibex_mutex()};
+    ctcs.push_back(GetContractor(f, current_box));
+  }
+  ctcs.push_back(make_contractor_integer(current_box));
+  const Contractor fixpoint{make_contractor_fixpoint(
+      MakeTerminationCondition(config_.cancellation_token()), move(ctcs))};
+  fixpoint.Prune(&contractor_status);
+  resource_monitor_->AddPruning();
+  return current_box.empty();
+}
+
 Box TheorySolver::GetModel() const {
   DREAL_ASSERT(status_ == Status::SAT);
   DREAL_LOG_DEBUG("TheorySolver::GetModel():\n{}", contractor_status_.box());
@@ -178,7 +774,7 @@ Box TheorySolver::GetModel() const {
 const unordered_set<Formula, hash_value<Formula>> TheorySolver::GetExplanation()
     const {
   DREAL_ASSERT(status_ == Status::UNSAT);
-  return contractor_status_.Explanation();
+  return explanation_;
 }
 
 }  // namespace dreal
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -7,10 +8,13 @@
 #include <experimental/optional>
 
 #include "dreal/contractor/contractor.h"
+#include "dreal/solver/branching_strategy.h"
 #include "dreal/solver/config.h"
 #include "dreal/solver/formula_evaluator.h"
+#include "dreal/solver/resource_monitor.h"
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
+#include "dreal/util/scoped_unordered_map.h"
 
 namespace dreal {
 
@@ -22,8 +26,38 @@ class TheorySolver {
     UNSAT,
   };
 
+  /// Result of theory propagation. Each literal in `literals` is implied
+  /// by the conjunction of the formulas in `reason`.
+  struct Propagation {
+    std::vector<Formula> literals;
+    std::unordered_set<Formula, hash_value<Formula>> reason;
+  };
+
+  /// Contractors and formula evaluators compiled from theory literals. A
+  /// Context keeps one across its CheckSat calls and scopes it with
+  /// push/pop, so that a literal is compiled only once. The entries depend
+  /// on the variables of a box but not on their domains. The ones for
+  /// forall formulas are not stored here because they depend on the
+  /// precision and the cancellation token of a call. Neither are the
+  /// contractors specialized to the point domains of a box.
+  struct Cache {
+    ScopedUnorderedMap<Formula, Contractor, hash_value<Formula>> contractors;
+    ScopedUnorderedMap<Formula, FormulaEvaluator, hash_value<Formula>>
+        formula_evaluators;
+    // The constraints of the smear-based branching strategy. It maps a
+    // forall formula to nullptr.
+    ScopedUnorderedMap<Formula, std::shared_ptr<const SmearConstraint>,
+                       hash_value<Formula>>
+        smear_constraints;
+  };
+
   TheorySolver() = delete;
-  TheorySolver(const Config& config, const Box& box);
+  /// Constructs a theory solver. @p resource_monitor records the
+  /// branching and pruning operations in the ICP steps. If @p cache is
+  /// not nullptr, the theory solver reuses and extends it. Otherwise, it
+  /// uses its own cache.
+  TheorySolver(const Config& config, const Box& box,
+               ResourceMonitor* resource_monitor, Cache* cache = nullptr);
   ~TheorySolver();
 
   /// Checks consistency. Returns true if there is a satisfying
@@ -33,6 +67,23 @@ class TheorySolver {
   /// does nothing.
   bool CheckSat(const Box& box, const std::vector<Formula>& assertions);
 
+  /// Sets the model of a previous check to warm-start the ICP from. The
+  /// ICP explores the branches containing the model first. It is used if
+  /// `config.use_warm_start()` is true. The variables in @p model which
+  /// are not in the box given to CheckSat are ignored.
+  ///
+  /// @note The parallel ICP does not use it.
+  void set_warm_start_model(const Box& model);
+
+  /// Sets the theory predicates of the assertions given to the following
+  /// CheckSat calls. It is used if `config.use_shared_fwdbwd()` is true.
+  /// The predicates sharing variables are grouped once, and the assertions
+  /// of a group are merged into a contractor using the function compiled
+  /// from all the predicates of the group. So a group is compiled once for
+  /// all the calls. Without the predicates, the groups are made from the
+  /// assertions of each call.
+  void set_theory_predicates(const std::vector<Formula>& predicates);
+
   /// Gets a satisfying Model.
   ///
   /// @pre status_ is SAT.
@@ -42,6 +93,16 @@ class TheorySolver {
   /// @pre status_ is UNSAT.
   const std::unordered_set<Formula, hash_value<Formula>> GetExplanation() const;
 
+  /// Finds the theory literals implied by the last CheckSat call. It takes
+  /// the deepest non-empty box in the trail, which is the box pruned by a
+  /// prefix of the assertions, and evaluates each predicate p in
+  /// @p predicates on it. If p (resp. ¬p) holds in the whole box, the
+  /// literal p (resp. ¬p) is implied by the constraints used to prune the
+  /// box. It skips the predicates which are in the prefix.
+  ///
+  /// @pre `config.use_theory_propagation()` is true.
+  Propagation Propagate(const std::vector<Formula>& predicates);
+
  private:
   // Builds a contractor using @p box and @p assertions. It returns
   // nullopt if it detects an empty box while building a contractor.
@@ -53,18 +114,96 @@ class TheorySolver {
   std::vector<FormulaEvaluator> BuildFormulaEvaluator(
       const std::vector<Formula>& assertions);
 
+  // Returns the branching strategy of `config_` for @p assertions. The
+  // constraints of the smear-based strategy are taken from the cache.
+  std::unique_ptr<BranchingStrategy> BuildBranchingStrategy(
+      const std::vector<Formula>& assertions);
+
+  // Returns the contractor for @p f. It builds one using @p box if it is
+  // not in the cache.
+  //
+  // @note The caller should hold the lock of the IBEX mutex.
+  Contractor GetContractor(const Formula& f, const Box& box);
+
+  // Sets shared_atom_groups_ and shared_group_of_atom_ from @p atoms. It
+  // skips the atoms which cannot be shared and the groups of a single
+  // atom.
+  void SetSharedAtoms(const std::vector<Formula>& atoms);
+
+  // Returns a contractor status whose box is @p box pruned by
+  // @p assertions. It reuses the trail entries of the literals which are
+  // still in @p assertions and extends the trail with the others.
+  ContractorStatus PruneWithTrail(const Box& box,
+                                  const std::vector<Formula>& assertions);
+
+  // Prunes the box in @p contractor_status with a theory literal @p f.
+  void PruneWithLiteral(const Formula& f, ContractorStatus* contractor_status);
+
+  // Sets the status UNSAT and stores the explanation of the contractor
+  // status in `explanation_`. It minimizes the explanation if
+  // `config_.use_explanation_minimizer()` is true. @p box is the box given
+  // to CheckSat.
+  void SetUnsat(const Box& box);
+
+  // Shrinks @p explanation by deletion. It removes a formula from the
+  // explanation if the others are still refuted by pruning @p box. It
+  // returns @p explanation as it is if the pruning cannot refute
+  // @p explanation itself.
+  std::unordered_set<Formula, hash_value<Formula>> MinimizeExplanation(
+      const Box& box,
+      const std::unordered_set<Formula, hash_value<Formula>>& explanation);
+
+  // Returns true if pruning @p box with @p formulas, without branching,
+  // results in an empty box.
+  bool IsRefutedByPruning(const Box& box, const std::vector<Formula>& formulas);
+
+  // An entry of the trail. `contractor_status` has the root box pruned by
+  // `literal` and the literals of the previous entries, with the constraints
+  // used in the pruning.
+  struct TrailEntry {
+    Formula literal;
+    ContractorStatus contractor_status;
+  };
+
   const Config& config_;
+  ResourceMonitor* const resource_monitor_{};
   Status status_{Status::UNCHECKED};
   ContractorStatus contractor_status_;
+  // Explanation of the last UNSAT result.
+  std::unordered_set<Formula, hash_value<Formula>> explanation_;
   // const Nnfizer nnfizer_;
 
+  Cache own_cache_;
+  Cache* const cache_{};
+  // Contractors and formula evaluators which are not in `cache_`. See the
+  // comment of Cache.
   std::unordered_map<Formula, Contractor, hash_value<Formula>>
       contractor_cache_;
   std::unordered_map<Formula, FormulaEvaluator, hash_value<Formula>>
       formula_evaluator_cache_;
 
+  // Used when `config_.use_incremental_icp()` or
+  // `config_.use_theory_propagation()` is true. The trail is valid
+  // while the non-Boolean variables have the same domains in `trail_root_`
+  // and the box given to CheckSat.
+  std::experimental::optional<Box> trail_root_;
+  std::vector<TrailEntry> trail_;
+
+  // Used when `config_.use_warm_start()` is true.
+  std::experimental::optional<Box> warm_start_model_;
+
+  // Used when `config_.use_shared_fwdbwd()` is true. The atoms of the
+  // theory predicates partitioned into the groups which share variables,
+  // and the position of the group of each atom.
+  bool has_theory_predicates_{false};
+  std::vector<std::set<Formula>> shared_atom_groups_;
+  std::unordered_map<Formula, size_t, hash_value<Formula>>
+      shared_group_of_atom_;
+
   // stat
   int num_check_sat{0};
+  int num_reused_trail_entries{0};
+  int num_propagated_literals{0};
 };
 
 }  // namespace dreal
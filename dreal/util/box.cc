@@ -97,7 +97,7 @@ void Box::Add(const Variable& v, const double lb, const double ub) {
   DREAL_ASSERT(v.get_type() != Variable::Type::INTEGER ||
                (is_integer(lb) && is_integer(ub)));
 
-  values_[(*var_to_idx_)[v]] = Interval{lb, ub};
+  values_[var_to_idx_->at(v)] = Interval{lb, ub};
 }
 
 bool Box::empty() const { return values_.is_empty(); }
@@ -111,21 +111,25 @@ Box::Interval& Box::operator[](const int i) {
   return values_[i];
 }
 Box::Interval& Box::operator[](const Variable& var) {
-  return values_[(*var_to_idx_)[var]];
+  return values_[var_to_idx_->at(var)];
 }
 const Box::Interval& Box::operator[](const int i) const {
   DREAL_ASSERT(i < size());
   return values_[i];
 }
 const Box::Interval& Box::operator[](const Variable& var) const {
-  return values_[(*var_to_idx_)[var]];
+  return values_[var_to_idx_->at(var)];
 }
 
 const vector<Variable>& Box::variables() const { return *variables_; }
 
-const Variable& Box::variable(const int i) const { return (*idx_to_var_)[i]; }
+const Variable& Box::variable(const int i) const { return idx_to_var_->at(i); }
 
-int Box::index(const Variable& var) const { return (*var_to_idx_)[var]; }
+int Box::index(const Variable& var) const { return var_to_idx_->at(var); }
+
+bool Box::has_variable(const Variable& var) const {
+  return var_to_idx_->count(var) > 0;
+}
 
 const Box::IntervalVector& Box::interval_vector() const { return values_; }
 Box::IntervalVector& Box::mutable_interval_vector() { return values_; }
@@ -144,7 +148,28 @@ pair<double, int> Box::MaxDiam() const {
 }
 
 pair<Box, Box> Box::bisect(const int i) const {
-  const Variable& var{(*idx_to_var_)[i]};
+  const pair<Interval, Interval> bisected_intervals{bisect_interval(i)};
+  Box b1{*this};
+  Box b2{*this};
+  b1[i] = bisected_intervals.first;
+  b2[i] = bisected_intervals.second;
+  return make_pair(b1, b2);
+}
+
+pair<Box, Box> Box::bisect(const Variable& var) const {
+  auto it = var_to_idx_->find(var);
+  if (it != var_to_idx_->end()) {
+    return bisect(it->second);
+  } else {
+    ostringstream oss;
+    oss << "Variable " << var << " is not found in this box.";
+    throw DREAL_RUNTIME_ERROR(oss.str());
+  }
+  return bisect(var_to_idx_->at(var));
+}
+
+pair<Box::Interval, Box::Interval> Box::bisect_interval(const int i) const {
+  const Variable& var{idx_to_var_->at(i)};
   if (!values_[i].is_bisectable()) {
     ostringstream oss;
     oss << "Variable " << var << " = " << values_[i]
@@ -164,19 +189,7 @@ pair<Box, Box> Box::bisect(const int i) const {
   DREAL_UNREACHABLE();
 }
 
-pair<Box, Box> Box::bisect(const Variable& var) const {
-  auto it = var_to_idx_->find(var);
-  if (it != var_to_idx_->end()) {
-    return bisect(it->second);
-  } else {
-    ostringstream oss;
-    oss << "Variable " << var << " is not found in this box.";
-    throw DREAL_RUNTIME_ERROR(oss.str());
-  }
-  return bisect((*var_to_idx_)[var]);
-}
-
-pair<Box, Box> Box::bisect_int(const int i) const {
+pair<Box::Interval, Box::Interval> Box::bisect_int(const int i) const {
   DREAL_ASSERT(idx_to_var_->at(i).get_type() == Variable::Type::INTEGER ||
                idx_to_var_->at(i).get_type() == Variable::Type::BINARY);
   const Interval& intv_i{values_[i]};
@@ -188,23 +201,12 @@ pair<Box, Box> Box::bisect_int(const int i) const {
   DREAL_ASSERT(lb <= mid_floor);
   DREAL_ASSERT(mid_floor + 1 <= ub);
   DREAL_ASSERT(ub <= intv_i.ub());
-
-  Box b1{*this};
-  Box b2{*this};
-  b1[i] = Interval(lb, mid_floor);
-  b2[i] = Interval(mid_floor + 1, ub);
-  return make_pair(b1, b2);
+  return make_pair(Interval(lb, mid_floor), Interval(mid_floor + 1, ub));
 }
 
-pair<Box, Box> Box::bisect_continuous(const int i) const {
+pair<Box::Interval, Box::Interval> Box::bisect_continuous(const int i) const {
   DREAL_ASSERT(idx_to_var_->at(i).get_type() == Variable::Type::CONTINUOUS);
-  Box b1{*this};
-  Box b2{*this};
-  const Interval intv_i{values_[i]};
-  pair<Interval, Interval> bisected_intervals{intv_i.bisect(0.5)};
-  b1[i] = bisected_intervals.first;
-  b2[i] = bisected_intervals.second;
-  return make_pair(b1, b2);
+  return values_[i].bisect(0.5);
 }
 
 Box& Box::InplaceUnion(const Box& b) {
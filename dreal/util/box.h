@@ -82,6 +82,9 @@ class Box {
   /// Returns the index associated with @p var.
   int index(const Variable& var) const;
 
+  /// Returns true if @p var is a variable of the box.
+  bool has_variable(const Variable& var) const;
+
   /// Returns the max diameter of the box and the associated index .
   std::pair<double, int> MaxDiam() const;
 
@@ -93,21 +96,27 @@ class Box {
   /// @throws std::runtime if @p i -th dimension is not bisectable.
   std::pair<Box, Box> bisect(const Variable& var) const;
 
+  /// Returns the two intervals obtained by bisecting the @p i -th
+  /// dimension. `bisect(i)` returns the copies of this box whose @p i -th
+  /// intervals are replaced by them.
+  /// @throws std::runtime if @p i -th dimension is not bisectable.
+  std::pair<Interval, Interval> bisect_interval(int i) const;
+
   /// Updates the current box by taking union with @p b.
   ///
   /// @pre variables() == b.variables().
   Box& InplaceUnion(const Box& b);
 
  private:
-  /// Bisects the box at @p i -th dimension.
+  /// Bisects the @p i -th interval of the box.
   /// @pre i-th variable is bisectable.
   /// @pre i-th variable is of integer type.
-  std::pair<Box, Box> bisect_int(int i) const;
+  std::pair<Interval, Interval> bisect_int(int i) const;
 
-  /// Bisects the box at @p i -th dimension.
+  /// Bisects the @p i -th interval of the box.
   /// @pre i-th variable is bisectable.
   /// @pre i-th variable is of continuous type.
-  std::pair<Box, Box> bisect_continuous(int i) const;
+  std::pair<Interval, Interval> bisect_continuous(int i) const;
 
   std::shared_ptr<std::vector<Variable>> variables_;
 
@@ -0,0 +1,74 @@
+#include "dreal/util/box_batch.h"
+
+#include <limits>
+
+#include "dreal/util/assert.h"
+
+namespace dreal {
+
+using std::numeric_limits;
+using std::vector;
+
+BoxBatch::BoxBatch(const vector<Box>& boxes)
+    : layout_{boxes.at(0)}, size_{static_cast<int>(boxes.size())} {
+  const int n{layout_.size()};
+  lb_.resize(n * size_);
+  ub_.resize(n * size_);
+  for (int k = 0; k < size_; ++k) {
+    const Box& box{boxes[k]};
+    DREAL_ASSERT(box.size() == n);
+    for (int i = 0; i < n; ++i) {
+      Set(i, k, box[i]);
+    }
+  }
+}
+
+BoxBatch::BoxBatch(const Box& box, const int i,
+                   const vector<Box::Interval>& intervals)
+    : layout_{box}, size_{static_cast<int>(intervals.size())} {
+  DREAL_ASSERT(size_ > 0);
+  DREAL_ASSERT(0 <= i && i < box.size());
+  const int n{layout_.size()};
+  lb_.resize(n * size_);
+  ub_.resize(n * size_);
+  for (int j = 0; j < n; ++j) {
+    for (int k = 0; k < size_; ++k) {
+      Set(j, k, j == i ? intervals[k] : box[j]);
+    }
+  }
+}
+
+Box::Interval BoxBatch::interval(const int i, const int k) const {
+  const int pos{i * size_ + k};
+  // NaN is not equal to itself.
+  if (lb_[pos] != lb_[pos]) {
+    return Box::Interval::EMPTY_SET;
+  }
+  return Box::Interval{lb_[pos], ub_[pos]};
+}
+
+Box BoxBatch::box(const int k) const {
+  DREAL_ASSERT(0 <= k && k < size_);
+  Box box{layout_};
+  for (int i = 0; i < box.size(); ++i) {
+    box[i] = interval(i, k);
+    if (box[i].is_empty()) {
+      box.set_empty();
+      break;
+    }
+  }
+  return box;
+}
+
+void BoxBatch::Set(const int i, const int k, const Box::Interval& iv) {
+  const int pos{i * size_ + k};
+  if (iv.is_empty()) {
+    lb_[pos] = numeric_limits<double>::quiet_NaN();
+    ub_[pos] = numeric_limits<double>::quiet_NaN();
+  } else {
+    lb_[pos] = iv.lb();
+    ub_[pos] = iv.ub();
+  }
+}
+
+}  // namespace dreal
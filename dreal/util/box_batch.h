@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+
+/// Represents a batch of boxes over the same variables in a
+/// structure-of-arrays layout. For each dimension i, the lower bounds of
+/// the i-th intervals of all the boxes are stored contiguously, and so are
+/// the upper bounds. The k-th box of the batch is called its k-th lane.
+///
+/// An empty interval is stored as [NaN, NaN].
+class BoxBatch {
+ public:
+  /// Constructs a batch from @p boxes.
+  ///
+  /// @pre @p boxes is not empty.
+  /// @pre All the boxes in @p boxes have the same variables.
+  explicit BoxBatch(const std::vector<Box>& boxes);
+
+  /// Constructs a batch of copies of @p box. The @p i -th interval of the
+  /// k-th copy is `intervals[k]`.
+  ///
+  /// @pre @p intervals is not empty.
+  BoxBatch(const Box& box, int i, const std::vector<Box::Interval>& intervals);
+
+  /// Returns the number of boxes in the batch.
+  int size() const { return size_; }
+
+  /// Returns the dimension of the boxes.
+  int dimension() const { return layout_.size(); }
+
+  /// Returns the lower bounds of the @p i -th intervals of the boxes.
+  const double* lb(int i) const { return &lb_[i * size_]; }
+
+  /// Returns the upper bounds of the @p i -th intervals of the boxes.
+  const double* ub(int i) const { return &ub_[i * size_]; }
+
+  /// Returns the @p i -th interval of the @p k -th box.
+  Box::Interval interval(int i, int k) const;
+
+  /// Returns a copy of the @p k -th box.
+  Box box(int k) const;
+
+  /// Returns the index associated with @p var.
+  int index(const Variable& var) const { return layout_.index(var); }
+
+  /// Returns the variables of the boxes.
+  const std::vector<Variable>& variables() const {
+    return layout_.variables();
+  }
+
+ private:
+  // Stores @p iv as the @p i -th interval of the @p k -th box.
+  void Set(int i, int k, const Box::Interval& iv);
+
+  // Box over the variables of the batch. It maps variables to indices. Its
+  // intervals are not used.
+  const Box layout_;
+  const int size_{};
+  std::vector<double> lb_;
+  std::vector<double> ub_;
+};
+
+}  // namespace dreal
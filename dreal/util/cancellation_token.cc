@@ -0,0 +1,42 @@
+#include "dreal/util/cancellation_token.h"
+
+#include <utility>
+
+namespace dreal {
+
+using std::make_shared;
+using std::move;
+using std::shared_ptr;
+
+CancellationToken::CancellationToken() : state_{make_shared<State>()} {}
+
+CancellationToken::CancellationToken(shared_ptr<const State> parent)
+    : CancellationToken{} {
+  state_->parent = move(parent);
+}
+
+CancellationToken CancellationToken::MakeChild() const {
+  return CancellationToken{state_};
+}
+
+void CancellationToken::Cancel() const { state_->cancelled = true; }
+
+void CancellationToken::set_deadline(const Clock::time_point deadline) const {
+  state_->deadline = deadline.time_since_epoch().count();
+  state_->has_deadline = true;
+}
+
+bool CancellationToken::is_cancelled() const { return IsCancelled(*state_); }
+
+bool CancellationToken::IsCancelled(const State& state) {
+  if (state.cancelled) {
+    return true;
+  }
+  if (state.has_deadline &&
+      Clock::now().time_since_epoch().count() >= state.deadline) {
+    return true;
+  }
+  return state.parent && IsCancelled(*state.parent);
+}
+
+}  // namespace dreal
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace dreal {
+
+/// Cancellation token shared by a solver and the parties which want to
+/// stop it. Copies of a token share the same state, so cancelling one of
+/// them cancels all of them. Long-running loops (e.g. ICP) poll the token
+/// and return early once it is cancelled.
+///
+/// A token is also cancelled when its deadline has passed or when its
+/// parent token is cancelled (see MakeChild()).
+///
+/// It is safe to call the methods of a token from multiple threads.
+class CancellationToken {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Constructs a token which is not cancelled.
+  CancellationToken();
+
+  /// Returns a new token which is cancelled when this token is
+  /// cancelled. Cancelling the child does not cancel this token.
+  CancellationToken MakeChild() const;
+
+  /// Requests cancellation. Once cancelled, a token stays cancelled.
+  void Cancel() const;
+
+  /// Sets the deadline of this token to @p deadline. The token is regarded
+  /// as cancelled after @p deadline.
+  void set_deadline(Clock::time_point deadline) const;
+
+  /// Returns true if cancellation is requested.
+  bool is_cancelled() const;
+
+ private:
+  struct State {
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> has_deadline{false};
+    std::atomic<Clock::rep> deadline{0};
+    std::shared_ptr<const State> parent;
+  };
+
+  explicit CancellationToken(std::shared_ptr<const State> parent);
+
+  static bool IsCancelled(const State& state);
+
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace dreal
@@ -0,0 +1,218 @@
+#include "dreal/util/ibex_constraint_cache.h"
+
+#include <iostream>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "dreal/util/assert.h"
+#include "dreal/util/ibex_converter.h"
+#include "dreal/util/logging.h"
+
+namespace dreal {
+
+using std::cout;
+using std::lock_guard;
+using std::make_shared;
+using std::move;
+using std::mutex;
+using std::set;
+using std::shared_ptr;
+using std::vector;
+
+namespace {
+// Replaces the variables of @p f which have point domains in @p box with
+// their values, as IbexConverter does.
+Formula SubstitutePointDomains(const Formula& f, const Box& box) {
+  ExpressionSubstitution subst;
+  for (const Variable& var : f.GetFreeVariables()) {
+    const Box::Interval& iv{box[var]};
+    if (iv.is_degenerated()) {
+      subst.emplace(var, iv.lb());
+    }
+  }
+  return subst.empty() ? f : f.Substitute(subst);
+}
+
+// Approximate memory usage of an expression node and of a variable in a
+// compiled constraint, including the evaluation scratch of ibex::Function.
+constexpr size_t kNodeMemoryUsage{256};
+constexpr size_t kVariableMemoryUsage{64};
+
+// Returns the approximate memory usage of @p compiled in bytes.
+size_t EstimateMemoryUsage(const CompiledIbexConstraint& compiled) {
+  size_t memory_usage{sizeof(CompiledIbexConstraint)};
+  if (compiled.num_ctr) {
+    memory_usage += kNodeMemoryUsage * compiled.expr_ctr->e.size +
+                    kVariableMemoryUsage * compiled.num_ctr->f.nb_var();
+  }
+  if (compiled.function) {
+    memory_usage += kNodeMemoryUsage * compiled.function->expr().size +
+                    kVariableMemoryUsage * compiled.function->nb_var();
+  }
+  return memory_usage;
+}
+}  // namespace
+
+IbexConstraintCache::IbexConstraintCache(const int capacity,
+                                         const size_t max_memory_usage)
+    : capacity_{capacity}, max_memory_usage_{max_memory_usage} {
+  DREAL_ASSERT(capacity_ > 0);
+}
+
+IbexConstraintCache::~IbexConstraintCache() {
+  if (DREAL_LOG_INFO_ENABLED && num_hits_ + num_misses_ > 0) {
+    using fmt::print;
+    print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Cache hits",
+          "IBEX constraint level", num_hits_);
+    print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Cache misses",
+          "IBEX constraint level", num_misses_);
+  }
+}
+
+shared_ptr<const CompiledIbexConstraint> IbexConstraintCache::Get(
+    const Formula& f, const Box& box) {
+  return Get(f, box.variables(), box);
+}
+
+shared_ptr<const CompiledIbexConstraint> IbexConstraintCache::Get(
+    const Formula& f, const vector<Variable>& variables, const Box& box) {
+  lock_guard<mutex> lock{mutex_};
+  return Find(Key{SubstitutePointDomains(f, box), variables, false},
+              [](const Key& key, CompiledIbexConstraint* const compiled) {
+                // The point domains are already substituted in `key.f`.
+                IbexConverter ibex_converter{key.variables};
+                compiled->expr_ctr.reset(ibex_converter.Convert(key.f));
+                if (compiled->expr_ctr) {
+                  compiled->num_ctr.reset(new ibex::NumConstraint(
+                      ibex_converter.variables(), *compiled->expr_ctr));
+                }
+              });
+}
+
+shared_ptr<const CompiledIbexConstraint> IbexConstraintCache::GetShared(
+    const set<Formula>& atoms, const vector<Variable>& variables) {
+  DREAL_ASSERT(!atoms.empty());
+  lock_guard<mutex> lock{mutex_};
+  return Find(
+      Key{make_conjunction(atoms), variables, true},
+      [&atoms](const Key& key, CompiledIbexConstraint* const compiled) {
+        // The converter shares the nodes of the equal subexpressions among
+        // the outputs.
+        IbexConverter ibex_converter{key.variables};
+        ibex::Array<const ibex::ExprNode> outputs;
+        for (const Formula& atom : atoms) {
+          DREAL_ASSERT(is_relational(atom));
+          const Expression& lhs{get_lhs_expression(atom)};
+          const Expression& rhs{get_rhs_expression(atom)};
+          const ibex::ExprNode* const lhs_node{
+              ibex_converter.ConvertShared(lhs)};
+          if (is_constant(rhs) && get_constant_value(rhs) == 0.0) {
+            outputs.add(*lhs_node);
+          } else {
+            outputs.add(*lhs_node - *ibex_converter.ConvertShared(rhs));
+          }
+        }
+        if (outputs.size() == 1) {
+          compiled->function.reset(
+              new ibex::Function{ibex_converter.variables(), outputs[0]});
+        } else {
+          compiled->function.reset(
+              new ibex::Function{ibex_converter.variables(),
+                                 ibex::ExprVector::new_col(outputs)});
+        }
+      });
+}
+
+shared_ptr<const CompiledIbexConstraint> IbexConstraintCache::Find(
+    Key key, const std::function<void(const Key&, CompiledIbexConstraint*)>&
+                 compile) {
+  const auto it = index_.find(key);
+  if (it != index_.end()) {
+    // Cache hit! Move the entry to the front.
+    ++num_hits_;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->compiled;
+  }
+  ++num_misses_;
+  DREAL_LOG_DEBUG("IbexConstraintCache::Find: Compile {}", key.f);
+  auto compiled = make_shared<CompiledIbexConstraint>();
+  compile(key, compiled.get());
+  const size_t memory_usage{EstimateMemoryUsage(*compiled)};
+  MakeRoom(memory_usage);
+  entries_.push_front(Entry{move(key), compiled, memory_usage});
+  index_.emplace(entries_.front().key, entries_.begin());
+  memory_usage_ += memory_usage;
+  return compiled;
+}
+
+void IbexConstraintCache::MakeRoom(const size_t memory_usage) {
+  // An entry larger than the limit is still cached, alone.
+  while (!entries_.empty() &&
+         (static_cast<int>(entries_.size()) >= capacity_ ||
+          memory_usage_ + memory_usage > max_memory_usage_)) {
+    // Evict the least recently used entry. The users of the entry still
+    // own it.
+    memory_usage_ -= entries_.back().memory_usage;
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+void IbexConstraintCache::Clear() {
+  lock_guard<mutex> lock{mutex_};
+  index_.clear();
+  entries_.clear();
+  memory_usage_ = 0;
+}
+
+int IbexConstraintCache::size() const {
+  lock_guard<mutex> lock{mutex_};
+  return entries_.size();
+}
+
+size_t IbexConstraintCache::memory_usage() const {
+  lock_guard<mutex> lock{mutex_};
+  return memory_usage_;
+}
+
+int IbexConstraintCache::num_hits() const {
+  lock_guard<mutex> lock{mutex_};
+  return num_hits_;
+}
+
+int IbexConstraintCache::num_misses() const {
+  lock_guard<mutex> lock{mutex_};
+  return num_misses_;
+}
+
+IbexConstraintCache& IbexConstraintCache::Global() {
+  // At most 256 MiB of compiled constraints.
+  static IbexConstraintCache cache{1 << 20, size_t{1} << 28};
+  return cache;
+}
+
+size_t IbexConstraintCache::KeyHash::operator()(const Key& key) const {
+  size_t seed{hash_value<Formula>{}(key.f) ^ static_cast<size_t>(key.shared)};
+  for (const Variable& var : key.variables) {
+    seed ^= hash_value<Variable>{}(var) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+  }
+  return seed;
+}
+
+bool IbexConstraintCache::KeyEqual::operator()(const Key& key1,
+                                               const Key& key2) const {
+  if (key1.shared != key2.shared || !key1.f.EqualTo(key2.f) ||
+      key1.variables.size() != key2.variables.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < key1.variables.size(); ++i) {
+    if (!key1.variables[i].equal_to(key2.variables[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace dreal
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "./ibex.h"
+
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+
+/// IBEX constraint compiled from a formula by IbexConverter.
+///
+/// It is immutable once it is in an IbexConstraintCache. IBEX keeps the
+/// scratch space for evaluation inside of an `ibex::Function`, so a user
+/// should evaluate a copy of `num_ctr->f` or `function`, not the compiled
+/// one itself.
+struct CompiledIbexConstraint {
+  std::unique_ptr<const ibex::ExprCtr> expr_ctr;
+  /// It is nullptr if the formula is not converted into an IBEX constraint
+  /// (i.e. a trivially true formula).
+  std::unique_ptr<const ibex::NumConstraint> num_ctr;
+  /// The function compiled by IbexConstraintCache::GetShared(). It is
+  /// nullptr in the other entries.
+  std::unique_ptr<const ibex::Function> function;
+};
+
+/// Thread-safe LRU cache of compiled IBEX constraints.
+///
+/// An entry is keyed by a formula, with the point domains of its
+/// variables substituted as IbexConverter does, and by the variables over
+/// which it is compiled. So the contexts which have the same variables
+/// share the compiled constraints. An entry of GetShared() is keyed by a
+/// set of formulas in the same way.
+///
+/// The cache keeps at most `capacity()` entries whose approximate memory
+/// usage is at most `max_memory_usage()` bytes. The memory usage of an
+/// entry is estimated from the number of nodes in its expression and the
+/// number of its variables, since the compiled constraints of large
+/// problems vary widely in size. It evicts the least recently used
+/// entries when one of the limits is exceeded.
+class IbexConstraintCache {
+ public:
+  /// Constructs a cache which keeps at most @p capacity entries and at
+  /// most @p max_memory_usage bytes of them.
+  explicit IbexConstraintCache(
+      int capacity,
+      size_t max_memory_usage = std::numeric_limits<size_t>::max());
+
+  /// Deleted copy constructor.
+  IbexConstraintCache(const IbexConstraintCache&) = delete;
+
+  /// Deleted copy-assignment operator.
+  IbexConstraintCache& operator=(const IbexConstraintCache&) = delete;
+
+  ~IbexConstraintCache();
+
+  /// Returns the IBEX constraint of @p f over the variables in @p box. It
+  /// compiles @p f if it is not in the cache.
+  ///
+  /// @note IBEX numbers expression nodes using a global counter which is
+  /// not thread-safe. The caller should serialize the IBEX operations,
+  /// including the copy of the returned function, as it does without this
+  /// cache.
+  std::shared_ptr<const CompiledIbexConstraint> Get(const Formula& f,
+                                                    const Box& box);
+
+  /// Returns the IBEX constraint of @p f over @p variables, which should
+  /// include the free variables of @p f. The point domains in @p box are
+  /// substituted as in Get(const Formula&, const Box&).
+  ///
+  /// A contractor compiled over the free variables of its formula only
+  /// works on a sub-vector of a box, whose size does not depend on the
+  /// size of the box.
+  std::shared_ptr<const CompiledIbexConstraint> Get(
+      const Formula& f, const std::vector<Variable>& variables,
+      const Box& box);
+
+  /// Returns the IBEX function over @p variables whose i-th output is
+  /// `lhs - rhs` of the i-th relational formula in @p atoms. The equal
+  /// subexpressions of the formulas are compiled into the same node. The
+  /// point domains of a box are not substituted, so the function does not
+  /// depend on the domains of @p variables.
+  ///
+  /// @pre @p atoms is not empty and every formula in it is relational.
+  std::shared_ptr<const CompiledIbexConstraint> GetShared(
+      const std::set<Formula>& atoms, const std::vector<Variable>& variables);
+
+  /// Removes all the entries. It does not reset the statistics.
+  void Clear();
+
+  /// Returns the maximum number of entries.
+  int capacity() const { return capacity_; }
+
+  /// Returns the maximum memory usage in bytes.
+  size_t max_memory_usage() const { return max_memory_usage_; }
+
+  /// Returns the number of entries.
+  int size() const;
+
+  /// Returns the approximate memory usage of the entries in bytes.
+  size_t memory_usage() const;
+
+  /// Returns the number of the calls of Get() which found an entry.
+  int num_hits() const;
+
+  /// Returns the number of the calls of Get() which compiled a formula.
+  int num_misses() const;
+
+  /// Returns the cache shared by all the contexts in this process.
+  static IbexConstraintCache& Global();
+
+ private:
+  struct Key {
+    Formula f;
+    std::vector<Variable> variables;
+    // True if it is the key of an entry of GetShared(), whose `f` is the
+    // conjunction of the atoms.
+    bool shared;
+  };
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+  struct KeyEqual {
+    bool operator()(const Key& key1, const Key& key2) const;
+  };
+  struct Entry {
+    Key key;
+    std::shared_ptr<const CompiledIbexConstraint> compiled;
+    size_t memory_usage;
+  };
+
+  // Returns the entry of @p key. It calls @p compile to make one if it is
+  // not in the cache.
+  //
+  // @note The caller should hold the lock of mutex_.
+  std::shared_ptr<const CompiledIbexConstraint> Find(
+      Key key,
+      const std::function<void(const Key&, CompiledIbexConstraint*)>& compile);
+
+  // Evicts the least recently used entries until an entry of
+  // @p memory_usage bytes fits in the cache.
+  void MakeRoom(size_t memory_usage);
+
+  const int capacity_{};
+  const size_t max_memory_usage_{};
+  mutable std::mutex mutex_;
+  // The most recently used entry is at the front.
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash, KeyEqual>
+      index_;
+  size_t memory_usage_{0};
+  int num_hits_{0};
+  int num_misses_{0};
+};
+
+}  // namespace dreal
@@ -72,6 +72,17 @@ const ExprNode* IbexConverter::Convert(const Expression& e) {
   return expr_node;
 }
 
+const ExprNode* IbexConverter::ConvertShared(const Expression& e) {
+  DREAL_LOG_DEBUG("IbexConverter::ConvertShared({})", e);
+  share_subexpressions_ = true;
+  const ExprNode* expr_node{Visit(e.Substitute(expression_substitution_))};
+  share_subexpressions_ = false;
+  if (expr_node) {
+    need_to_delete_variables_ = false;
+  }
+  return expr_node;
+}
+
 const ibex::Array<const ibex::ExprSymbol>& IbexConverter::variables() const {
   return var_array_;
 }
@@ -81,7 +92,16 @@ void IbexConverter::set_need_to_delete_variables(const bool value) {
 }
 
 const ExprNode* IbexConverter::Visit(const Expression& e) {
-  return VisitExpression<const ExprNode*>(this, e);
+  if (!share_subexpressions_) {
+    return VisitExpression<const ExprNode*>(this, e);
+  }
+  const auto it = shared_nodes_.find(e);
+  if (it != shared_nodes_.end()) {
+    return it->second;
+  }
+  const ExprNode* const expr_node{VisitExpression<const ExprNode*>(this, e)};
+  shared_nodes_.emplace(e, expr_node);
+  return expr_node;
 }
 
 const ExprNode* IbexConverter::VisitVariable(const Expression& e) {
@@ -54,6 +54,14 @@ class IbexConverter {
   /// @note See the above note in `Convert(const Formula& f)`.
   const ibex::ExprNode* Convert(const Expression& e);
 
+  /// Convert @p e as `Convert(const Expression& e)` does, except that the
+  /// equal subexpressions in the calls of this method are converted into
+  /// the same ibex::ExprNode. So the results form a DAG.
+  ///
+  /// @note The results should be used to construct a single
+  /// `ibex::Function` object, which deletes the shared nodes once.
+  const ibex::ExprNode* ConvertShared(const Expression& e);
+
   const ibex::Array<const ibex::ExprSymbol>& variables() const;
 
   void set_need_to_delete_variables(bool value);
@@ -118,6 +126,13 @@ class IbexConverter {
 
   ExpressionSubstitution expression_substitution_;
 
+  // True while ConvertShared() is running.
+  bool share_subexpressions_{false};
+
+  // Expression → ibex::ExprNode* converted by ConvertShared().
+  std::unordered_map<Expression, const ibex::ExprNode*, hash_value<Expression>>
+      shared_nodes_;
+
   // Variable → ibex::ExprSymbol*.
   std::unordered_map<Variable, const ibex::ExprSymbol*, hash_value<Variable>>
       symbolic_var_to_ibex_var_;
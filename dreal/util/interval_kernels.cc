@@ -0,0 +1,206 @@
+#include "dreal/util/interval_kernels.h"
+
+#include <cfenv>
+#include <limits>
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+// This file is compiled with -frounding-math. Without it, the compiler
+// assumes the round-to-nearest mode and may fold or reorder the
+// operations across the changes of the rounding mode.
+
+namespace dreal {
+
+using std::numeric_limits;
+
+namespace {
+
+const double kNaN{numeric_limits<double>::quiet_NaN()};
+
+// Sets the rounding mode at construction and restores the previous one at
+// destruction.
+class RoundingMode {
+ public:
+  explicit RoundingMode(const int mode) : saved_{std::fegetround()} {
+    std::fesetround(mode);
+  }
+  RoundingMode(const RoundingMode&) = delete;
+  RoundingMode& operator=(const RoundingMode&) = delete;
+  ~RoundingMode() { std::fesetround(saved_); }
+
+  void set(const int mode) { std::fesetround(mode); }
+
+ private:
+  const int saved_;
+};
+
+// An empty interval is [NaN, NaN]. NaN is not equal to itself.
+inline bool IsEmpty(const double lb) { return lb != lb; }
+
+// Returns x * y, where 0 * ±∞ is 0.
+inline double Times(const double x, const double y) {
+  return (x == 0.0 || y == 0.0) ? 0.0 : x * y;
+}
+
+inline double Min(const double x, const double y) { return y < x ? y : x; }
+inline double Max(const double x, const double y) { return x < y ? y : x; }
+
+// Returns the bound of [a] * [b] selected by @p select (Min or Max).
+template <typename Select>
+inline double MulBound(const double a_lb, const double a_ub, const double b_lb,
+                       const double b_ub, Select select) {
+  if (IsEmpty(a_lb) || IsEmpty(b_lb)) {
+    return kNaN;
+  }
+  return select(select(Times(a_lb, b_lb), Times(a_lb, b_ub)),
+                select(Times(a_ub, b_lb), Times(a_ub, b_ub)));
+}
+
+#ifdef __AVX__
+// Returns x * y, where 0 * ±∞ is 0, on four lanes.
+inline __m256d Times(const __m256d x, const __m256d y) {
+  const __m256d zero{_mm256_setzero_pd()};
+  const __m256d has_zero{_mm256_or_pd(_mm256_cmp_pd(x, zero, _CMP_EQ_OQ),
+                                      _mm256_cmp_pd(y, zero, _CMP_EQ_OQ))};
+  return _mm256_andnot_pd(has_zero, _mm256_mul_pd(x, y));
+}
+
+// Returns @p v with NaN in the lanes where @p x or @p y is NaN.
+inline __m256d KeepEmpty(const __m256d v, const __m256d x, const __m256d y) {
+  return _mm256_blendv_pd(v, _mm256_set1_pd(kNaN),
+                          _mm256_cmp_pd(x, y, _CMP_UNORD_Q));
+}
+#endif
+
+}  // namespace
+
+void AddScaled(const int n, const double* const a_lb, const double* const a_ub,
+               const double* const b_lb, const double* const b_ub,
+               const double c, double* const lb, double* const ub) {
+  if (c == 0.0) {
+    // [b] * 0 is [0, 0] if [b] is not empty.
+    for (int k = 0; k < n; ++k) {
+      const bool empty{IsEmpty(a_lb[k]) || IsEmpty(b_lb[k])};
+      lb[k] = empty ? kNaN : a_lb[k];
+      ub[k] = empty ? kNaN : a_ub[k];
+    }
+    return;
+  }
+  // The bounds of [b] * c. NaN in an empty lane goes through the additions
+  // and the multiplications.
+  const double* const b_low{c > 0.0 ? b_lb : b_ub};
+  const double* const b_high{c > 0.0 ? b_ub : b_lb};
+  RoundingMode rounding{FE_DOWNWARD};
+  int k{0};
+#ifdef __AVX__
+  const __m256d vc{_mm256_set1_pd(c)};
+  for (; k + 4 <= n; k += 4) {
+    _mm256_storeu_pd(
+        lb + k, _mm256_add_pd(_mm256_loadu_pd(a_lb + k),
+                              _mm256_mul_pd(_mm256_loadu_pd(b_low + k), vc)));
+  }
+#endif
+  for (; k < n; ++k) {
+    lb[k] = a_lb[k] + b_low[k] * c;
+  }
+  rounding.set(FE_UPWARD);
+  k = 0;
+#ifdef __AVX__
+  for (; k + 4 <= n; k += 4) {
+    _mm256_storeu_pd(
+        ub + k, _mm256_add_pd(_mm256_loadu_pd(a_ub + k),
+                              _mm256_mul_pd(_mm256_loadu_pd(b_high + k), vc)));
+  }
+#endif
+  for (; k < n; ++k) {
+    ub[k] = a_ub[k] + b_high[k] * c;
+  }
+}
+
+void Mul(const int n, const double* const a_lb, const double* const a_ub,
+         const double* const b_lb, const double* const b_ub, double* const lb,
+         double* const ub) {
+  RoundingMode rounding{FE_DOWNWARD};
+  int k{0};
+#ifdef __AVX__
+  for (; k + 4 <= n; k += 4) {
+    const __m256d al{_mm256_loadu_pd(a_lb + k)};
+    const __m256d au{_mm256_loadu_pd(a_ub + k)};
+    const __m256d bl{_mm256_loadu_pd(b_lb + k)};
+    const __m256d bu{_mm256_loadu_pd(b_ub + k)};
+    const __m256d v{
+        _mm256_min_pd(_mm256_min_pd(Times(al, bl), Times(al, bu)),
+                      _mm256_min_pd(Times(au, bl), Times(au, bu)))};
+    _mm256_storeu_pd(lb + k, KeepEmpty(v, al, bl));
+  }
+#endif
+  for (; k < n; ++k) {
+    lb[k] = MulBound(a_lb[k], a_ub[k], b_lb[k], b_ub[k], Min);
+  }
+  rounding.set(FE_UPWARD);
+  k = 0;
+#ifdef __AVX__
+  for (; k + 4 <= n; k += 4) {
+    const __m256d al{_mm256_loadu_pd(a_lb + k)};
+    const __m256d au{_mm256_loadu_pd(a_ub + k)};
+    const __m256d bl{_mm256_loadu_pd(b_lb + k)};
+    const __m256d bu{_mm256_loadu_pd(b_ub + k)};
+    const __m256d v{
+        _mm256_max_pd(_mm256_max_pd(Times(al, bl), Times(al, bu)),
+                      _mm256_max_pd(Times(au, bl), Times(au, bu)))};
+    _mm256_storeu_pd(ub + k, KeepEmpty(v, al, bl));
+  }
+#endif
+  for (; k < n; ++k) {
+    ub[k] = MulBound(a_lb[k], a_ub[k], b_lb[k], b_ub[k], Max);
+  }
+}
+
+void Sqr(const int n, const double* const a_lb, const double* const a_ub,
+         double* const lb, double* const ub) {
+  RoundingMode rounding{FE_DOWNWARD};
+  int k{0};
+#ifdef __AVX__
+  const __m256d zero{_mm256_setzero_pd()};
+  for (; k + 4 <= n; k += 4) {
+    const __m256d al{_mm256_loadu_pd(a_lb + k)};
+    const __m256d au{_mm256_loadu_pd(a_ub + k)};
+    // 0 if the interval contains 0.
+    __m256d v{zero};
+    v = _mm256_blendv_pd(v, _mm256_mul_pd(au, au),
+                         _mm256_cmp_pd(au, zero, _CMP_LE_OQ));
+    v = _mm256_blendv_pd(v, _mm256_mul_pd(al, al),
+                         _mm256_cmp_pd(al, zero, _CMP_GE_OQ));
+    _mm256_storeu_pd(lb + k, KeepEmpty(v, al, al));
+  }
+#endif
+  for (; k < n; ++k) {
+    const double al{a_lb[k]};
+    const double au{a_ub[k]};
+    if (IsEmpty(al)) {
+      lb[k] = kNaN;
+    } else {
+      lb[k] = al >= 0.0 ? al * al : (au <= 0.0 ? au * au : 0.0);
+    }
+  }
+  rounding.set(FE_UPWARD);
+  k = 0;
+#ifdef __AVX__
+  for (; k + 4 <= n; k += 4) {
+    const __m256d al{_mm256_loadu_pd(a_lb + k)};
+    const __m256d au{_mm256_loadu_pd(a_ub + k)};
+    const __m256d v{
+        _mm256_max_pd(_mm256_mul_pd(al, al), _mm256_mul_pd(au, au))};
+    _mm256_storeu_pd(ub + k, KeepEmpty(v, al, al));
+  }
+#endif
+  for (; k < n; ++k) {
+    const double al{a_lb[k]};
+    const double au{a_ub[k]};
+    ub[k] = IsEmpty(al) ? kNaN : Max(al * al, au * au);
+  }
+}
+
+}  // namespace dreal
@@ -0,0 +1,32 @@
+#pragma once
+
+namespace dreal {
+
+/// @file interval_kernels.h
+///
+/// Interval operations over arrays in a structure-of-arrays layout. The
+/// k-th interval of an operand is [lb[k], ub[k]], and an empty interval is
+/// [NaN, NaN]. Each kernel computes @p n results and writes them to @p lb
+/// and @p ub, which must not overlap with the operands.
+///
+/// The lower bounds are computed in the round-downward mode and the upper
+/// bounds in the round-upward mode, so the results contain the exact ones
+/// as ibex::Interval does. The rounding mode is restored before a kernel
+/// returns. The loops are simple enough for the compiler to vectorize. If
+/// it is built with AVX (e.g. `--copt=-mavx`), they use AVX intrinsics on
+/// four lanes at a time.
+
+/// Computes [a] + [b] * c.
+void AddScaled(int n, const double* a_lb, const double* a_ub,
+               const double* b_lb, const double* b_ub, double c, double* lb,
+               double* ub);
+
+/// Computes [a] * [b]. As in ibex, 0 * ±∞ is 0.
+void Mul(int n, const double* a_lb, const double* a_ub, const double* b_lb,
+         const double* b_ub, double* lb, double* ub);
+
+/// Computes [a]².
+void Sqr(int n, const double* a_lb, const double* a_ub, double* lb,
+         double* ub);
+
+}  // namespace dreal
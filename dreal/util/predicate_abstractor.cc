@@ -14,8 +14,18 @@ using std::stringstream;
 using std::vector;
 
 void PredicateAbstractor::Add(const Variable& var, const Formula& f) {
-  var_to_formula_map_.emplace(var, f);
-  formula_to_var_map_.emplace(f, var);
+  var_to_formula_map_.insert(var, f);
+  formula_to_var_map_.insert(f, var);
+}
+
+void PredicateAbstractor::Push() {
+  var_to_formula_map_.push();
+  formula_to_var_map_.push();
+}
+
+void PredicateAbstractor::Pop() {
+  var_to_formula_map_.pop();
+  formula_to_var_map_.pop();
 }
 
 Formula PredicateAbstractor::Convert(const Formula& f) { return Visit(f); }
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "dreal/symbolic/symbolic.h"
+#include "dreal/util/scoped_unordered_map.h"
 
 namespace dreal {
 
@@ -24,17 +25,24 @@ class PredicateAbstractor {
 
   const std::unordered_map<Variable, Formula, hash_value<Variable>>&
   var_to_formula_map() const {
-    return var_to_formula_map_;
+    return var_to_formula_map_.get_map();
   }
 
   const Variable& operator[](const Formula& f) const {
-    return formula_to_var_map_.at(f);
+    return formula_to_var_map_.get_map().at(f);
   }
 
   const Formula& operator[](const Variable& var) const {
-    return var_to_formula_map_.at(var);
+    return var_to_formula_map_.get_map().at(var);
   }
 
+  /// Opens a scope. The abstractions made in the scope are removed by the
+  /// matching Pop().
+  void Push();
+
+  /// Removes the abstractions made since the last Push().
+  void Pop();
+
  private:
   Formula Visit(const Formula& f);
   Formula VisitFalse(const Formula& f);
@@ -54,9 +62,9 @@ class PredicateAbstractor {
 
   void Add(const Variable& var, const Formula& f);
 
-  std::unordered_map<Variable, Formula, hash_value<Variable>>
+  ScopedUnorderedMap<Variable, Formula, hash_value<Variable>>
       var_to_formula_map_;
-  std::unordered_map<Formula, Variable, hash_value<Formula>>
+  ScopedUnorderedMap<Formula, Variable, hash_value<Formula>>
       formula_to_var_map_;
 
   // Makes VisitFormula a friend of this class so that it can use private
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dreal/util/exception.h"
+
+namespace dreal {
+
+// Backtrackable scoped unordered map. It records the operations made in
+// a scope so that `pop()` can undo them.
+template <class Key, class T, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class ScopedUnorderedMap {
+ public:
+  typedef std::unordered_map<Key, T, Hash, KeyEqual> map;
+  typedef typename map::key_type key_type;
+  typedef typename map::mapped_type mapped_type;
+  typedef typename map::value_type value_type;
+  typedef typename map::size_type size_type;
+  typedef typename map::const_iterator const_iterator;
+
+  ScopedUnorderedMap() = default;
+  ~ScopedUnorderedMap() = default;
+
+  const_iterator begin() const { return map_.cbegin(); }
+  const_iterator end() const { return map_.cend(); }
+  const_iterator cbegin() const { return map_.cbegin(); }
+  const_iterator cend() const { return map_.cend(); }
+
+  // Inserts (k, v) or updates the value of k with v.
+  void insert(const Key& k, const T& v) {
+    const auto it = map_.find(k);
+    if (it == map_.end()) {
+      Record(ActionKind::INSERT, k, v);
+      map_.emplace(k, v);
+    } else {
+      Record(ActionKind::UPDATE, k, it->second);
+      it->second = v;
+    }
+  }
+
+  // Erases k if it is in the map.
+  void erase(const Key& k) {
+    const auto it = map_.find(k);
+    if (it != map_.end()) {
+      Record(ActionKind::ERASE, k, it->second);
+      map_.erase(it);
+    }
+  }
+
+  // Erases all the entries. They are restored by `pop()` if they were in
+  // the map before the last `push()`.
+  void clear() {
+    while (!map_.empty()) {
+      erase(map_.begin()->first);
+    }
+  }
+
+  void push() { scopes_.push_back(actions_.size()); }
+
+  // Undoes the operations made after the last `push()`. Returns the number
+  // of the undone operations.
+  size_t pop() {
+    if (scopes_.empty()) {
+      throw DREAL_RUNTIME_ERROR("Nothing to pop.");
+    }
+    const size_t prev_size{scopes_.back()};
+    scopes_.pop_back();
+    size_t count{0};
+    while (actions_.size() > prev_size) {
+      Action& action{actions_.back()};
+      const Key& k{std::get<1>(action)};
+      switch (std::get<0>(action)) {
+        case ActionKind::INSERT:
+          map_.erase(k);
+          break;
+        case ActionKind::UPDATE:
+          map_.find(k)->second = std::move(std::get<2>(action));
+          break;
+        case ActionKind::ERASE:
+          map_.emplace(k, std::move(std::get<2>(action)));
+          break;
+      }
+      actions_.pop_back();
+      count++;
+    }
+    return count;
+  }
+
+  bool empty() const { return map_.empty(); }
+  size_type size() const { return map_.size(); }
+  size_type count(const Key& k) const { return map_.count(k); }
+  const_iterator find(const Key& k) const { return map_.find(k); }
+  const T& operator[](const Key& k) const {
+    const auto it = map_.find(k);
+    if (it == map_.end()) {
+      throw DREAL_RUNTIME_ERROR("ScopedUnorderedMap has no entry for the key.");
+    }
+    return it->second;
+  }
+  map const& get_map() const { return map_; }
+
+ private:
+  enum class ActionKind {
+    INSERT,  // An entry (k, v) is inserted.
+    UPDATE,  // The value of k was v before it is updated.
+    ERASE,   // An entry (k, v) is erased.
+  };
+  typedef std::tuple<ActionKind, Key, T> Action;
+
+  // Records an action to undo. Nothing is recorded in the outermost scope
+  // as it cannot be popped.
+  void Record(const ActionKind kind, const Key& k, const T& v) {
+    if (!scopes_.empty()) {
+      actions_.emplace_back(kind, k, v);
+    }
+  }
+
+  map map_;
+  std::vector<Action> actions_;
+  std::vector<size_t> scopes_;
+};
+}  // namespace dreal
@@ -0,0 +1,64 @@
+#include "dreal/util/box_batch.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/symbolic/symbolic.h"
+
+namespace dreal {
+namespace {
+
+using std::vector;
+
+class BoxBatchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_.Add(x_, 0, 1);
+    box_.Add(y_, 2, 3);
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  Box box_;
+};
+
+TEST_F(BoxBatchTest, FromBoxes) {
+  Box box2{box_};
+  box2[y_] = Box::Interval{-1, 4};
+  Box box3{box_};
+  box3.set_empty();
+  const BoxBatch batch{vector<Box>{box_, box2, box3}};
+
+  EXPECT_EQ(batch.size(), 3);
+  EXPECT_EQ(batch.dimension(), 2);
+  EXPECT_EQ(batch.variables(), box_.variables());
+  EXPECT_EQ(batch.index(y_), 1);
+
+  // The lower bounds of y in the three boxes are contiguous.
+  EXPECT_EQ(batch.lb(1)[0], 2);
+  EXPECT_EQ(batch.lb(1)[1], -1);
+  EXPECT_EQ(batch.ub(1)[1], 4);
+
+  EXPECT_EQ(batch.interval(1, 1), Box::Interval(-1, 4));
+  EXPECT_TRUE(batch.interval(0, 2).is_empty());
+
+  EXPECT_EQ(batch.box(0), box_);
+  EXPECT_EQ(batch.box(1), box2);
+  EXPECT_TRUE(batch.box(2).empty());
+}
+
+TEST_F(BoxBatchTest, Halves) {
+  const vector<Box::Interval> halves{Box::Interval{0, 0.5},
+                                     Box::Interval{0.5, 1}};
+  const BoxBatch batch{box_, 0, halves};
+  ASSERT_EQ(batch.size(), 2);
+  EXPECT_EQ(batch.interval(0, 0), Box::Interval(0, 0.5));
+  EXPECT_EQ(batch.interval(0, 1), Box::Interval(0.5, 1));
+  // The other intervals are copied from the box.
+  EXPECT_EQ(batch.interval(1, 0), box_[y_]);
+  EXPECT_EQ(batch.interval(1, 1), box_[y_]);
+}
+
+}  // namespace
+}  // namespace dreal
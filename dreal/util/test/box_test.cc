@@ -106,6 +106,8 @@ TEST_F(BoxTest, Index) {
   EXPECT_EQ(b1.index(x_), 0);
   EXPECT_EQ(b1.index(y_), 1);
   EXPECT_EQ(b1.index(z_), 2);
+  EXPECT_TRUE(b1.has_variable(x_));
+  EXPECT_FALSE(b1.has_variable(w_));
 }
 
 TEST_F(BoxTest, MaxDiam) {
@@ -217,6 +219,20 @@ TEST_F(BoxTest, BisectBinary) {
   EXPECT_EQ(box2[i_], box[i_]);
 }
 
+TEST_F(BoxTest, BisectInterval) {
+  Box box;
+  box.Add(x_, -10, 10);
+  box.Add(i_, -5, 5);
+
+  for (const int idx : {box.index(x_), box.index(i_)}) {
+    const pair<Box, Box> boxes{box.bisect(idx)};
+    const pair<Box::Interval, Box::Interval> intervals{
+        box.bisect_interval(idx)};
+    EXPECT_EQ(intervals.first, boxes.first[idx]);
+    EXPECT_EQ(intervals.second, boxes.second[idx]);
+  }
+}
+
 TEST_F(BoxTest, NotBisectable) {
   Box box;
   // x = [10, 10 + ε]
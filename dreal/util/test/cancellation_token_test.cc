@@ -0,0 +1,74 @@
+#include "dreal/util/cancellation_token.h"
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::chrono::hours;
+using std::chrono::seconds;
+using std::thread;
+
+GTEST_TEST(CancellationToken, Cancel) {
+  const CancellationToken token;
+  EXPECT_FALSE(token.is_cancelled());
+  token.Cancel();
+  EXPECT_TRUE(token.is_cancelled());
+  // Cancelling twice is OK.
+  token.Cancel();
+  EXPECT_TRUE(token.is_cancelled());
+}
+
+GTEST_TEST(CancellationToken, CopySharesState) {
+  const CancellationToken token1;
+  const CancellationToken token2{token1};
+  const CancellationToken token3;
+  token2.Cancel();
+  EXPECT_TRUE(token1.is_cancelled());
+  EXPECT_TRUE(token2.is_cancelled());
+  EXPECT_FALSE(token3.is_cancelled());
+}
+
+GTEST_TEST(CancellationToken, Child) {
+  const CancellationToken parent;
+  const CancellationToken child1{parent.MakeChild()};
+  const CancellationToken child2{parent.MakeChild()};
+  const CancellationToken grandchild{child1.MakeChild()};
+
+  // Cancelling a child does not affect its parent and siblings.
+  child2.Cancel();
+  EXPECT_FALSE(parent.is_cancelled());
+  EXPECT_FALSE(child1.is_cancelled());
+  EXPECT_TRUE(child2.is_cancelled());
+  EXPECT_FALSE(grandchild.is_cancelled());
+
+  // Cancelling a parent cancels all of its descendants.
+  parent.Cancel();
+  EXPECT_TRUE(child1.is_cancelled());
+  EXPECT_TRUE(grandchild.is_cancelled());
+}
+
+GTEST_TEST(CancellationToken, Deadline) {
+  const CancellationToken parent;
+  const CancellationToken child{parent.MakeChild()};
+  parent.set_deadline(CancellationToken::Clock::now() + hours{1});
+  EXPECT_FALSE(parent.is_cancelled());
+  EXPECT_FALSE(child.is_cancelled());
+
+  parent.set_deadline(CancellationToken::Clock::now() - seconds{1});
+  EXPECT_TRUE(parent.is_cancelled());
+  EXPECT_TRUE(child.is_cancelled());
+}
+
+GTEST_TEST(CancellationToken, CancelFromAnotherThread) {
+  const CancellationToken token;
+  thread t{[token]() { token.Cancel(); }};
+  t.join();
+  EXPECT_TRUE(token.is_cancelled());
+}
+
+}  // namespace
+}  // namespace dreal
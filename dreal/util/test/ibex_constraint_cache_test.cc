@@ -0,0 +1,145 @@
+#include "dreal/util/ibex_constraint_cache.h"
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::shared_ptr;
+
+class IbexConstraintCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_.Add(x_, -10, 10);
+    box_.Add(y_, -10, 10);
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  Box box_;
+};
+
+TEST_F(IbexConstraintCacheTest, HitAndMiss) {
+  IbexConstraintCache cache{10};
+  const Formula f{x_ * x_ + y_ * y_ <= 1.0};
+  const shared_ptr<const CompiledIbexConstraint> c1{cache.Get(f, box_)};
+  ASSERT_TRUE(c1->num_ctr);
+  EXPECT_EQ(cache.num_misses(), 1);
+  EXPECT_EQ(cache.num_hits(), 0);
+
+  // The domains do not matter unless they are points.
+  Box box{box_};
+  box[x_] = Box::Interval(0, 1);
+  const shared_ptr<const CompiledIbexConstraint> c2{cache.Get(f, box)};
+  EXPECT_EQ(c1, c2);
+  EXPECT_EQ(cache.num_hits(), 1);
+
+  // A point domain is substituted into the formula.
+  box[x_] = Box::Interval(0.5);
+  const shared_ptr<const CompiledIbexConstraint> c3{cache.Get(f, box)};
+  EXPECT_NE(c1, c3);
+  EXPECT_EQ(cache.num_misses(), 2);
+
+  // A box with a different set of variables.
+  Box box2;
+  box2.Add(y_, -10, 10);
+  box2.Add(x_, -10, 10);
+  const shared_ptr<const CompiledIbexConstraint> c4{cache.Get(f, box2)};
+  EXPECT_NE(c1, c4);
+  EXPECT_EQ(cache.num_misses(), 3);
+  EXPECT_EQ(cache.size(), 3);
+}
+
+TEST_F(IbexConstraintCacheTest, Projected) {
+  IbexConstraintCache cache{10};
+  const Variable z{"z"};
+  const Formula f{x_ * x_ <= 1.0};
+  Box box{box_};
+  box.Add(z, -10, 10);
+  const shared_ptr<const CompiledIbexConstraint> c1{
+      cache.Get(f, {x_}, box)};
+  ASSERT_TRUE(c1->num_ctr);
+  EXPECT_EQ(c1->num_ctr->f.nb_var(), 1);
+
+  // The other variables in a box do not matter.
+  const shared_ptr<const CompiledIbexConstraint> c2{
+      cache.Get(f, {x_}, box_)};
+  EXPECT_EQ(c1, c2);
+  EXPECT_EQ(cache.num_hits(), 1);
+  EXPECT_EQ(cache.num_misses(), 1);
+}
+
+TEST_F(IbexConstraintCacheTest, Shared) {
+  IbexConstraintCache cache{10};
+  const Formula f1{x_ * x_ + y_ * y_ <= 1.0};
+  const Formula f2{x_ * x_ + y_ * y_ >= 0.5};
+  const shared_ptr<const CompiledIbexConstraint> c1{
+      cache.GetShared({f1, f2}, {x_, y_})};
+  ASSERT_TRUE(c1->function);
+  EXPECT_FALSE(c1->num_ctr);
+  EXPECT_EQ(c1->function->image_dim(), 2);
+  EXPECT_EQ(cache.GetShared({f2, f1}, {x_, y_}), c1);
+  EXPECT_EQ(cache.num_hits(), 1);
+
+  // A shared function of a single formula is not its constraint.
+  const shared_ptr<const CompiledIbexConstraint> c2{
+      cache.GetShared({f1}, {x_, y_})};
+  const shared_ptr<const CompiledIbexConstraint> c3{
+      cache.Get(f1, {x_, y_}, box_)};
+  EXPECT_NE(c2, c3);
+  EXPECT_TRUE(c2->function);
+  EXPECT_TRUE(c3->num_ctr);
+  EXPECT_EQ(cache.num_misses(), 3);
+}
+
+TEST_F(IbexConstraintCacheTest, Eviction) {
+  IbexConstraintCache cache{2};
+  const Formula f1{x_ >= y_};
+  const Formula f2{x_ <= y_};
+  const Formula f3{x_ == y_};
+  const shared_ptr<const CompiledIbexConstraint> c1{cache.Get(f1, box_)};
+  cache.Get(f2, box_);
+  // f1 is used more recently than f2.
+  cache.Get(f1, box_);
+  // f2 is evicted.
+  cache.Get(f3, box_);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.Get(f1, box_), c1);
+  EXPECT_EQ(cache.num_hits(), 2);
+  cache.Get(f2, box_);
+  EXPECT_EQ(cache.num_misses(), 4);
+
+  // An evicted entry is still owned by its users.
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_TRUE(c1->num_ctr);
+}
+
+TEST_F(IbexConstraintCacheTest, EvictionByMemoryUsage) {
+  const Formula f1{x_ >= y_};
+  const Formula f2{sin(x_) * cos(y_) + exp(x_ * y_) <= 1.0};
+  IbexConstraintCache unbounded{10};
+  unbounded.Get(f1, box_);
+  const size_t size1{unbounded.memory_usage()};
+  unbounded.Get(f2, box_);
+  const size_t size2{unbounded.memory_usage() - size1};
+  // A larger expression takes more memory.
+  EXPECT_GT(size2, size1);
+
+  // f1 and f2 do not fit together.
+  IbexConstraintCache cache{10, size1 + size2 - 1};
+  cache.Get(f1, box_);
+  cache.Get(f2, box_);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.memory_usage(), size2);
+  cache.Get(f2, box_);
+  EXPECT_EQ(cache.num_hits(), 1);
+
+  cache.Clear();
+  EXPECT_EQ(cache.memory_usage(), 0u);
+}
+
+}  // namespace
+}  // namespace dreal
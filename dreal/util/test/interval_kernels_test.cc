@@ -0,0 +1,119 @@
+#include "dreal/util/interval_kernels.h"
+
+#include <cfenv>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/util/box.h"
+
+namespace dreal {
+namespace {
+
+using std::numeric_limits;
+using std::vector;
+
+class IntervalKernelsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const double inf{numeric_limits<double>::infinity()};
+    const vector<Box::Interval> intervals{
+        Box::Interval{0.1, 0.3}, Box::Interval{-2, -0.7},
+        Box::Interval{-1.5, 3},  Box::Interval{0, 0},
+        Box::Interval{-inf, 2},  Box::Interval{0, inf},
+        Box::Interval::ALL_REALS, Box::Interval::EMPTY_SET};
+    // All the pairs of the intervals.
+    for (const Box::Interval& a : intervals) {
+      for (const Box::Interval& b : intervals) {
+        a_.push_back(a);
+        b_.push_back(b);
+      }
+    }
+    n_ = a_.size();
+    Split(a_, &a_lb_, &a_ub_);
+    Split(b_, &b_lb_, &b_ub_);
+    lb_.resize(n_);
+    ub_.resize(n_);
+  }
+
+  // Stores the bounds of @p intervals into @p lb and @p ub.
+  static void Split(const vector<Box::Interval>& intervals,
+                    vector<double>* const lb, vector<double>* const ub) {
+    for (const Box::Interval& iv : intervals) {
+      lb->push_back(iv.is_empty() ? numeric_limits<double>::quiet_NaN()
+                                  : iv.lb());
+      ub->push_back(iv.is_empty() ? numeric_limits<double>::quiet_NaN()
+                                  : iv.ub());
+    }
+  }
+
+  // Checks that the k-th result is @p expected.
+  void Check(const int k, const Box::Interval& expected) const {
+    if (expected.is_empty()) {
+      EXPECT_NE(lb_[k], lb_[k]) << a_[k] << " " << b_[k];  // NaN.
+      EXPECT_NE(ub_[k], ub_[k]) << a_[k] << " " << b_[k];
+    } else {
+      EXPECT_DOUBLE_EQ(lb_[k], expected.lb()) << a_[k] << " " << b_[k];
+      EXPECT_DOUBLE_EQ(ub_[k], expected.ub()) << a_[k] << " " << b_[k];
+    }
+  }
+
+  vector<Box::Interval> a_;
+  vector<Box::Interval> b_;
+  int n_{0};
+  vector<double> a_lb_;
+  vector<double> a_ub_;
+  vector<double> b_lb_;
+  vector<double> b_ub_;
+  vector<double> lb_;
+  vector<double> ub_;
+};
+
+TEST_F(IntervalKernelsTest, AddScaled) {
+  for (const double c : {2.5, -0.1, 0.0}) {
+    AddScaled(n_, a_lb_.data(), a_ub_.data(), b_lb_.data(), b_ub_.data(), c,
+              lb_.data(), ub_.data());
+    for (int k = 0; k < n_; ++k) {
+      Check(k, a_[k] + b_[k] * c);
+    }
+  }
+}
+
+TEST_F(IntervalKernelsTest, Mul) {
+  Mul(n_, a_lb_.data(), a_ub_.data(), b_lb_.data(), b_ub_.data(), lb_.data(),
+      ub_.data());
+  for (int k = 0; k < n_; ++k) {
+    Check(k, a_[k] * b_[k]);
+  }
+}
+
+TEST_F(IntervalKernelsTest, Sqr) {
+  Sqr(n_, a_lb_.data(), a_ub_.data(), lb_.data(), ub_.data());
+  for (int k = 0; k < n_; ++k) {
+    Check(k, sqr(a_[k]));
+  }
+}
+
+TEST_F(IntervalKernelsTest, DirectedRounding) {
+  // 0.1 * 0.1 and 0.1 + 0.2 are not representable. The results are not
+  // points and contain the exact values.
+  const double a{0.1};
+  const double b{0.2};
+  double lb{0.0};
+  double ub{0.0};
+  const int mode{std::fegetround()};
+  Mul(1, &a, &a, &a, &a, &lb, &ub);
+  EXPECT_LT(lb, ub);
+  EXPECT_TRUE(
+      (Box::Interval{a} * Box::Interval{a}).is_subset(Box::Interval{lb, ub}));
+  AddScaled(1, &a, &a, &b, &b, 1.0, &lb, &ub);
+  EXPECT_LT(lb, ub);
+  EXPECT_TRUE(
+      (Box::Interval{a} + Box::Interval{b}).is_subset(Box::Interval{lb, ub}));
+  // The rounding mode is restored.
+  EXPECT_EQ(std::fegetround(), mode);
+}
+
+}  // namespace
+}  // namespace dreal
@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <set>
+#include <stdexcept>
 
 #include <gtest/gtest.h>
 
@@ -213,5 +214,23 @@ TEST_F(PredicateAbstractorTest, Forall) {
   EXPECT_PRED2(VarEqual, abstractor_[f], var);
 }
 
+TEST_F(PredicateAbstractorTest, PushPop) {
+  const Formula f1{x_ > 0};
+  const Formula f2{y_ < 0};
+  const Formula abstracted1{abstractor_.Convert(f1)};
+  abstractor_.Push();
+  const Formula abstracted2{abstractor_.Convert(f1 && f2)};
+  EXPECT_EQ(abstractor_.var_to_formula_map().size(), 2u);
+  // f1 is abstracted by the same variable in the scope.
+  EXPECT_PRED2(FormulaEqual, abstracted2,
+               abstracted1 && Formula{abstractor_[f2]});
+  abstractor_.Pop();
+
+  // The abstraction of f2 is removed while the one of f1 is kept.
+  EXPECT_EQ(abstractor_.var_to_formula_map().size(), 1u);
+  EXPECT_PRED2(FormulaEqual, abstractor_.Convert(f1), abstracted1);
+  EXPECT_THROW(abstractor_[f2], std::out_of_range);
+}
+
 }  // namespace
 }  // namespace dreal
@@ -0,0 +1,71 @@
+#include "dreal/util/scoped_unordered_map.h"
+
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::runtime_error;
+using std::string;
+
+GTEST_TEST(ScopedUnorderedMap, InsertAndFind) {
+  ScopedUnorderedMap<string, int> map;
+  map.insert("a", 1);
+  map.insert("b", 2);
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map["a"], 1);
+  EXPECT_EQ(map["b"], 2);
+  EXPECT_EQ(map.count("c"), 0u);
+  EXPECT_TRUE(map.find("c") == map.end());
+  EXPECT_THROW(map["c"], runtime_error);
+
+  // Update.
+  map.insert("a", 3);
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map["a"], 3);
+}
+
+GTEST_TEST(ScopedUnorderedMap, PushPop) {
+  ScopedUnorderedMap<string, int> map;
+  map.insert("a", 1);
+  map.insert("b", 2);
+
+  // First push.
+  map.push();
+  map.insert("c", 3);
+  map.insert("a", 4);
+  map.erase("b");
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map["a"], 4);
+  EXPECT_EQ(map["c"], 3);
+  EXPECT_EQ(map.count("b"), 0u);
+
+  // Second push.
+  map.push();
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  map.insert("d", 5);
+
+  // Pop the second push.
+  EXPECT_EQ(map.pop(), 3u);  // Erase "a", erase "c", and insert "d".
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map["a"], 4);
+  EXPECT_EQ(map["c"], 3);
+  EXPECT_EQ(map.count("d"), 0u);
+
+  // Pop the first push.
+  EXPECT_EQ(map.pop(), 3u);
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map["a"], 1);
+  EXPECT_EQ(map["b"], 2);
+  EXPECT_EQ(map.count("c"), 0u);
+
+  // Nothing to pop.
+  EXPECT_THROW(map.pop(), runtime_error);
+}
+
+}  // namespace
+}  // namespace dreal